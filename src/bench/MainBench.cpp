@@ -0,0 +1,51 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <cstring>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Util */
+#include "Logger.h"
+
+using namespace keyple::core::util::cpp;
+
+int main(int argc, char **argv)
+{
+    Logger::setLoggerLevel(Logger::Level::logError);
+
+    /* Results are emitted as JSON unless another format is requested */
+    static char jsonFormat[] = "--benchmark_format=json";
+
+    std::vector<char*> args(argv, argv + argc);
+    bool hasFormat = false;
+    for (int i = 1; i < argc; i++) {
+        hasFormat |= std::strncmp(argv[i], "--benchmark_format", 18) == 0;
+    }
+
+    if (!hasFormat) {
+        args.push_back(jsonFormat);
+    }
+
+    int argCount = static_cast<int>(args.size());
+    benchmark::Initialize(&argCount, args.data());
+    if (benchmark::ReportUnrecognizedArguments(argCount, args.data())) {
+        return 1;
+    }
+
+    /* Run */
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
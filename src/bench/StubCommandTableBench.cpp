@@ -0,0 +1,105 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin Stub */
+#include "StubCommandTable.h"
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+#include "Pattern.h"
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp;
+using namespace keyple::plugin::stub;
+
+/*
+ * Lookups spread over many card definitions, so that each one misses the caches, as with a large
+ * fleet of cards. The map is the layout of the commands before the tables (one node and two
+ * strings per command), looked up as it was: the APDU is converted to hexadecimal, each command
+ * is compiled as a regular expression and matched in turn, and the response is decoded. Run with
+ * --benchmark_perf_counters=CACHE-MISSES to count the misses per lookup, available when libpfm was
+ * found when configuring the build.
+ */
+static const int CARD_COUNT = 16384;
+
+/* Commands 00B2XX0400, the last one is the slowest to find in a map */
+static std::map<std::string, std::string> buildHexCommands(const int tableSize, const int card)
+{
+    std::map<std::string, std::string> hexCommands;
+    for (int i = 0; i < tableSize; i++) {
+        hexCommands.insert({"00B2" + HexUtil::toHex(static_cast<uint8_t>(i)) + "0400",
+                            HexUtil::toHex(static_cast<uint8_t>(card)) + "9000"});
+    }
+
+    return hexCommands;
+}
+
+static std::vector<uint8_t> lastCommand(const int tableSize)
+{
+    return {0x00, 0xB2, static_cast<uint8_t>(tableSize - 1), 0x04, 0x00};
+}
+
+static void BM_commandLookup_map(benchmark::State& state)
+{
+    const int tableSize = static_cast<int>(state.range(0));
+    std::vector<std::unique_ptr<const std::map<std::string, std::string>>> maps;
+    for (int i = 0; i < CARD_COUNT; i++) {
+        maps.emplace_back(new std::map<std::string, std::string>(buildHexCommands(tableSize, i)));
+    }
+
+    const std::vector<uint8_t> apdu = lastCommand(tableSize);
+
+    int card = 0;
+    for (auto _ : state) {
+        const std::string hexApdu = HexUtil::toHex(apdu);
+        for (const auto& hexCommand : *maps[card]) {
+            std::unique_ptr<Pattern> p = Pattern::compile(hexCommand.first);
+            if (p->matcher(hexApdu)->matches()) {
+                benchmark::DoNotOptimize(HexUtil::toByteArray(hexCommand.second));
+                break;
+            }
+        }
+        card = (card + 7919) % CARD_COUNT;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_commandLookup_map)->RangeMultiplier(4)->Range(4, 64);
+
+static void BM_commandLookup_table(benchmark::State& state)
+{
+    const int tableSize = static_cast<int>(state.range(0));
+    std::vector<std::unique_ptr<const StubCommandTable>> tables;
+    for (int i = 0; i < CARD_COUNT; i++) {
+        tables.emplace_back(new StubCommandTable(buildHexCommands(tableSize, i)));
+    }
+
+    const StubApdu apdu(lastCommand(tableSize));
+    StubApdu response;
+    std::size_t entry;
+
+    int card = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tables[card]->processApdu(apdu, response, entry));
+        card = (card + 7919) % CARD_COUNT;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_commandLookup_table)->RangeMultiplier(4)->Range(4, 64);
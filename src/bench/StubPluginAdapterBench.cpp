@@ -0,0 +1,78 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin Stub */
+#include "StubPluginAdapter.h"
+#include "StubPluginFactoryAdapter.h"
+#include "StubSmartCard.h"
+
+using namespace keyple::plugin::stub;
+
+static std::vector<std::shared_ptr<StubReaderConfiguration>> buildReaderConfigurations(
+    const int readerCount)
+{
+    const std::shared_ptr<StubSmartCard> card =
+        StubSmartCard::builder()->withPowerOnData({0x3B, 0x00})
+                                 .withProtocol("ISO_14443_4")
+                                 .withSimulatedCommand("00A4040005", "6F009000")
+                                 .build();
+
+    std::vector<std::shared_ptr<StubReaderConfiguration>> readerConfigurations;
+    for (int i = 0; i < readerCount; i++) {
+        readerConfigurations.push_back(
+            std::make_shared<StubReaderConfiguration>("reader" + std::to_string(i),
+                                                      i % 2 == 0,
+                                                      card->copy()));
+    }
+
+    return readerConfigurations;
+}
+
+/* Creation of a plugin with its configured readers, then first listing of the readers */
+static void BM_pluginStartup(benchmark::State& state)
+{
+    const auto readerConfigurations =
+        std::make_shared<const std::vector<std::shared_ptr<StubReaderConfiguration>>>(
+            buildReaderConfigurations(static_cast<int>(state.range(0))));
+    const bool lazyReaderCreation = state.range(1) != 0;
+
+    for (auto _ : state) {
+        StubPluginAdapter plugin("plugin", readerConfigurations, 0, lazyReaderCreation);
+        benchmark::DoNotOptimize(plugin.searchAvailableReaderNames());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_pluginStartup)->ArgsProduct({{16, 1024, 65536}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+/* Plug then unplug of one reader next to readerCount plugged readers */
+static void BM_plugReader(benchmark::State& state)
+{
+    StubPluginAdapter plugin("plugin",
+                             buildReaderConfigurations(static_cast<int>(state.range(0))),
+                             0);
+
+    for (auto _ : state) {
+        plugin.plugReader("extra", false, nullptr);
+        plugin.unplugReader("extra");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_plugReader)->RangeMultiplier(16)->Range(16, 65536);
@@ -0,0 +1,96 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin Stub */
+#include "StubPoolPluginAdapter.h"
+#include "StubPoolPluginFactoryAdapter.h"
+#include "StubSmartCard.h"
+
+using namespace keyple::plugin::stub;
+
+static const std::string GROUP = "group";
+
+/* Pool shared by the threads of a benchmark, set up and torn down by the first thread */
+static std::shared_ptr<StubPoolPluginAdapter> pool;
+
+static void BM_allocateReleaseReader(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        const std::shared_ptr<StubSmartCard> card =
+            StubSmartCard::builder()->withPowerOnData({0x3B, 0x00})
+                                     .withProtocol("ISO_14443_4")
+                                     .withSimulatedCommand("00A4040005", "6F009000")
+                                     .build();
+
+        std::vector<std::shared_ptr<StubPoolReaderConfiguration>> readerConfigurations;
+        for (int64_t i = 0; i < state.range(0); i++) {
+            readerConfigurations.push_back(std::make_shared<StubPoolReaderConfiguration>(
+                                               GROUP, "reader" + std::to_string(i), card->copy()));
+        }
+
+        pool = std::make_shared<StubPoolPluginAdapter>(
+                   "pool",
+                   readerConfigurations,
+                   0,
+                   std::vector<std::shared_ptr<StubElasticGroupConfiguration>>(),
+                   static_cast<std::size_t>(state.range(1)));
+    }
+
+    for (auto _ : state) {
+        pool->releaseReader(pool->allocateReader(GROUP));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        pool->onUnregister();
+        pool.reset();
+    }
+}
+BENCHMARK(BM_allocateReleaseReader)->ArgsProduct({{64, 4096}, {1, 8}})
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+static void BM_allocateReleaseReaders(benchmark::State& state)
+{
+    const std::size_t batchSize = static_cast<std::size_t>(state.range(1));
+
+    if (state.thread_index() == 0) {
+        std::vector<std::shared_ptr<StubPoolReaderConfiguration>> readerConfigurations;
+        for (int64_t i = 0; i < state.range(0); i++) {
+            readerConfigurations.push_back(std::make_shared<StubPoolReaderConfiguration>(
+                                               GROUP, "reader" + std::to_string(i), nullptr));
+        }
+
+        pool = std::make_shared<StubPoolPluginAdapter>("pool", readerConfigurations, 0);
+    }
+
+    for (auto _ : state) {
+        pool->releaseReaders(pool->allocateReaders(GROUP, batchSize));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+
+    if (state.thread_index() == 0) {
+        pool->onUnregister();
+        pool.reset();
+    }
+}
+BENCHMARK(BM_allocateReleaseReaders)->ArgsProduct({{4096}, {16, 256}})
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
@@ -0,0 +1,127 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin Stub */
+#include "StubPluginAdapter.h"
+#include "StubReaderAdapter.h"
+#include "StubSmartCard.h"
+
+using namespace keyple::plugin::stub;
+
+static const std::string PROTOCOL = "ISO_14443_4";
+
+static std::shared_ptr<StubSmartCard> buildCard()
+{
+    return StubSmartCard::builder()->withPowerOnData({0x3B, 0x00})
+                                    .withProtocol(PROTOCOL)
+                                    .withSimulatedCommand("00A4040005", "6F009000")
+                                    .withSimulatedCommand("00B2.*", "0102039000")
+                                    .build();
+}
+
+/* Readers shared by the threads of a benchmark, set up and torn down by the first thread */
+static std::shared_ptr<StubPluginAdapter> plugin;
+static std::vector<std::shared_ptr<StubReaderAdapter>> readers;
+
+static void plugReaders(const int readerCount, const bool withCards)
+{
+    const std::shared_ptr<StubSmartCard> card = buildCard();
+
+    std::vector<std::string> names;
+    std::vector<std::shared_ptr<StubSmartCard>> cards;
+    for (int i = 0; i < readerCount; i++) {
+        names.push_back("reader" + std::to_string(i));
+        cards.push_back(withCards ? card->copy() : nullptr);
+    }
+
+    plugin = std::make_shared<StubPluginAdapter>(
+                 "plugin", std::vector<std::shared_ptr<StubReaderConfiguration>>(), 0);
+    plugin->plugReaders(names, true, cards);
+
+    readers.clear();
+    for (const auto& name : names) {
+        readers.push_back(std::dynamic_pointer_cast<StubReaderAdapter>(plugin->searchReader(name)));
+    }
+}
+
+static void unplugReaders()
+{
+    readers.clear();
+    plugin.reset();
+}
+
+static void BM_transmitApdu(benchmark::State& state)
+{
+    const int readerCount = static_cast<int>(state.range(0));
+    if (state.thread_index() == 0) {
+        plugReaders(readerCount, true);
+    }
+
+    const std::vector<uint8_t> apdu = {0x00, 0xB2, 0x01, 0x04, 0x00};
+
+    /* Each thread goes through its own readers */
+    std::size_t index = static_cast<std::size_t>(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(readers[index]->transmitApdu(apdu));
+        index += static_cast<std::size_t>(state.threads());
+        if (index >= readers.size()) {
+            index = static_cast<std::size_t>(state.thread_index());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        unplugReaders();
+    }
+}
+BENCHMARK(BM_transmitApdu)->RangeMultiplier(16)->Range(16, 4096)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+static void BM_insertRemoveCard(benchmark::State& state)
+{
+    const int readerCount = static_cast<int>(state.range(0));
+    if (state.thread_index() == 0) {
+        plugReaders(readerCount, false);
+        for (const auto& reader : readers) {
+            reader->activateProtocol(PROTOCOL);
+        }
+    }
+
+    const std::shared_ptr<StubSmartCard> card = buildCard();
+
+    std::size_t index = static_cast<std::size_t>(state.thread_index());
+    for (auto _ : state) {
+        readers[index]->insertCard(card);
+        readers[index]->removeCard();
+        index += static_cast<std::size_t>(state.threads());
+        if (index >= readers.size()) {
+            index = static_cast<std::size_t>(state.thread_index());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        unplugReaders();
+    }
+}
+BENCHMARK(BM_insertRemoveCard)->RangeMultiplier(16)->Range(16, 4096)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
@@ -0,0 +1,73 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin Stub */
+#include "StubReaderAdapter.h"
+#include "StubReaderRegistry.h"
+
+using namespace keyple::plugin::stub;
+
+/* Registry shared by the threads of a benchmark, set up and torn down by the first thread */
+static std::shared_ptr<StubReaderRegistry> registry;
+
+/* 99 lookups of plugged readers for 1 plug then unplug of a reader of the thread */
+static void BM_registryLookupPlugMix(benchmark::State& state)
+{
+    const std::size_t readerCount = static_cast<std::size_t>(state.range(0));
+
+    if (state.thread_index() == 0) {
+        registry = std::make_shared<StubReaderRegistry>();
+        for (std::size_t i = 0; i < readerCount; i++) {
+            registry->insert(std::make_shared<StubReaderAdapter>("reader" + std::to_string(i),
+                                                                 false,
+                                                                 nullptr));
+        }
+    }
+
+    const std::string extraName = "extra" + std::to_string(state.thread_index());
+    const auto extra = std::make_shared<StubReaderAdapter>(extraName, false, nullptr);
+
+    std::vector<std::string> readerNames;
+    for (std::size_t i = 0; i < readerCount; i++) {
+        readerNames.push_back("reader" + std::to_string(i));
+    }
+
+    std::size_t index = static_cast<std::size_t>(state.thread_index());
+    int operation = 0;
+    for (auto _ : state) {
+        if (++operation == 100) {
+            operation = 0;
+            registry->insert(extra);
+            benchmark::DoNotOptimize(registry->erase(extraName));
+        } else {
+            benchmark::DoNotOptimize(registry->find(readerNames[index]));
+            if (++index == readerCount) {
+                index = 0;
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        registry.reset();
+    }
+}
+BENCHMARK(BM_registryLookupPlugMix)->RangeMultiplier(16)->Range(16, 65536)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
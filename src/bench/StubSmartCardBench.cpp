@@ -0,0 +1,153 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin Stub */
+#include "ApduResponseProviderSpi.h"
+#include "StubSmartCard.h"
+
+/* Keyple Core Plugin */
+#include "CardIOException.h"
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::util;
+using namespace keyple::plugin::stub;
+using namespace keyple::plugin::stub::spi;
+
+class ApduResponseProviderBench : public ApduResponseProviderSpi {
+public:
+    const std::string getResponseFromRequest(const std::string& apduRequest) override
+    {
+        (void)apduRequest;
+
+        return "9000";
+    }
+};
+
+/* Commands 00B2XXXX00, from 00B2000000 to the table size; the last one is the slowest to find */
+static std::shared_ptr<StubSmartCard> buildCard(const int tableSize, const bool isRegex)
+{
+    const auto builder = StubSmartCard::builder();
+    StubSmartCard::CommandStep& commandStep = builder->withPowerOnData({0x3B, 0x00})
+                                                     .withProtocol("ISO_14443_4");
+
+    StubSmartCard::SimulatedCommandStep* simulatedCommandStep = nullptr;
+    for (int i = 0; i < tableSize; i++) {
+        const std::string index = HexUtil::toHex({static_cast<uint8_t>(i >> 8),
+                                                  static_cast<uint8_t>(i & 0xFF)});
+        const std::string command = "00B2" + index + (isRegex ? ".*" : "00");
+        simulatedCommandStep =
+            simulatedCommandStep == nullptr
+                ? &commandStep.withSimulatedCommand(command, "9000")
+                : &simulatedCommandStep->withSimulatedCommand(command, "9000");
+    }
+
+    return simulatedCommandStep->build();
+}
+
+static std::vector<uint8_t> lastCommand(const int tableSize)
+{
+    return {0x00,
+            0xB2,
+            static_cast<uint8_t>((tableSize - 1) >> 8),
+            static_cast<uint8_t>((tableSize - 1) & 0xFF),
+            0x00};
+}
+
+static void BM_processApdu_literal(benchmark::State& state)
+{
+    const int tableSize = static_cast<int>(state.range(0));
+    const std::shared_ptr<StubSmartCard> card = buildCard(tableSize, false);
+    const std::vector<uint8_t> apdu = lastCommand(tableSize);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(card->processApdu(apdu));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_processApdu_literal)->RangeMultiplier(4)->Range(4, 1024);
+
+/* Same lookup through the small buffer overload, which allocates nothing */
+static void BM_processApdu_literal_buffer(benchmark::State& state)
+{
+    const int tableSize = static_cast<int>(state.range(0));
+    const std::shared_ptr<StubSmartCard> card = buildCard(tableSize, false);
+    const StubApdu apdu(lastCommand(tableSize));
+    StubApdu response;
+
+    for (auto _ : state) {
+        card->processApdu(apdu, response);
+        benchmark::DoNotOptimize(response.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_processApdu_literal_buffer)->RangeMultiplier(4)->Range(4, 1024);
+
+static void BM_processApdu_regex(benchmark::State& state)
+{
+    const int tableSize = static_cast<int>(state.range(0));
+    const std::shared_ptr<StubSmartCard> card = buildCard(tableSize, true);
+    const std::vector<uint8_t> apdu = lastCommand(tableSize);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(card->processApdu(apdu));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_processApdu_regex)->RangeMultiplier(4)->Range(4, 1024);
+
+static void BM_processApdu_provider(benchmark::State& state)
+{
+    const std::shared_ptr<StubSmartCard> card =
+        StubSmartCard::builder()->withPowerOnData({0x3B, 0x00})
+                                 .withProtocol("ISO_14443_4")
+                                 .withApduResponseProvider(
+                                     std::make_shared<ApduResponseProviderBench>())
+                                 .build();
+    const std::vector<uint8_t> apdu = lastCommand(1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(card->processApdu(apdu));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_processApdu_provider);
+
+static void BM_processApdu_miss(benchmark::State& state)
+{
+    const int tableSize = static_cast<int>(state.range(0));
+    const std::shared_ptr<StubSmartCard> card = buildCard(tableSize, false);
+    const std::vector<uint8_t> apdu = {0x00, 0xA4, 0x04, 0x00, 0x00};
+
+    for (auto _ : state) {
+        try {
+            benchmark::DoNotOptimize(card->processApdu(apdu));
+        } catch (const CardIOException& e) {
+            benchmark::DoNotOptimize(e);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_processApdu_miss)->RangeMultiplier(4)->Range(4, 1024);
@@ -0,0 +1,49 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+/* Keyple Plugin Stub */
+#include "StubTracer.h"
+
+using namespace keyple::plugin::stub;
+
+static const std::string TARGET = "reader0";
+
+/* Cost of recording an event, with the tracer started or stopped */
+static void BM_tracerScope(benchmark::State& state)
+{
+    const bool isStarted = state.range(0) != 0;
+    if (isStarted) {
+        StubTracer::start();
+    }
+
+    std::size_t eventCount = 0;
+    for (auto _ : state) {
+        const StubTracer::Scope scope("bench", TARGET);
+
+        /* Restarts before the buffer is full, so that no event is dropped */
+        if (isStarted && ++eventCount == StubTracer::MAX_EVENT_COUNT - 1) {
+            state.PauseTiming();
+            StubTracer::start();
+            eventCount = 0;
+            state.ResumeTiming();
+        }
+    }
+
+    StubTracer::stop();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_tracerScope)->Arg(0)->Arg(1);
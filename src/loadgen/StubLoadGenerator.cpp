@@ -0,0 +1,425 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+/*
+ * Reference load on the stub pool plugin.
+ *
+ * A StubPoolPluginFactory is built with N readers holding cards of M profiles, one reader group
+ * per profile. T worker threads then repeat sessions until the duration is over: allocate a reader
+ * of a profile, exchange the APDU script of the profile through transmitApdu() and release the
+ * reader. The throughput and the latency percentiles of each stage are reported at the end.
+ *
+ * Usage: stub-loadgen [--readers=N] [--profiles=M] [--threads=T] [--apdus=K] [--shards=S]
+ *                     [--duration=SECONDS] [--json]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+#include "Logger.h"
+
+/* Keyple Core Plugin */
+#include "PluginIOException.h"
+
+/* Keyple Plugin Stub */
+#include "StubMetrics.h"
+#include "StubPoolPluginAdapter.h"
+#include "StubPoolPluginFactoryAdapter.h"
+#include "StubPoolPluginFactoryBuilder.h"
+#include "StubSmartCard.h"
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp;
+using namespace keyple::plugin::stub;
+
+using Clock = std::chrono::steady_clock;
+
+/* OPTIONS -------------------------------------------------------------------------------------- */
+
+struct Options {
+    std::size_t mReaderCount = 1024;
+    std::size_t mProfileCount = 4;
+    std::size_t mThreadCount = 4;
+    std::size_t mApduCount = 8;
+    std::size_t mShardCount = 1;
+    double mDuration = 5;
+    bool mJson = false;
+};
+
+/* Value of an option "name=value", nullptr if the argument is another option */
+static const char* getOptionValue(const char* arg, const char* name)
+{
+    const std::size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') {
+        return nullptr;
+    }
+
+    return arg + length + 1;
+}
+
+/* Unsigned integer option, isValid cleared if the whole value is not one */
+static bool parseOption(const char* arg, const char* name, std::size_t& value, bool& isValid)
+{
+    const char* const text = getOptionValue(arg, name);
+    if (text == nullptr) {
+        return false;
+    }
+
+    char* end;
+    errno = 0;
+    const unsigned long long number = std::strtoull(text, &end, 10);
+    isValid = std::isdigit(static_cast<unsigned char>(*text)) && *end == '\0' && errno == 0 &&
+              number <= std::numeric_limits<std::size_t>::max();
+    value = static_cast<std::size_t>(number);
+
+    return true;
+}
+
+/* Decimal option, isValid cleared if the whole value is not a finite number */
+static bool parseOption(const char* arg, const char* name, double& value, bool& isValid)
+{
+    const char* const text = getOptionValue(arg, name);
+    if (text == nullptr) {
+        return false;
+    }
+
+    char* end;
+    errno = 0;
+    value = std::strtod(text, &end);
+    isValid = end != text && *end == '\0' && errno == 0 && std::isfinite(value);
+
+    return true;
+}
+
+static bool parseOptions(const int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool isValid = true;
+        if (parseOption(arg, "--readers", options.mReaderCount, isValid) ||
+            parseOption(arg, "--profiles", options.mProfileCount, isValid) ||
+            parseOption(arg, "--threads", options.mThreadCount, isValid) ||
+            parseOption(arg, "--apdus", options.mApduCount, isValid) ||
+            parseOption(arg, "--shards", options.mShardCount, isValid) ||
+            parseOption(arg, "--duration", options.mDuration, isValid)) {
+            if (!isValid) {
+                return false;
+            }
+        } else if (std::strcmp(arg, "--json") == 0) {
+            options.mJson = true;
+        } else {
+            return false;
+        }
+    }
+
+    /* Each profile needs a reader and a script of at least a select and a read */
+    return options.mProfileCount >= 1 &&
+           options.mReaderCount >= options.mProfileCount &&
+           options.mThreadCount >= 1 &&
+           options.mApduCount >= 2 &&
+           options.mShardCount >= 1 &&
+           options.mDuration > 0;
+}
+
+/* WORKLOAD ------------------------------------------------------------------------------------- */
+
+/* APDU exchanged with a card and the response expected */
+struct ScriptStep {
+    std::vector<uint8_t> mApdu;
+    std::vector<uint8_t> mResponse;
+};
+
+/*
+ * Card of a profile and its script: a select application (literal command), reads of records
+ * (literal commands) and a get challenge (regular expression), as a typical ticketing session.
+ */
+static std::shared_ptr<StubSmartCard> buildProfile(const std::size_t profile,
+                                                   const std::size_t apduCount,
+                                                   std::vector<ScriptStep>& script)
+{
+    const std::string profileHex = HexUtil::toHex(static_cast<uint8_t>(profile & 0xFF));
+
+    std::vector<std::pair<std::string, std::string>> hexCommands;
+    hexCommands.push_back({"00A4040005315449432E" + profileHex, "6F0A8408315449432E" +
+                                                                profileHex + "9000"});
+    for (std::size_t i = 1; i + 1 < apduCount; i++) {
+        const std::string record = HexUtil::toHex(static_cast<uint8_t>(i & 0xFF));
+        hexCommands.push_back({"00B2" + record + "041D", record + profileHex +
+                                                         std::string(54, 'A') + "9000"});
+    }
+    hexCommands.push_back({"00840000.*", "0102030405060708" + profileHex + "9000"});
+
+    const auto builder = StubSmartCard::builder();
+    StubSmartCard::CommandStep& commandStep =
+        builder->withPowerOnData({0x3B, 0x88, 0x80, 0x01, static_cast<uint8_t>(profile & 0xFF)})
+                .withProtocol("ISO_14443_4");
+    StubSmartCard::SimulatedCommandStep* simulatedCommandStep =
+        &commandStep.withSimulatedCommand(hexCommands[0].first, hexCommands[0].second);
+    for (std::size_t i = 1; i < hexCommands.size(); i++) {
+        simulatedCommandStep =
+            &simulatedCommandStep->withSimulatedCommand(hexCommands[i].first,
+                                                        hexCommands[i].second);
+    }
+
+    for (const auto& hexCommand : hexCommands) {
+        const std::string command = hexCommand.first == "00840000.*" ? "0084000008"
+                                                                      : hexCommand.first;
+        script.push_back({HexUtil::toByteArray(command), HexUtil::toByteArray(hexCommand.second)});
+    }
+
+    return simulatedCommandStep->build();
+}
+
+static std::string getGroup(const std::size_t profile)
+{
+    return "profile" + std::to_string(profile);
+}
+
+/* Measures of a worker thread */
+struct WorkerResult {
+    StubMetrics::Histogram mAllocate;
+    StubMetrics::Histogram mTransmit;
+    StubMetrics::Histogram mRelease;
+    StubMetrics::Histogram mSession;
+    uint64_t mAllocationFailures = 0;
+    uint64_t mErrors = 0;
+};
+
+static uint64_t elapsed(const Clock::time_point& start, const Clock::time_point& end)
+{
+    return static_cast<uint64_t>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+static void runWorker(const std::size_t worker,
+                      StubPoolPluginAdapter& pool,
+                      const std::vector<std::vector<ScriptStep>>& scripts,
+                      const std::atomic<bool>& running,
+                      WorkerResult& result)
+{
+    const std::size_t profileCount = scripts.size();
+    std::size_t profile = worker % profileCount;
+
+    while (running) {
+        profile = (profile + 1) % profileCount;
+        const std::string group = getGroup(profile);
+
+        const Clock::time_point start = Clock::now();
+
+        std::shared_ptr<ReaderSpi> reader;
+        try {
+            reader = pool.allocateReader(group);
+        } catch (const PluginIOException& e) {
+            (void)e;
+            /* All the readers of the group are in use */
+            result.mAllocationFailures++;
+            continue;
+        }
+
+        const Clock::time_point allocated = Clock::now();
+        result.mAllocate.record(elapsed(start, allocated));
+
+        Clock::time_point last = allocated;
+        for (const auto& step : scripts[profile]) {
+            try {
+                if (reader->transmitApdu(step.mApdu) != step.mResponse) {
+                    result.mErrors++;
+                }
+            } catch (const std::exception& e) {
+                (void)e;
+                result.mErrors++;
+            }
+
+            const Clock::time_point transmitted = Clock::now();
+            result.mTransmit.record(elapsed(last, transmitted));
+            last = transmitted;
+        }
+
+        pool.releaseReader(reader);
+
+        const Clock::time_point released = Clock::now();
+        result.mRelease.record(elapsed(last, released));
+        result.mSession.record(elapsed(start, released));
+    }
+}
+
+/* REPORT --------------------------------------------------------------------------------------- */
+
+static const double PERCENTILES[] = {50, 90, 99, 99.9};
+static const char* const PERCENTILE_NAMES[] = {"p50", "p90", "p99", "p999"};
+
+static void printStage(const char* name, const StubMetrics::Histogram& histogram, const bool json)
+{
+    if (json) {
+        std::printf("    \"%s\": {\"count\": %llu, \"mean_ns\": %llu",
+                    name,
+                    static_cast<unsigned long long>(histogram.getCount()),
+                    static_cast<unsigned long long>(histogram.getMean()));
+        for (std::size_t i = 0; i < 4; i++) {
+            std::printf(", \"%s_ns\": %llu",
+                        PERCENTILE_NAMES[i],
+                        static_cast<unsigned long long>(
+                            histogram.getValueAtPercentile(PERCENTILES[i])));
+        }
+        std::printf(", \"max_ns\": %llu}",
+                    static_cast<unsigned long long>(histogram.getMax()));
+    } else {
+        std::printf("%-10s %12llu %10llu",
+                    name,
+                    static_cast<unsigned long long>(histogram.getCount()),
+                    static_cast<unsigned long long>(histogram.getMean()));
+        for (std::size_t i = 0; i < 4; i++) {
+            std::printf(" %10llu",
+                        static_cast<unsigned long long>(
+                            histogram.getValueAtPercentile(PERCENTILES[i])));
+        }
+        std::printf(" %10llu\n", static_cast<unsigned long long>(histogram.getMax()));
+    }
+}
+
+static void printReport(const Options& options, const WorkerResult& total, const double seconds)
+{
+    const double sessionRate = static_cast<double>(total.mSession.getCount()) / seconds;
+    const double apduRate = static_cast<double>(total.mTransmit.getCount()) / seconds;
+
+    if (options.mJson) {
+        std::printf("{\n  \"readers\": %zu,\n  \"profiles\": %zu,\n  \"threads\": %zu,\n"
+                    "  \"apdus\": %zu,\n  \"shards\": %zu,\n  \"duration_s\": %.3f,\n"
+                    "  \"sessions_per_s\": %.1f,\n  \"apdus_per_s\": %.1f,\n"
+                    "  \"allocation_failures\": %llu,\n  \"errors\": %llu,\n  \"stages\": {\n",
+                    options.mReaderCount,
+                    options.mProfileCount,
+                    options.mThreadCount,
+                    options.mApduCount,
+                    options.mShardCount,
+                    seconds,
+                    sessionRate,
+                    apduRate,
+                    static_cast<unsigned long long>(total.mAllocationFailures),
+                    static_cast<unsigned long long>(total.mErrors));
+        printStage("allocate", total.mAllocate, true);
+        std::printf(",\n");
+        printStage("transmit", total.mTransmit, true);
+        std::printf(",\n");
+        printStage("release", total.mRelease, true);
+        std::printf(",\n");
+        printStage("session", total.mSession, true);
+        std::printf("\n  }\n}\n");
+        return;
+    }
+
+    std::printf("readers=%zu profiles=%zu threads=%zu apdus=%zu shards=%zu duration=%.3fs\n",
+                options.mReaderCount,
+                options.mProfileCount,
+                options.mThreadCount,
+                options.mApduCount,
+                options.mShardCount,
+                seconds);
+    std::printf("throughput: %.1f sessions/s, %.1f APDUs/s\n", sessionRate, apduRate);
+    std::printf("allocation failures: %llu, errors: %llu\n\n",
+                static_cast<unsigned long long>(total.mAllocationFailures),
+                static_cast<unsigned long long>(total.mErrors));
+    std::printf("%-10s %12s %10s %10s %10s %10s %10s %10s\n",
+                "stage (ns)", "count", "mean", "p50", "p90", "p99", "p999", "max");
+    printStage("allocate", total.mAllocate, false);
+    printStage("transmit", total.mTransmit, false);
+    printStage("release", total.mRelease, false);
+    printStage("session", total.mSession, false);
+}
+
+/* MAIN ----------------------------------------------------------------------------------------- */
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--readers=N] [--profiles=M] [--threads=T] [--apdus=K] " \
+                     "[--shards=S] [--duration=SECONDS] [--json]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    Logger::setLoggerLevel(Logger::Level::logError);
+
+    /* Readers are spread over the profiles, each reader holding a copy of its profile card */
+    std::vector<std::shared_ptr<StubSmartCard>> profiles;
+    std::vector<std::vector<ScriptStep>> scripts(options.mProfileCount);
+    for (std::size_t i = 0; i < options.mProfileCount; i++) {
+        profiles.push_back(buildProfile(i, options.mApduCount, scripts[i]));
+    }
+
+    const auto builder = StubPoolPluginFactoryBuilder::builder();
+    builder->withShardCount(options.mShardCount);
+    for (std::size_t i = 0; i < options.mReaderCount; i++) {
+        builder->withStubReader(getGroup(i % options.mProfileCount),
+                                "reader" + std::to_string(i),
+                                profiles[i % options.mProfileCount]->copy());
+    }
+
+    const auto factory = std::dynamic_pointer_cast<StubPoolPluginFactoryAdapter>(builder->build());
+    const auto pool = std::dynamic_pointer_cast<StubPoolPluginAdapter>(factory->getPoolPlugin());
+
+    std::atomic<bool> running(true);
+    std::vector<WorkerResult> results(options.mThreadCount);
+    std::vector<std::thread> workers;
+
+    const Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < options.mThreadCount; i++) {
+        workers.push_back(std::thread(runWorker,
+                                      i,
+                                      std::ref(*pool),
+                                      std::cref(scripts),
+                                      std::cref(running),
+                                      std::ref(results[i])));
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.mDuration));
+    running = false;
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    pool->onUnregister();
+
+    WorkerResult total;
+    for (const auto& result : results) {
+        total.mAllocate.merge(result.mAllocate);
+        total.mTransmit.merge(result.mTransmit);
+        total.mRelease.merge(result.mRelease);
+        total.mSession.merge(result.mSession);
+        total.mAllocationFailures += result.mAllocationFailures;
+        total.mErrors += result.mErrors;
+    }
+
+    printReport(options, total, seconds);
+
+    return total.mErrors == 0 ? 0 : 2;
+}
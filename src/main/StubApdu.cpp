@@ -0,0 +1,228 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubApdu.h"
+
+#include <algorithm>
+#include <cstring>
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util;
+
+/* Value of a hexadecimal digit, or 16 if the character is not one */
+static uint8_t getDigitValue(const char c)
+{
+    if (c >= '0' && c <= '9') {
+        return static_cast<uint8_t>(c - '0');
+    } else if (c >= 'A' && c <= 'F') {
+        return static_cast<uint8_t>(c - 'A' + 10);
+    } else if (c >= 'a' && c <= 'f') {
+        return static_cast<uint8_t>(c - 'a' + 10);
+    }
+
+    return 16;
+}
+
+const std::size_t StubApdu::INLINE_CAPACITY;
+
+StubApdu::StubApdu() : mHeapCapacity(0), mSize(0) {}
+
+StubApdu::StubApdu(const uint8_t* data, const std::size_t size) : StubApdu()
+{
+    assign(data, size);
+}
+
+StubApdu::StubApdu(const std::vector<uint8_t>& bytes) : StubApdu()
+{
+    assign(bytes.data(), bytes.size());
+}
+
+StubApdu::StubApdu(const StubApdu& other) : StubApdu()
+{
+    assign(other.data(), other.size());
+}
+
+StubApdu::StubApdu(StubApdu&& other) : StubApdu()
+{
+    *this = std::move(other);
+}
+
+StubApdu& StubApdu::operator=(const StubApdu& other)
+{
+    if (this != &other) {
+        assign(other.data(), other.size());
+    }
+
+    return *this;
+}
+
+StubApdu& StubApdu::operator=(StubApdu&& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    if (other.isInline()) {
+        assign(other.data(), other.size());
+    } else {
+        mHeap = std::move(other.mHeap);
+        mHeapCapacity = other.mHeapCapacity;
+        mSize = other.mSize;
+        other.mHeapCapacity = 0;
+    }
+
+    other.mSize = 0;
+
+    return *this;
+}
+
+const uint8_t* StubApdu::data() const
+{
+    return isInline() ? mInline : mHeap.get();
+}
+
+uint8_t* StubApdu::data()
+{
+    return isInline() ? mInline : mHeap.get();
+}
+
+std::size_t StubApdu::size() const
+{
+    return mSize;
+}
+
+bool StubApdu::empty() const
+{
+    return mSize == 0;
+}
+
+std::size_t StubApdu::capacity() const
+{
+    return isInline() ? INLINE_CAPACITY : mHeapCapacity;
+}
+
+bool StubApdu::isInline() const
+{
+    return mHeap == nullptr;
+}
+
+void StubApdu::assign(const uint8_t* data, const std::size_t size)
+{
+    /* The previous bytes are not kept, the source may not overlap the storage */
+    mSize = 0;
+    resize(size);
+    if (size > 0) {
+        std::memcpy(this->data(), data, size);
+    }
+}
+
+void StubApdu::assignHex(const std::string& hex)
+{
+    bool isValid = hex.size() % 2 == 0;
+    for (std::size_t i = 0; isValid && i < hex.size(); i++) {
+        isValid = getDigitValue(hex[i]) < 16;
+    }
+
+    if (!isValid) {
+        /* Same result as the conversion of the valid digits */
+        const std::vector<uint8_t> bytes = HexUtil::toByteArray(hex);
+        assign(bytes.data(), bytes.size());
+        return;
+    }
+
+    mSize = 0;
+    resize(hex.size() / 2);
+    for (std::size_t i = 0; i < mSize; i++) {
+        data()[i] =
+            static_cast<uint8_t>(getDigitValue(hex[2 * i]) << 4 | getDigitValue(hex[2 * i + 1]));
+    }
+}
+
+void StubApdu::resize(const std::size_t size)
+{
+    if (size > capacity()) {
+        /* Doubles the capacity, so that growing byte by byte stays linear */
+        const std::size_t heapCapacity = std::max(size, 2 * capacity());
+        std::unique_ptr<uint8_t[]> heap(new uint8_t[heapCapacity]);
+        if (mSize > 0) {
+            std::memcpy(heap.get(), data(), mSize);
+        }
+
+        mHeap = std::move(heap);
+        mHeapCapacity = heapCapacity;
+    }
+
+    mSize = size;
+}
+
+void StubApdu::clear()
+{
+    mSize = 0;
+}
+
+uint8_t StubApdu::operator[](const std::size_t index) const
+{
+    return data()[index];
+}
+
+uint8_t& StubApdu::operator[](const std::size_t index)
+{
+    return data()[index];
+}
+
+const uint8_t* StubApdu::begin() const
+{
+    return data();
+}
+
+const uint8_t* StubApdu::end() const
+{
+    return data() + mSize;
+}
+
+std::vector<uint8_t> StubApdu::toVector() const
+{
+    return std::vector<uint8_t>(begin(), end());
+}
+
+std::string StubApdu::toHex() const
+{
+    static const char digits[] = "0123456789ABCDEF";
+
+    std::string hex(2 * mSize, '0');
+    for (std::size_t i = 0; i < mSize; i++) {
+        hex[2 * i] = digits[data()[i] >> 4];
+        hex[2 * i + 1] = digits[data()[i] & 0x0F];
+    }
+
+    return hex;
+}
+
+bool StubApdu::operator==(const StubApdu& other) const
+{
+    return mSize == other.mSize && std::equal(begin(), end(), other.begin());
+}
+
+bool StubApdu::operator!=(const StubApdu& other) const
+{
+    return !(*this == other);
+}
+
+}
+}
+}
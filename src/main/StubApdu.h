@@ -0,0 +1,260 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+/**
+ * (package-private)<br>
+ * Bytes of an APDU command or response, stored inline up to INLINE_CAPACITY bytes, which holds any
+ * short APDU (at most 261 bytes for a command and 258 for a response), and on the heap beyond,
+ * for the extended APDUs.
+ *
+ * <p>Once on the heap, the storage is kept and reused by the following assignments.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubApdu final {
+public:
+    /**
+     * Number of bytes stored without allocation.
+     *
+     * @since 2.2.0
+     */
+    static const std::size_t INLINE_CAPACITY = 261;
+
+    /**
+     * (package-private)<br>
+     * Creates an empty APDU.
+     *
+     * @since 2.2.0
+     */
+    StubApdu();
+
+    /**
+     * (package-private)<br>
+     * Creates an APDU from bytes.
+     *
+     * @param data the bytes
+     * @param size the number of bytes
+     * @since 2.2.0
+     */
+    StubApdu(const uint8_t* data, const std::size_t size);
+
+    /**
+     * (package-private)<br>
+     * Creates an APDU from bytes.
+     *
+     * @param bytes the bytes
+     * @since 2.2.0
+     */
+    explicit StubApdu(const std::vector<uint8_t>& bytes);
+
+    /**
+     *
+     */
+    StubApdu(const StubApdu& other);
+
+    /**
+     * Takes the heap storage of the other APDU, if any.
+     */
+    StubApdu(StubApdu&& other);
+
+    /**
+     *
+     */
+    StubApdu& operator=(const StubApdu& other);
+
+    /**
+     * Takes the heap storage of the other APDU, if any.
+     */
+    StubApdu& operator=(StubApdu&& other);
+
+    /**
+     * (package-private)<br>
+     *
+     * @return the bytes
+     * @since 2.2.0
+     */
+    const uint8_t* data() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @return the bytes
+     * @since 2.2.0
+     */
+    uint8_t* data();
+
+    /**
+     * (package-private)<br>
+     *
+     * @return the number of bytes
+     * @since 2.2.0
+     */
+    std::size_t size() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @return true if the APDU has no bytes
+     * @since 2.2.0
+     */
+    bool empty() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @return the number of bytes which can be stored without allocation
+     * @since 2.2.0
+     */
+    std::size_t capacity() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @return true if the bytes are not on the heap
+     * @since 2.2.0
+     */
+    bool isInline() const;
+
+    /**
+     * (package-private)<br>
+     * Replaces the bytes.
+     *
+     * @param data the bytes
+     * @param size the number of bytes
+     * @since 2.2.0
+     */
+    void assign(const uint8_t* data, const std::size_t size);
+
+    /**
+     * (package-private)<br>
+     * Replaces the bytes by hexadecimal digits converted as HexUtil::toByteArray() does, without
+     * allocation for valid digits.
+     *
+     * @param hex the hexadecimal digits
+     * @since 2.2.0
+     */
+    void assignHex(const std::string& hex);
+
+    /**
+     * (package-private)<br>
+     * Changes the number of bytes, keeping the first ones. The added bytes are not initialized.
+     *
+     * @param size the number of bytes
+     * @since 2.2.0
+     */
+    void resize(const std::size_t size);
+
+    /**
+     * (package-private)<br>
+     * Removes all the bytes, keeping the storage.
+     *
+     * @since 2.2.0
+     */
+    void clear();
+
+    /**
+     * (package-private)<br>
+     *
+     * @since 2.2.0
+     */
+    uint8_t operator[](const std::size_t index) const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @since 2.2.0
+     */
+    uint8_t& operator[](const std::size_t index);
+
+    /**
+     * (package-private)<br>
+     *
+     * @since 2.2.0
+     */
+    const uint8_t* begin() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @since 2.2.0
+     */
+    const uint8_t* end() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @return a copy of the bytes
+     * @since 2.2.0
+     */
+    std::vector<uint8_t> toVector() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @return the bytes as upper case hexadecimal digits
+     * @since 2.2.0
+     */
+    std::string toHex() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @since 2.2.0
+     */
+    bool operator==(const StubApdu& other) const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @since 2.2.0
+     */
+    bool operator!=(const StubApdu& other) const;
+
+private:
+    /**
+     *
+     */
+    uint8_t mInline[INLINE_CAPACITY];
+
+    /**
+     * Storage of the bytes beyond INLINE_CAPACITY, nullptr until needed
+     */
+    std::unique_ptr<uint8_t[]> mHeap;
+
+    /**
+     * Capacity of mHeap
+     */
+    std::size_t mHeapCapacity;
+
+    /**
+     *
+     */
+    std::size_t mSize;
+};
+
+}
+}
+}
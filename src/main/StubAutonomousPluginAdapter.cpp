@@ -0,0 +1,183 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubAutonomousPluginAdapter.h"
+
+#include <set>
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+StubAutonomousPluginAdapter::StubAutonomousPluginAdapter(
+  const std::string& name,
+  const StubPluginFactoryAdapter::ReaderConfigurations& readerConfigurations,
+  const bool lazyReaderCreation)
+: mStubPluginAdapter(std::make_shared<StubPluginAdapter>(name,
+                                                         readerConfigurations,
+                                                         0,
+                                                         lazyReaderCreation)),
+  mAutonomousObservablePluginApi(nullptr) {}
+
+void StubAutonomousPluginAdapter::connect(
+    AutonomousObservablePluginApi* autonomousObservablePluginApi)
+{
+    mAutonomousObservablePluginApi = autonomousObservablePluginApi;
+}
+
+const std::string& StubAutonomousPluginAdapter::getName() const
+{
+    return mStubPluginAdapter->getName();
+}
+
+const std::vector<std::shared_ptr<ReaderSpi>> StubAutonomousPluginAdapter::searchAvailableReaders()
+{
+    return mStubPluginAdapter->searchAvailableReaders();
+}
+
+void StubAutonomousPluginAdapter::onUnregister()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mAutonomousObservablePluginApi = nullptr;
+    mStubPluginAdapter->onUnregister();
+}
+
+void StubAutonomousPluginAdapter::plugReader(const std::string& name,
+                                             const bool isContactless,
+                                             std::shared_ptr<StubSmartCard> card)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mStubPluginAdapter->searchReader(name) != nullptr) {
+        /* Already plugged, nothing changes */
+        return;
+    }
+
+    mStubPluginAdapter->plugReader(name, isContactless, card);
+
+    AutonomousObservablePluginApi* const api = mAutonomousObservablePluginApi;
+    if (api != nullptr) {
+        api->onReaderConnected({mStubPluginAdapter->searchReader(name)});
+    }
+}
+
+void StubAutonomousPluginAdapter::unplugReader(const std::string& name)
+{
+    unplugReaders({name});
+}
+
+void StubAutonomousPluginAdapter::plugReaders(
+    const std::vector<std::string>& names,
+    const bool isContactless,
+    const std::vector<std::shared_ptr<StubSmartCard>>& cards)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const std::vector<std::string> newReaderNames = filterReaderNames(names, false);
+
+    mStubPluginAdapter->plugReaders(names, isContactless, cards);
+
+    AutonomousObservablePluginApi* const api = mAutonomousObservablePluginApi;
+    if (api != nullptr && !newReaderNames.empty()) {
+        std::vector<std::shared_ptr<ReaderSpi>> readers;
+        readers.reserve(newReaderNames.size());
+        for (const auto& name : newReaderNames) {
+            readers.push_back(mStubPluginAdapter->searchReader(name));
+        }
+
+        api->onReaderConnected(readers);
+    }
+}
+
+void StubAutonomousPluginAdapter::unplugReaders(const std::vector<std::string>& names)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const std::vector<std::string> pluggedReaderNames = filterReaderNames(names, true);
+    if (pluggedReaderNames.empty()) {
+        return;
+    }
+
+    mStubPluginAdapter->unplugReaders(pluggedReaderNames);
+
+    AutonomousObservablePluginApi* const api = mAutonomousObservablePluginApi;
+    if (api != nullptr) {
+        api->onReaderDisconnected(pluggedReaderNames);
+    }
+}
+
+std::shared_ptr<ReaderSpi> StubAutonomousPluginAdapter::searchReader(const std::string& readerName)
+{
+    return mStubPluginAdapter->searchReader(readerName);
+}
+
+const std::vector<uint8_t> StubAutonomousPluginAdapter::createSnapshot()
+{
+    return mStubPluginAdapter->createSnapshot();
+}
+
+void StubAutonomousPluginAdapter::restoreSnapshot(const std::vector<uint8_t>& snapshot)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    /* Listed without creating the readers not created yet */
+    const std::vector<std::string> previousReaderNames =
+        mStubPluginAdapter->searchAvailableReaderNames();
+
+    mStubPluginAdapter->restoreSnapshot(snapshot);
+
+    AutonomousObservablePluginApi* const api = mAutonomousObservablePluginApi;
+    if (api == nullptr) {
+        return;
+    }
+
+    /* The core holds the previous readers, even those whose name is restored */
+    if (!previousReaderNames.empty()) {
+        api->onReaderDisconnected(previousReaderNames);
+    }
+
+    const std::vector<std::shared_ptr<ReaderSpi>> readers =
+        mStubPluginAdapter->searchAvailableReaders();
+    if (!readers.empty()) {
+        api->onReaderConnected(readers);
+    }
+}
+
+const std::string StubAutonomousPluginAdapter::getPrometheusMetrics()
+{
+    return mStubPluginAdapter->getPrometheusMetrics();
+}
+
+void StubAutonomousPluginAdapter::writePrometheusMetrics(const std::string& path)
+{
+    mStubPluginAdapter->writePrometheusMetrics(path);
+}
+
+const std::vector<std::string> StubAutonomousPluginAdapter::filterReaderNames(
+    const std::vector<std::string>& names, const bool isPlugged)
+{
+    std::vector<std::string> filteredNames;
+    std::set<std::string> seenNames;
+    for (const auto& name : names) {
+        if (seenNames.insert(name).second &&
+            (mStubPluginAdapter->searchReader(name) != nullptr) == isPlugged) {
+            filteredNames.push_back(name);
+        }
+    }
+
+    return filteredNames;
+}
+
+}
+}
+}
@@ -0,0 +1,215 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Keyple Core Plugin */
+#include "AutonomousObservablePluginApi.h"
+#include "AutonomousObservablePluginSpi.h"
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+#include "StubPlugin.h"
+#include "StubPluginAdapter.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::plugin::spi;
+
+/**
+ * (package-private)<br>
+ * Adapter of the {@link StubPlugin} notifying the plugged and unplugged readers to the core as
+ * they happen, instead of letting it poll the reader names every monitoring cycle.
+ *
+ * <p>Readers are managed by a StubPluginAdapter, the events are raised once its reader set has
+ * changed. Changes made before the core is connected are not notified, the core discovers the
+ * readers with searchAvailableReaders() when the plugin is registered.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubAutonomousPluginAdapter final
+: public StubPlugin, public AutonomousObservablePluginSpi {
+public:
+    /**
+     * (package-private)<br>
+     * Constructor
+     *
+     * @param name name of the plugin
+     * @param readerConfigurations configurations of the reader to plug initially (not null)
+     * @param lazyReaderCreation true to create the configured readers on first access
+     * @since 2.2.0
+     */
+    StubAutonomousPluginAdapter(
+        const std::string& name,
+        const StubPluginFactoryAdapter::ReaderConfigurations& readerConfigurations,
+        const bool lazyReaderCreation = false);
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void connect(AutonomousObservablePluginApi* autonomousObservablePluginApi) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    const std::string& getName() const override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    const std::vector<std::shared_ptr<ReaderSpi>> searchAvailableReaders() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>No event is raised afterwards.
+     *
+     * @since 2.2.0
+     */
+    void onUnregister() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The reader is notified to the core before returning.
+     *
+     * @since 2.2.0
+     */
+    void plugReader(const std::string& name,
+                    const bool isContactless,
+                    std::shared_ptr<StubSmartCard> card) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The reader is notified to the core before returning.
+     *
+     * @since 2.2.0
+     */
+    void unplugReader(const std::string& name) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The new readers are notified to the core in a single event.
+     *
+     * @since 2.2.0
+     */
+    void plugReaders(const std::vector<std::string>& names,
+                     const bool isContactless,
+                     const std::vector<std::shared_ptr<StubSmartCard>>& cards) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * <p>The unplugged readers are notified to the core in a single event.
+     *
+     * @since 2.2.0
+     */
+    void unplugReaders(const std::vector<std::string>& names) override;
+
+    /**
+     * (package-private)<br>
+     * Looks up a plugged reader.
+     *
+     * @param readerName name of the reader
+     * @return the reader or nullptr if no reader has this name
+     * @since 2.2.0
+     */
+    std::shared_ptr<ReaderSpi> searchReader(const std::string& readerName);
+
+    /**
+     * (package-private)<br>
+     * Saves the state of the plugin, as StubPluginAdapter::createSnapshot() does.
+     *
+     * @return the snapshot
+     * @throw IllegalStateException if a card gets its responses from an ApduResponseProviderSpi
+     *        or from a compiled profile
+     * @since 2.2.0
+     */
+    const std::vector<uint8_t> createSnapshot();
+
+    /**
+     * (package-private)<br>
+     * Replaces the readers of the plugin by those of a snapshot, as
+     * StubPluginAdapter::restoreSnapshot() does.
+     *
+     * <p>Every reader is replaced by a new one, the previous readers are notified to the core as
+     * disconnected and the restored ones as connected, each in a single event.
+     *
+     * @param snapshot a snapshot created by createSnapshot()
+     * @throw IllegalArgumentException if the snapshot is not valid
+     * @since 2.2.0
+     */
+    void restoreSnapshot(const std::vector<uint8_t>& snapshot);
+
+    /**
+     * (package-private)<br>
+     * Renders the metrics of the plugin, as StubPluginAdapter::getPrometheusMetrics() does.
+     *
+     * @return the metrics
+     * @since 2.2.0
+     */
+    const std::string getPrometheusMetrics();
+
+    /**
+     * (package-private)<br>
+     * Writes the metrics rendered by getPrometheusMetrics() to a file, replacing it at once.
+     *
+     * @param path the path of the file
+     * @throw IllegalArgumentException if the file cannot be written
+     * @since 2.2.0
+     */
+    void writePrometheusMetrics(const std::string& path);
+
+private:
+    /**
+     *
+     */
+    const std::shared_ptr<StubPluginAdapter> mStubPluginAdapter;
+
+    /**
+     * Core to notify, null until connected and after unregistration
+     */
+    std::atomic<AutonomousObservablePluginApi*> mAutonomousObservablePluginApi;
+
+    /**
+     * Serializes the changes so that the events reach the core in the order of the changes
+     */
+    std::mutex mMutex;
+
+    /**
+     * (private)<br>
+     * Keeps the names matching (or not) a plugged reader, without duplicates.
+     */
+    const std::vector<std::string> filterReaderNames(const std::vector<std::string>& names,
+                                                     const bool isPlugged);
+};
+
+}
+}
+}
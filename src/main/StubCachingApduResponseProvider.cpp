@@ -0,0 +1,159 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubCachingApduResponseProvider.h"
+
+#include <algorithm>
+#include <functional>
+
+/* Keyple Core Util */
+#include "KeypleAssert.h"
+
+/* Keyple Plugin Stub */
+#include "StubMetrics.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util;
+
+const std::size_t StubCachingApduResponseProvider::DEFAULT_SHARD_COUNT = 16;
+
+static const uint64_t NANOSECONDS_PER_MILLISECOND = 1000000;
+
+StubCachingApduResponseProvider::StubCachingApduResponseProvider(
+    const std::shared_ptr<ApduResponseProviderSpi> apduResponseProvider,
+    const std::size_t capacity,
+    const int timeToLive,
+    const std::size_t shardCount)
+: mApduResponseProvider(apduResponseProvider),
+  mTimeToLive(timeToLive < 0 ? 0 : static_cast<uint64_t>(timeToLive) * NANOSECONDS_PER_MILLISECOND)
+{
+    Assert::getInstance().notNull(apduResponseProvider, "apduResponseProvider")
+                         .isTrue(capacity >= 1, "capacity >= 1")
+                         .greaterOrEqual(timeToLive, 0, "timeToLive")
+                         .isTrue(shardCount >= 1, "shardCount >= 1");
+
+    /* The capacity is split exactly, each shard holding at least one entry */
+    const std::size_t count = std::min(shardCount, capacity);
+    for (std::size_t i = 0; i < count; i++) {
+        mShards.push_back(std::unique_ptr<Shard>(new Shard()));
+        mShards.back()->mCapacity = capacity / count + (i < capacity % count ? 1 : 0);
+    }
+}
+
+const std::string StubCachingApduResponseProvider::getResponseFromRequest(
+    const std::string& apduRequest)
+{
+    Shard& shard = getShard(apduRequest);
+
+    {
+        std::lock_guard<std::mutex> lock(shard.mMutex);
+
+        const auto it = shard.mIndex.find(apduRequest);
+        if (it != shard.mIndex.end()) {
+            if (it->second->mExpiry == 0 || StubMetrics::now() < it->second->mExpiry) {
+                /* Most recently used */
+                shard.mEntries.splice(shard.mEntries.begin(), shard.mEntries, it->second);
+                shard.mHitCount++;
+
+                return it->second->mResponse;
+            }
+
+            shard.mEntries.erase(it->second);
+            shard.mIndex.erase(it);
+        }
+
+        shard.mMissCount++;
+    }
+
+    /* The provider may be slow, the shard is not locked meanwhile */
+    const std::string response = mApduResponseProvider->getResponseFromRequest(apduRequest);
+    const uint64_t expiry = mTimeToLive == 0 ? 0 : StubMetrics::now() + mTimeToLive;
+
+    std::lock_guard<std::mutex> lock(shard.mMutex);
+
+    /* Another reader may have cached the same response meanwhile */
+    const auto it = shard.mIndex.find(apduRequest);
+    if (it != shard.mIndex.end()) {
+        it->second->mResponse = response;
+        it->second->mExpiry = expiry;
+        shard.mEntries.splice(shard.mEntries.begin(), shard.mEntries, it->second);
+
+        return response;
+    }
+
+    if (shard.mEntries.size() == shard.mCapacity) {
+        /* Least recently used */
+        shard.mIndex.erase(*shard.mEntries.back().mRequest);
+        shard.mEntries.pop_back();
+    }
+
+    shard.mEntries.push_front({nullptr, response, expiry});
+    const auto inserted = shard.mIndex.insert({apduRequest, shard.mEntries.begin()});
+    shard.mEntries.front().mRequest = &inserted.first->first;
+
+    return response;
+}
+
+uint64_t StubCachingApduResponseProvider::getHitCount() const
+{
+    uint64_t hitCount = 0;
+    for (const auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard->mMutex);
+        hitCount += shard->mHitCount;
+    }
+
+    return hitCount;
+}
+
+uint64_t StubCachingApduResponseProvider::getMissCount() const
+{
+    uint64_t missCount = 0;
+    for (const auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard->mMutex);
+        missCount += shard->mMissCount;
+    }
+
+    return missCount;
+}
+
+std::size_t StubCachingApduResponseProvider::getSize() const
+{
+    std::size_t size = 0;
+    for (const auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard->mMutex);
+        size += shard->mEntries.size();
+    }
+
+    return size;
+}
+
+void StubCachingApduResponseProvider::clear()
+{
+    for (const auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard->mMutex);
+        shard->mIndex.clear();
+        shard->mEntries.clear();
+    }
+}
+
+StubCachingApduResponseProvider::Shard& StubCachingApduResponseProvider::getShard(
+    const std::string& apduRequest) const
+{
+    return *mShards[std::hash<std::string>()(apduRequest) % mShards.size()];
+}
+
+}
+}
+}
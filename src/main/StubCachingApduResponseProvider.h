@@ -0,0 +1,193 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Keyple Plugin Stub */
+#include "ApduResponseProviderSpi.h"
+#include "KeyplePluginStubExport.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::plugin::stub::spi;
+
+/**
+ * APDU response provider memoizing the responses of a deterministic provider, which always
+ * returns the same response to the same request.
+ *
+ * <p>The responses are kept by request in a bounded least recently used cache, optionally for a
+ * limited time. The cache is split into shards by the hash of the request, each with its own
+ * lock, so that the readers sharing the provider do not contend on a single lock. The provider
+ * is called outside of the locks: two readers missing the same request at once both call it.
+ *
+ * <p>To use it, pass it to StubSmartCard::Builder::withApduResponseProvider() in place of the
+ * provider it wraps.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubCachingApduResponseProvider final : public ApduResponseProviderSpi {
+public:
+    /**
+     * Default number of shards.
+     *
+     * @since 2.2.0
+     */
+    static const std::size_t DEFAULT_SHARD_COUNT;
+
+    /**
+     * Creates a cache in front of a provider.
+     *
+     * @param apduResponseProvider the deterministic provider
+     * @param capacity maximum number of responses kept, split over the shards
+     * @param timeToLive time in milliseconds a response is kept after being provided, 0 to keep
+     *        it until evicted
+     * @param shardCount number of shards, reduced to the capacity if higher
+     * @throw IllegalArgumentException if the provider is null, the capacity or the number of
+     *        shards is zero, or the time to live is negative
+     * @since 2.2.0
+     */
+    StubCachingApduResponseProvider(
+        const std::shared_ptr<ApduResponseProviderSpi> apduResponseProvider,
+        const std::size_t capacity,
+        const int timeToLive = 0,
+        const std::size_t shardCount = DEFAULT_SHARD_COUNT);
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    const std::string getResponseFromRequest(const std::string& apduRequest) override;
+
+    /**
+     * Gets the number of requests answered from the cache.
+     *
+     * @since 2.2.0
+     */
+    uint64_t getHitCount() const;
+
+    /**
+     * Gets the number of requests forwarded to the provider, including those whose response had
+     * expired.
+     *
+     * @since 2.2.0
+     */
+    uint64_t getMissCount() const;
+
+    /**
+     * Gets the number of responses currently cached, expired ones included until looked up or
+     * evicted.
+     *
+     * @since 2.2.0
+     */
+    std::size_t getSize() const;
+
+    /**
+     * Removes all the cached responses. The counters are kept.
+     *
+     * @since 2.2.0
+     */
+    void clear();
+
+private:
+    /**
+     * (private)<br>
+     * Cached response, in the recency list of its shard
+     */
+    struct Entry {
+        /**
+         * Key of the entry in the index of the shard, whose nodes never move
+         */
+        const std::string* mRequest;
+
+        /**
+         *
+         */
+        std::string mResponse;
+
+        /**
+         * Monotonic time in nanoseconds after which the response is no longer used, 0 if never
+         */
+        uint64_t mExpiry;
+    };
+
+    /**
+     * (private)<br>
+     * Part of the cache guarded by its own lock
+     */
+    struct Shard {
+        /**
+         *
+         */
+        mutable std::mutex mMutex;
+
+        /**
+         * Most recently used first
+         */
+        std::list<Entry> mEntries;
+
+        /**
+         *
+         */
+        std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+
+        /**
+         * Maximum number of entries, its part of the capacity of the cache
+         */
+        std::size_t mCapacity = 0;
+
+        /**
+         *
+         */
+        uint64_t mHitCount = 0;
+
+        /**
+         *
+         */
+        uint64_t mMissCount = 0;
+    };
+
+    /**
+     *
+     */
+    const std::shared_ptr<ApduResponseProviderSpi> mApduResponseProvider;
+
+    /**
+     * In nanoseconds
+     */
+    const uint64_t mTimeToLive;
+
+    /**
+     *
+     */
+    std::vector<std::unique_ptr<Shard>> mShards;
+
+    /**
+     * (private)<br>
+     * Gets the shard of a request.
+     */
+    Shard& getShard(const std::string& apduRequest) const;
+};
+
+}
+}
+}
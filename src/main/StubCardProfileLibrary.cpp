@@ -0,0 +1,428 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubCardProfileLibrary.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#if !defined(WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+#include "IllegalArgumentException.h"
+
+/* Keyple Plugin Stub */
+#include "StubCommandTable.h"
+#include "StubSmartCard.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+const uint32_t StubCardProfileLibrary::FORMAT_VERSION = 1;
+const uint32_t StubCardProfileLibrary::MAGIC = 0x5043534B;
+const std::size_t StubCardProfileLibrary::HEADER_SIZE = 16;
+const std::size_t StubCardProfileLibrary::PROFILE_SIZE = 32;
+const std::size_t StubCardProfileLibrary::COMMAND_SIZE = 20;
+const uint32_t StubCardProfileLibrary::PLAIN_COMMAND = 0;
+const uint32_t StubCardProfileLibrary::REGEX_COMMAND = 1;
+
+/* PROFILE -------------------------------------------------------------------------------------- */
+
+std::vector<uint8_t> StubCardProfileLibrary::Profile::getPowerOnData() const
+{
+    const uint8_t* const data = mLibrary->mData;
+
+    return std::vector<uint8_t>(data + mLibrary->readInt(mRecord + 8),
+                                data + mLibrary->readInt(mRecord + 8) +
+                                    mLibrary->readInt(mRecord + 12));
+}
+
+std::string StubCardProfileLibrary::Profile::getCardProtocol() const
+{
+    const char* const data = reinterpret_cast<const char*>(mLibrary->mData);
+
+    return std::string(data + mLibrary->readInt(mRecord + 16), mLibrary->readInt(mRecord + 20));
+}
+
+bool StubCardProfileLibrary::Profile::processApdu(const StubApdu& apduIn,
+                                                  StubApdu& apduOut) const
+{
+    const uint8_t* const data = mLibrary->mData;
+
+    /* At most one plain command has the bytes of the APDU */
+    std::size_t match = static_cast<std::size_t>(-1);
+    if (!mSlots.empty()) {
+        std::size_t slot = StubCommandTable::hash(apduIn.data(), apduIn.size()) &
+                           (mSlots.size() - 1);
+        while (mSlots[slot] != 0) {
+            const std::size_t command = getCommandRecord(mSlots[slot] - 1);
+            if (mLibrary->readInt(command + 8) == apduIn.size() &&
+                std::equal(apduIn.begin(), apduIn.end(), data + mLibrary->readInt(command + 4))) {
+                match = mSlots[slot] - 1;
+                break;
+            }
+            slot = (slot + 1) & (mSlots.size() - 1);
+        }
+    }
+
+    /* A regular expression sorted before the plain command takes precedence */
+    std::string hexApdu;
+    for (std::size_t i = 0; i < mRegexCommands.size() && mRegexCommands[i] < match; i++) {
+        if (hexApdu.empty()) {
+            hexApdu = apduIn.toHex();
+        }
+
+        bool matches;
+        if (mPatterns[i] != nullptr) {
+            matches = mPatterns[i]->matcher(hexApdu)->matches();
+        } else {
+            const std::size_t command = getCommandRecord(mRegexCommands[i]);
+            const std::string regex(reinterpret_cast<const char*>(data) +
+                                        mLibrary->readInt(command + 4),
+                                    mLibrary->readInt(command + 8));
+            matches = Pattern::compile(regex)->matcher(hexApdu)->matches();
+        }
+
+        if (matches) {
+            match = mRegexCommands[i];
+            break;
+        }
+    }
+
+    if (match == static_cast<std::size_t>(-1)) {
+        return false;
+    }
+
+    const std::size_t command = getCommandRecord(match);
+    apduOut.assign(data + mLibrary->readInt(command + 12), mLibrary->readInt(command + 16));
+
+    return true;
+}
+
+std::size_t StubCardProfileLibrary::Profile::getCommandRecord(const std::size_t command) const
+{
+    return HEADER_SIZE +
+           mLibrary->mProfiles.size() * PROFILE_SIZE +
+           (mLibrary->readInt(mRecord + 24) + command) * COMMAND_SIZE;
+}
+
+/* STUB CARD PROFILE LIBRARY -------------------------------------------------------------------- */
+
+void StubCardProfileLibrary::compile(
+    const std::map<std::string, std::shared_ptr<StubSmartCard>>& profiles,
+    const std::string& path)
+{
+    std::size_t commandCount = 0;
+    for (const auto& profile : profiles) {
+        if (profile.second->mApduResponseProvider != nullptr ||
+            profile.second->mProfile != nullptr) {
+            throw IllegalArgumentException("Card profile " + profile.first + " has no simulated " +
+                                           "commands of its own, it cannot be compiled");
+        }
+        commandCount += profile.second->mCommandTable->size();
+    }
+
+    std::string tables;
+    std::string data;
+    const std::size_t dataOffset = HEADER_SIZE +
+                                   profiles.size() * PROFILE_SIZE +
+                                   commandCount * COMMAND_SIZE;
+
+    writeInt(tables, MAGIC);
+    writeInt(tables, FORMAT_VERSION);
+    writeInt(tables, profiles.size());
+    writeInt(tables, commandCount);
+
+    /* The profiles, sorted by name as the map */
+    std::size_t firstCommand = 0;
+    for (const auto& profile : profiles) {
+        const StubSmartCard& card = *profile.second;
+
+        writeInt(tables, dataOffset + data.size());
+        writeInt(tables, profile.first.size());
+        data += profile.first;
+
+        writeInt(tables, dataOffset + data.size());
+        writeInt(tables, card.mPowerOnData.size());
+        data.append(card.mPowerOnData.begin(), card.mPowerOnData.end());
+
+        writeInt(tables, dataOffset + data.size());
+        writeInt(tables, card.mCardProtocol.size());
+        data += card.mCardProtocol;
+
+        writeInt(tables, firstCommand);
+        writeInt(tables, card.mCommandTable->size());
+        firstCommand += card.mCommandTable->size();
+    }
+
+    /* The commands, in the order StubSmartCard tries them */
+    for (const auto& profile : profiles) {
+        const StubCommandTable& commandTable = *profile.second->mCommandTable;
+        for (std::size_t i = 0; i < commandTable.size(); i++) {
+            const std::string command = commandTable.getCommand(i);
+            const std::string response = commandTable.getResponse(i);
+
+            if (!HexUtil::isValid(response)) {
+                throw IllegalArgumentException("Card profile " + profile.first + " has an " +
+                                               "invalid response: " + response);
+            }
+
+            const bool isPlain = StubCommandTable::isPlain(command);
+
+            writeInt(tables, isPlain ? PLAIN_COMMAND : REGEX_COMMAND);
+            writeInt(tables, dataOffset + data.size());
+            if (isPlain) {
+                const std::vector<uint8_t> bytes = HexUtil::toByteArray(command);
+                writeInt(tables, bytes.size());
+                data.append(bytes.begin(), bytes.end());
+            } else {
+                writeInt(tables, command.size());
+                data += command;
+            }
+
+            const std::vector<uint8_t> bytes = HexUtil::toByteArray(response);
+            writeInt(tables, dataOffset + data.size());
+            writeInt(tables, bytes.size());
+            data.append(bytes.begin(), bytes.end());
+        }
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    file << tables << data;
+    file.close();
+
+    if (!file) {
+        throw IllegalArgumentException("Unable to write the card profile library " + path);
+    }
+}
+
+std::shared_ptr<const StubCardProfileLibrary> StubCardProfileLibrary::load(const std::string& path)
+{
+    std::shared_ptr<StubCardProfileLibrary> library(new StubCardProfileLibrary());
+
+#if defined(WIN32)
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file) {
+        throw IllegalArgumentException("Unable to read the card profile library " + path);
+    }
+
+    std::ostringstream content;
+    content << file.rdbuf();
+    const std::string bytes = content.str();
+
+    library->mBuffer.assign(bytes.begin(), bytes.end());
+    library->mData = library->mBuffer.data();
+    library->mSize = library->mBuffer.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw IllegalArgumentException("Unable to read the card profile library " + path);
+    }
+
+    struct stat status;
+    void* data = MAP_FAILED;
+    if (::fstat(fd, &status) == 0 && status.st_size > 0) {
+        data = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED,
+                      fd, 0);
+    }
+
+    /* The mapping stays valid once the file is closed */
+    ::close(fd);
+
+    if (data == MAP_FAILED) {
+        throw IllegalArgumentException("Unable to map the card profile library " + path);
+    }
+
+    library->mData = static_cast<const uint8_t*>(data);
+    library->mSize = static_cast<std::size_t>(status.st_size);
+#endif
+
+    library->open();
+
+    return library;
+}
+
+StubCardProfileLibrary::StubCardProfileLibrary() : mData(nullptr), mSize(0) {}
+
+StubCardProfileLibrary::~StubCardProfileLibrary()
+{
+#if !defined(WIN32)
+    if (mData != nullptr && mBuffer.empty()) {
+        ::munmap(const_cast<uint8_t*>(mData), mSize);
+    }
+#endif
+}
+
+std::vector<std::string> StubCardProfileLibrary::getProfileNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(mProfiles.size());
+    for (std::size_t i = 0; i < mProfiles.size(); i++) {
+        names.push_back(getProfileName(i));
+    }
+
+    return names;
+}
+
+std::shared_ptr<const StubCardProfileLibrary::Profile> StubCardProfileLibrary::getProfile(
+    const std::string& name) const
+{
+    /* Binary search on the names of the file */
+    std::size_t low = 0;
+    std::size_t high = mProfiles.size();
+    while (low < high) {
+        const std::size_t middle = low + (high - low) / 2;
+        const int comparison = getProfileName(middle).compare(name);
+        if (comparison == 0) {
+            return std::shared_ptr<const Profile>(shared_from_this(), &mProfiles[middle]);
+        } else if (comparison < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return nullptr;
+}
+
+void StubCardProfileLibrary::open()
+{
+    if (mSize < HEADER_SIZE || readInt(0) != MAGIC) {
+        throw IllegalArgumentException("Not a card profile library");
+    }
+
+    if (readInt(4) != FORMAT_VERSION) {
+        throw IllegalArgumentException("Unsupported card profile library version " +
+                                       std::to_string(readInt(4)));
+    }
+
+    const uint64_t profileCount = readInt(8);
+    const uint64_t commandCount = readInt(12);
+    const uint64_t commandTable = HEADER_SIZE + profileCount * PROFILE_SIZE;
+
+    if (commandTable + commandCount * COMMAND_SIZE > mSize) {
+        throw IllegalArgumentException("Truncated card profile library");
+    }
+
+    /* Every reference to the data must stay within the file */
+    const auto checkRange = [this](const std::size_t record) {
+        if (static_cast<uint64_t>(readInt(record)) + readInt(record + 4) > mSize) {
+            throw IllegalArgumentException("Corrupted card profile library");
+        }
+    };
+
+    mProfiles.resize(static_cast<std::size_t>(profileCount));
+
+    for (std::size_t i = 0; i < mProfiles.size(); i++) {
+        Profile& profile = mProfiles[i];
+        profile.mLibrary = this;
+        profile.mRecord = HEADER_SIZE + i * PROFILE_SIZE;
+
+        checkRange(profile.mRecord);
+        checkRange(profile.mRecord + 8);
+        checkRange(profile.mRecord + 16);
+
+        const uint64_t firstCommand = readInt(profile.mRecord + 24);
+        const uint64_t profileCommandCount = readInt(profile.mRecord + 28);
+        if (firstCommand + profileCommandCount > commandCount ||
+            (i > 0 && getProfileName(i - 1) >= getProfileName(i))) {
+            throw IllegalArgumentException("Corrupted card profile library");
+        }
+
+        std::vector<uint32_t> plainCommands;
+        for (uint32_t j = 0; j < profileCommandCount; j++) {
+            const std::size_t command =
+                static_cast<std::size_t>(commandTable + (firstCommand + j) * COMMAND_SIZE);
+            checkRange(command + 4);
+            checkRange(command + 12);
+
+            if (readInt(command) == PLAIN_COMMAND) {
+                plainCommands.push_back(j);
+            } else if (readInt(command) == REGEX_COMMAND) {
+                const std::string regex(reinterpret_cast<const char*>(mData) +
+                                            readInt(command + 4),
+                                        readInt(command + 8));
+                profile.mRegexCommands.push_back(j);
+
+                /* An invalid expression throws when reached, as with the simulated commands */
+                try {
+                    profile.mPatterns.push_back(std::shared_ptr<const Pattern>(
+                                                    Pattern::compile(regex)));
+                } catch (...) {
+                    profile.mPatterns.push_back(nullptr);
+                }
+            } else {
+                throw IllegalArgumentException("Corrupted card profile library");
+            }
+        }
+
+        /* Half full at most, so that the probes stay short */
+        if (!plainCommands.empty()) {
+            std::size_t slotCount = 1;
+            while (slotCount < 2 * plainCommands.size()) {
+                slotCount *= 2;
+            }
+            profile.mSlots.assign(slotCount, 0);
+
+            for (const uint32_t j : plainCommands) {
+                const std::size_t command =
+                    static_cast<std::size_t>(commandTable + (firstCommand + j) * COMMAND_SIZE);
+                std::size_t slot = StubCommandTable::hash(mData + readInt(command + 4),
+                                                          readInt(command + 8)) &
+                                   (slotCount - 1);
+                while (profile.mSlots[slot] != 0) {
+                    slot = (slot + 1) & (slotCount - 1);
+                }
+                profile.mSlots[slot] = j + 1;
+            }
+        }
+    }
+}
+
+std::string StubCardProfileLibrary::getProfileName(const std::size_t index) const
+{
+    const std::size_t record = HEADER_SIZE + index * PROFILE_SIZE;
+
+    return std::string(reinterpret_cast<const char*>(mData) + readInt(record),
+                       readInt(record + 4));
+}
+
+uint32_t StubCardProfileLibrary::readInt(const std::size_t offset) const
+{
+    return static_cast<uint32_t>(mData[offset]) |
+           static_cast<uint32_t>(mData[offset + 1]) << 8 |
+           static_cast<uint32_t>(mData[offset + 2]) << 16 |
+           static_cast<uint32_t>(mData[offset + 3]) << 24;
+}
+
+void StubCardProfileLibrary::writeInt(std::string& out, const std::size_t value)
+{
+    out += static_cast<char>(value & 0xFF);
+    out += static_cast<char>((value >> 8) & 0xFF);
+    out += static_cast<char>((value >> 16) & 0xFF);
+    out += static_cast<char>((value >> 24) & 0xFF);
+}
+
+}
+}
+}
@@ -0,0 +1,264 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Keyple Core Util */
+#include "Pattern.h"
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+#include "StubApdu.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util::cpp;
+
+class StubSmartCard;
+
+/**
+ * Read-only library of card profiles compiled into a binary file, from which StubSmartCard
+ * instances are created without parsing nor validating their simulated commands again.
+ *
+ * <p>The file is mapped in memory rather than read, so that the processes loading the same
+ * library share a single copy of it in the page cache, and the cards created from a profile
+ * refer to the mapped data instead of copying it.
+ *
+ * <p>The file starts with a versioned header, followed by a table of the profiles sorted by name,
+ * a table of the commands and the data they refer to. The simulated commands made of plain
+ * hexadecimal digits are stored as bytes and found through a hash index built when the library is
+ * loaded; the others are regular expressions compiled once when the library is loaded, an invalid
+ * one throwing only when an APDU reaches it.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubCardProfileLibrary final
+: public std::enable_shared_from_this<StubCardProfileLibrary> {
+public:
+    /**
+     * Version of the file format written by compile().
+     *
+     * @since 2.2.0
+     */
+    static const uint32_t FORMAT_VERSION;
+
+    /**
+     * A profile of the library, shared by the cards created from it.
+     *
+     * @since 2.2.0
+     */
+    class KEYPLEPLUGINSTUB_API Profile final {
+    public:
+        /**
+         * (package-private)<br>
+         * Gets the power-on data of the profile.
+         *
+         * @since 2.2.0
+         */
+        std::vector<uint8_t> getPowerOnData() const;
+
+        /**
+         * (package-private)<br>
+         * Gets the protocol of the profile.
+         *
+         * @since 2.2.0
+         */
+        std::string getCardProtocol() const;
+
+        /**
+         * (package-private)<br>
+         * Looks for the response to an APDU, with the same rules as the simulated commands of a
+         * StubSmartCard.
+         *
+         * @param apduIn the APDU
+         * @param apduOut filled with the response if one is found
+         * @return true if a command of the profile matches the APDU
+         * @since 2.2.0
+         */
+        bool processApdu(const StubApdu& apduIn, StubApdu& apduOut) const;
+
+    private:
+        /**
+         *
+         */
+        friend class StubCardProfileLibrary;
+
+        /**
+         *
+         */
+        const StubCardProfileLibrary* mLibrary;
+
+        /**
+         * Offset of the profile record
+         */
+        std::size_t mRecord;
+
+        /**
+         * Open addressing hash index on the bytes of the plain commands, holding their index in
+         * the profile plus one. Power of two size, empty if no command is plain.
+         */
+        std::vector<uint32_t> mSlots;
+
+        /**
+         * Indexes in the profile of the regular expressions commands, in ascending order
+         */
+        std::vector<uint32_t> mRegexCommands;
+
+        /**
+         * Compiled regular expressions, in the order of mRegexCommands. nullptr for an invalid
+         * one, compiled again when reached to throw as a StubCommandTable does.
+         */
+        std::vector<std::shared_ptr<const Pattern>> mPatterns;
+
+        /**
+         * (private)<br>
+         * Gets the offset of the record of a command of the profile.
+         */
+        std::size_t getCommandRecord(const std::size_t command) const;
+    };
+
+    /**
+     * Compiles card profiles into a library file.
+     *
+     * @param profiles the cards defining the profiles, by profile name
+     * @param path path of the file to create
+     * @throw IllegalArgumentException if a card uses an APDU response provider or a compiled
+     *        profile, has an invalid response, or if the file cannot be written
+     * @since 2.2.0
+     */
+    static void compile(const std::map<std::string, std::shared_ptr<StubSmartCard>>& profiles,
+                        const std::string& path);
+
+    /**
+     * Maps a library file in memory.
+     *
+     * @param path path of the file
+     * @return the library
+     * @throw IllegalArgumentException if the file cannot be read or is not a valid library
+     * @since 2.2.0
+     */
+    static std::shared_ptr<const StubCardProfileLibrary> load(const std::string& path);
+
+    /**
+     * Unmaps the file.
+     *
+     * @since 2.2.0
+     */
+    ~StubCardProfileLibrary();
+
+    /**
+     * Gets the names of the profiles of the library, in ascending order.
+     *
+     * @since 2.2.0
+     */
+    std::vector<std::string> getProfileNames() const;
+
+    /**
+     * Gets a profile of the library, which keeps the library loaded as long as it is used.
+     *
+     * @param name name of the profile
+     * @return nullptr if the library has no such profile
+     * @since 2.2.0
+     */
+    std::shared_ptr<const Profile> getProfile(const std::string& name) const;
+
+private:
+    /**
+     * "KSCP"
+     */
+    static const uint32_t MAGIC;
+
+    /**
+     * Magic, version, profile count and command count
+     */
+    static const std::size_t HEADER_SIZE;
+
+    /**
+     * Offsets and lengths of the name, power-on data and protocol, first command and command count
+     */
+    static const std::size_t PROFILE_SIZE;
+
+    /**
+     * Kind, offset and length of the matcher, offset and length of the response
+     */
+    static const std::size_t COMMAND_SIZE;
+
+    /**
+     * Kinds of command matchers
+     */
+    static const uint32_t PLAIN_COMMAND;
+    static const uint32_t REGEX_COMMAND;
+
+    /**
+     *
+     */
+    const uint8_t* mData;
+
+    /**
+     *
+     */
+    std::size_t mSize;
+
+    /**
+     * Content of the file when it cannot be mapped
+     */
+    std::vector<uint8_t> mBuffer;
+
+    /**
+     * Profiles in the order of the file, i.e. by name
+     */
+    std::vector<Profile> mProfiles;
+
+    /**
+     *
+     */
+    StubCardProfileLibrary();
+
+    /**
+     * (private)<br>
+     * Checks the content of the file, indexes the plain commands and compiles the regular
+     * expressions.
+     *
+     * @throw IllegalArgumentException if the content is not valid
+     */
+    void open();
+
+    /**
+     * (private)<br>
+     * Gets the name of the profile at the provided index.
+     */
+    std::string getProfileName(const std::size_t index) const;
+
+    /**
+     * (private)<br>
+     * Reads the unsigned 32 bits little endian integer at the provided offset.
+     */
+    uint32_t readInt(const std::size_t offset) const;
+
+    /**
+     * (private)<br>
+     * Appends an unsigned 32 bits little endian integer.
+     */
+    static void writeInt(std::string& out, const std::size_t value);
+};
+
+}
+}
+}
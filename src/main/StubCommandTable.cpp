@@ -0,0 +1,260 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubCommandTable.h"
+
+#include <cstring>
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util;
+
+/* Marks an entry as not found */
+static const std::size_t NO_ENTRY = static_cast<std::size_t>(-1);
+
+struct StubCommandTable::Entry {
+    /**
+     * Bytes of a plain command, empty for a regular expression
+     */
+    uint32_t mMatcher;
+    uint32_t mMatcherLength;
+
+    /**
+     *
+     */
+    uint32_t mResponse;
+    uint32_t mResponseLength;
+
+    /**
+     * Strings as provided
+     */
+    uint32_t mCommand;
+    uint32_t mCommandLength;
+    uint32_t mHexResponse;
+    uint32_t mHexResponseLength;
+};
+
+StubCommandTable::StubCommandTable(const std::map<std::string, std::string>& hexCommands)
+: mEntryCount(hexCommands.size()), mSlotCount(0), mEntriesOffset(0)
+{
+    /* The bytes of the commands and responses, converted before being laid out */
+    std::vector<StubApdu> matchers;
+    std::vector<StubApdu> responses;
+    std::vector<bool> isPlains;
+    std::size_t plainCount = 0;
+    std::size_t hotSize = 0;
+    std::size_t coldSize = 0;
+
+    for (const auto& hexCommand : hexCommands) {
+        const std::string& command = hexCommand.first;
+        const bool isPlainCommand = isPlain(command);
+
+        matchers.push_back(StubApdu());
+        isPlains.push_back(isPlainCommand);
+        if (isPlainCommand) {
+            matchers.back().assignHex(command);
+            plainCount++;
+        } else {
+            mRegexEntries.push_back(static_cast<uint32_t>(matchers.size() - 1));
+
+            /* An invalid expression throws when reached, as it did when compiled on each call */
+            try {
+                mPatterns.push_back(Pattern::compile(command));
+            } catch (...) {
+                mPatterns.push_back(nullptr);
+            }
+        }
+
+        responses.push_back(StubApdu());
+        responses.back().assignHex(hexCommand.second);
+
+        hotSize += matchers.back().size() + responses.back().size();
+        coldSize += command.size() + hexCommand.second.size();
+    }
+
+    /* Half full at most, so that the probes stay short */
+    if (plainCount > 0) {
+        mSlotCount = 1;
+        while (mSlotCount < 2 * plainCount) {
+            mSlotCount *= 2;
+        }
+    }
+
+    mEntriesOffset = mSlotCount * sizeof(uint32_t);
+    const std::size_t dataOffset = mEntriesOffset + mEntryCount * sizeof(Entry);
+
+    mArena.reset(new uint8_t[dataOffset + hotSize + coldSize]);
+    std::memset(mArena.get(), 0, mEntriesOffset);
+
+    uint32_t* const slots = reinterpret_cast<uint32_t*>(mArena.get());
+    Entry* const entries = reinterpret_cast<Entry*>(mArena.get() + mEntriesOffset);
+    std::size_t hotOffset = dataOffset;
+    std::size_t coldOffset = dataOffset + hotSize;
+
+    const auto append = [this](std::size_t& offset,
+                               const uint8_t* data,
+                               const std::size_t size,
+                               uint32_t& entryOffset,
+                               uint32_t& entryLength) {
+        if (size > 0) {
+            std::memcpy(mArena.get() + offset, data, size);
+        }
+        entryOffset = static_cast<uint32_t>(offset);
+        entryLength = static_cast<uint32_t>(size);
+        offset += size;
+    };
+
+    std::size_t i = 0;
+    for (const auto& hexCommand : hexCommands) {
+        Entry& entry = entries[i];
+        append(hotOffset,
+               matchers[i].data(),
+               matchers[i].size(),
+               entry.mMatcher,
+               entry.mMatcherLength);
+        append(hotOffset,
+               responses[i].data(),
+               responses[i].size(),
+               entry.mResponse,
+               entry.mResponseLength);
+        append(coldOffset,
+               reinterpret_cast<const uint8_t*>(hexCommand.first.data()),
+               hexCommand.first.size(),
+               entry.mCommand,
+               entry.mCommandLength);
+        append(coldOffset,
+               reinterpret_cast<const uint8_t*>(hexCommand.second.data()),
+               hexCommand.second.size(),
+               entry.mHexResponse,
+               entry.mHexResponseLength);
+
+        if (isPlains[i]) {
+            std::size_t slot = hash(matchers[i].data(), matchers[i].size()) & (mSlotCount - 1);
+            while (slots[slot] != 0) {
+                slot = (slot + 1) & (mSlotCount - 1);
+            }
+            slots[slot] = static_cast<uint32_t>(i + 1);
+        }
+
+        i++;
+    }
+}
+
+std::size_t StubCommandTable::size() const
+{
+    return mEntryCount;
+}
+
+bool StubCommandTable::empty() const
+{
+    return mEntryCount == 0;
+}
+
+std::string StubCommandTable::getCommand(const std::size_t entry) const
+{
+    const Entry& command = getEntry(entry);
+
+    return std::string(reinterpret_cast<const char*>(mArena.get()) + command.mCommand,
+                       command.mCommandLength);
+}
+
+std::string StubCommandTable::getResponse(const std::size_t entry) const
+{
+    const Entry& command = getEntry(entry);
+
+    return std::string(reinterpret_cast<const char*>(mArena.get()) + command.mHexResponse,
+                       command.mHexResponseLength);
+}
+
+bool StubCommandTable::processApdu(const StubApdu& apduIn,
+                                   StubApdu& apduOut,
+                                   std::size_t& entry) const
+{
+    /* At most one plain command has the bytes of the APDU */
+    std::size_t match = NO_ENTRY;
+    if (mSlotCount > 0) {
+        const uint32_t* const slots = getSlots();
+        std::size_t slot = hash(apduIn.data(), apduIn.size()) & (mSlotCount - 1);
+        while (slots[slot] != 0) {
+            const Entry& command = getEntry(slots[slot] - 1);
+            if (command.mMatcherLength == apduIn.size() &&
+                std::memcmp(mArena.get() + command.mMatcher, apduIn.data(), apduIn.size()) == 0) {
+                match = slots[slot] - 1;
+                break;
+            }
+            slot = (slot + 1) & (mSlotCount - 1);
+        }
+    }
+
+    /* A regular expression sorted before the plain command takes precedence */
+    std::string hexApdu;
+    for (std::size_t i = 0; i < mRegexEntries.size() && mRegexEntries[i] < match; i++) {
+        if (hexApdu.empty()) {
+            hexApdu = apduIn.toHex();
+        }
+
+        const bool matches =
+            mPatterns[i] != nullptr
+                ? mPatterns[i]->matcher(hexApdu)->matches()
+                : Pattern::compile(getCommand(mRegexEntries[i]))->matcher(hexApdu)->matches();
+        if (matches) {
+            match = mRegexEntries[i];
+            break;
+        }
+    }
+
+    if (match == NO_ENTRY) {
+        return false;
+    }
+
+    const Entry& command = getEntry(match);
+    apduOut.assign(mArena.get() + command.mResponse, command.mResponseLength);
+    entry = match;
+
+    return true;
+}
+
+const StubCommandTable::Entry& StubCommandTable::getEntry(const std::size_t entry) const
+{
+    return reinterpret_cast<const Entry*>(mArena.get() + mEntriesOffset)[entry];
+}
+
+const uint32_t* StubCommandTable::getSlots() const
+{
+    return reinterpret_cast<const uint32_t*>(mArena.get());
+}
+
+bool StubCommandTable::isPlain(const std::string& command)
+{
+    return command.size() % 2 == 0 &&
+           command.find_first_not_of("0123456789ABCDEF") == std::string::npos;
+}
+
+std::size_t StubCommandTable::hash(const uint8_t* data, const std::size_t size)
+{
+    /* FNV-1a */
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+}
+}
+}
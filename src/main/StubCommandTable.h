@@ -0,0 +1,194 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Keyple Core Util */
+#include "Pattern.h"
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+#include "StubApdu.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util::cpp;
+
+/**
+ * (package-private)<br>
+ * Immutable table of the simulated commands of a card, shared by the copies of the card.
+ *
+ * <p>The entries, the command and response bytes and the original hexadecimal strings are laid
+ * out in a single arena, allocated and released at once. The data read by the lookups (hash index,
+ * entries, command and response bytes) comes first, the strings only used to describe or save the
+ * table last.
+ *
+ * <p>The commands made of plain upper case hexadecimal digits are found through an open
+ * addressing hash index on their bytes. The others are regular expressions on the hexadecimal form
+ * of the APDU, compiled once when the table is created and tried in the order of the commands, so
+ * that the first matching command in ascending order wins as with a map of regular expressions.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubCommandTable final {
+public:
+    /**
+     * (package-private)<br>
+     * Creates a table from simulated commands.
+     *
+     * @param hexCommands the responses by command, in hexadecimal or as regular expressions
+     * @since 2.2.0
+     */
+    explicit StubCommandTable(const std::map<std::string, std::string>& hexCommands);
+
+    /**
+     *
+     */
+    StubCommandTable(const StubCommandTable&) = delete;
+
+    /**
+     *
+     */
+    StubCommandTable& operator=(const StubCommandTable&) = delete;
+
+    /**
+     * (package-private)<br>
+     *
+     * @return the number of commands
+     * @since 2.2.0
+     */
+    std::size_t size() const;
+
+    /**
+     * (package-private)<br>
+     *
+     * @return true if the table has no command
+     * @since 2.2.0
+     */
+    bool empty() const;
+
+    /**
+     * (package-private)<br>
+     * Gets a command as it was provided.
+     *
+     * @param entry index of the command, in ascending order
+     * @return the command
+     * @since 2.2.0
+     */
+    std::string getCommand(const std::size_t entry) const;
+
+    /**
+     * (package-private)<br>
+     * Gets a response as it was provided.
+     *
+     * @param entry index of the command, in ascending order
+     * @return the response in hexadecimal
+     * @since 2.2.0
+     */
+    std::string getResponse(const std::size_t entry) const;
+
+    /**
+     * (package-private)<br>
+     * Looks for the response to an APDU.
+     *
+     * @param apduIn the APDU, not empty
+     * @param apduOut replaced by the response if one is found
+     * @param entry set to the index of the matching command if one is found
+     * @return true if a command matches the APDU
+     * @since 2.2.0
+     */
+    bool processApdu(const StubApdu& apduIn, StubApdu& apduOut, std::size_t& entry) const;
+
+    /**
+     * (package-private)<br>
+     * Tells if a command is looked up by its bytes rather than as a regular expression. Only the
+     * upper case hexadecimal digits can match the upper case form of an APDU.
+     *
+     * @param command the command as provided
+     * @return true if the command is made of an even number of upper case hexadecimal digits
+     * @since 2.2.0
+     */
+    static bool isPlain(const std::string& command);
+
+    /**
+     * (package-private)<br>
+     * Hashes the bytes of a plain command or of an APDU.
+     *
+     * @param data the bytes
+     * @param size the number of bytes
+     * @return the hash
+     * @since 2.2.0
+     */
+    static std::size_t hash(const uint8_t* data, const std::size_t size);
+
+private:
+    /**
+     * (private)<br>
+     * Offsets and lengths in the arena of the data of a command
+     */
+    struct Entry;
+
+    /**
+     * Hash index, entries, bytes and strings
+     */
+    std::unique_ptr<uint8_t[]> mArena;
+
+    /**
+     *
+     */
+    std::size_t mEntryCount;
+
+    /**
+     * Power of two, 0 if no command is plain
+     */
+    std::size_t mSlotCount;
+
+    /**
+     * Offset of the entries in the arena, after the slots of the hash index
+     */
+    std::size_t mEntriesOffset;
+
+    /**
+     * Indexes of the regular expressions commands, in ascending order
+     */
+    std::vector<uint32_t> mRegexEntries;
+
+    /**
+     * Compiled regular expressions, in the order of mRegexEntries. nullptr for an invalid one,
+     * compiled again when reached to throw as before.
+     */
+    std::vector<std::unique_ptr<Pattern>> mPatterns;
+
+    /**
+     * (private)<br>
+     * Gets the entry at the provided index.
+     */
+    const Entry& getEntry(const std::size_t entry) const;
+
+    /**
+     * (private)<br>
+     * Gets the slots of the hash index.
+     */
+    const uint32_t* getSlots() const;
+};
+
+}
+}
+}
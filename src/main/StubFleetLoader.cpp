@@ -0,0 +1,414 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubFleetLoader.h"
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+#include "IllegalArgumentException.h"
+#include "KeypleAssert.h"
+
+/* Keyple Plugin Stub */
+#include "StubPluginFactoryBuilder.h"
+#include "StubPoolPluginFactoryBuilder.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+
+std::shared_ptr<StubPluginFactory> StubFleetLoader::loadPluginFactory(const std::string& path,
+                                                                      const std::size_t parserCount)
+{
+    return parsePluginFactory(read(path), parserCount);
+}
+
+std::shared_ptr<StubPluginFactory> StubFleetLoader::parsePluginFactory(
+    const std::string& fleet, const std::size_t parserCount)
+{
+    const std::vector<Declaration> declarations = parse(fleet, parserCount);
+    const auto cards = buildCards(declarations);
+
+    auto builder = StubPluginFactoryBuilder::builder();
+
+    for (const auto& declaration : declarations) {
+        switch (declaration.mKeyword) {
+        case Keyword::MONITORING:
+            builder->withMonitoringCycleDuration(toNumber(declaration, 0));
+            break;
+        case Keyword::READER: {
+            const std::string& type = declaration.mFields[1];
+            if (type != "contact" && type != "contactless") {
+                throw IllegalArgumentException(
+                          formatError(declaration.mLine, "unknown reader type '" + type + "'"));
+            }
+            builder->withStubReader(declaration.mFields[0],
+                                    type == "contactless",
+                                    getCard(cards, declaration, 2));
+            break;
+        }
+        case Keyword::CARD:
+        case Keyword::COMMAND:
+            break;
+        default:
+            throw IllegalArgumentException(
+                      formatError(declaration.mLine, "not allowed in a stub plugin fleet"));
+        }
+    }
+
+    return builder->build();
+}
+
+std::shared_ptr<StubPoolPluginFactory> StubFleetLoader::loadPoolPluginFactory(
+    const std::string& path, const std::size_t parserCount)
+{
+    return parsePoolPluginFactory(read(path), parserCount);
+}
+
+std::shared_ptr<StubPoolPluginFactory> StubFleetLoader::parsePoolPluginFactory(
+    const std::string& fleet, const std::size_t parserCount)
+{
+    const std::vector<Declaration> declarations = parse(fleet, parserCount);
+    const auto cards = buildCards(declarations);
+
+    auto builder = StubPoolPluginFactoryBuilder::builder();
+
+    for (const auto& declaration : declarations) {
+        switch (declaration.mKeyword) {
+        case Keyword::MONITORING:
+            builder->withMonitoringCycleDuration(toNumber(declaration, 0));
+            break;
+        case Keyword::SHARDS:
+            builder->withShardCount(static_cast<std::size_t>(toNumber(declaration, 0)));
+            break;
+        case Keyword::POOL_READER:
+            builder->withStubReader(declaration.mFields[0],
+                                    declaration.mFields[1],
+                                    getCard(cards, declaration, 2));
+            break;
+        case Keyword::ELASTIC_GROUP:
+            builder->withElasticReaderGroup(declaration.mFields[0],
+                                            static_cast<std::size_t>(toNumber(declaration, 1)),
+                                            static_cast<std::size_t>(toNumber(declaration, 2)),
+                                            getCard(cards, declaration, 4),
+                                            toNumber(declaration, 3));
+            break;
+        case Keyword::CARD:
+        case Keyword::COMMAND:
+            break;
+        default:
+            throw IllegalArgumentException(
+                      formatError(declaration.mLine, "not allowed in a stub pool plugin fleet"));
+        }
+    }
+
+    return builder->build();
+}
+
+std::string StubFleetLoader::read(const std::string& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file) {
+        throw IllegalArgumentException("Unable to read the fleet file " + path);
+    }
+
+    std::ostringstream content;
+    content << file.rdbuf();
+
+    return content.str();
+}
+
+std::vector<StubFleetLoader::Declaration> StubFleetLoader::parse(const std::string& fleet,
+                                                                 const std::size_t parserCount)
+{
+    Assert::getInstance().greaterOrEqual(static_cast<int>(parserCount), 1, "parserCount");
+
+    const char* const data = fleet.data();
+    const std::size_t size = fleet.size();
+
+    /* Each part starts at the beginning of a line */
+    std::vector<const char*> bounds(1, data);
+    for (std::size_t i = 1; i < parserCount; i++) {
+        const char* bound = data + size * i / parserCount;
+        if (bound < bounds.back()) {
+            bound = bounds.back();
+        }
+        while (bound > data && bound < data + size && bound[-1] != '\n') {
+            bound++;
+        }
+        bounds.push_back(bound);
+    }
+    bounds.push_back(data + size);
+
+    std::vector<Part> parts(parserCount);
+    std::vector<std::thread> parsers;
+    for (std::size_t i = 1; i < parserCount; i++) {
+        parsers.push_back(std::thread(&StubFleetLoader::parsePart,
+                                      bounds[i],
+                                      bounds[i + 1],
+                                      std::ref(parts[i])));
+    }
+
+    parsePart(bounds[0], bounds[1], parts[0]);
+
+    for (auto& parser : parsers) {
+        parser.join();
+    }
+
+    /* Merge the parts in order, numbering their lines from the beginning of the description */
+    std::size_t declarationCount = 0;
+    for (const auto& part : parts) {
+        declarationCount += part.mDeclarations.size();
+    }
+
+    std::vector<Declaration> declarations;
+    declarations.reserve(declarationCount);
+
+    std::size_t firstLine = 0;
+    for (auto& part : parts) {
+        if (!part.mError.empty()) {
+            throw IllegalArgumentException(formatError(firstLine + part.mErrorLine, part.mError));
+        }
+
+        for (auto& declaration : part.mDeclarations) {
+            declaration.mLine += firstLine;
+            declarations.push_back(std::move(declaration));
+        }
+
+        firstLine += part.mLineCount;
+    }
+
+    return declarations;
+}
+
+void StubFleetLoader::parsePart(const char* begin, const char* end, Part& part)
+{
+    /* Keywords and their minimum and maximum numbers of fields */
+    static const struct {
+        const char* mName;
+        Keyword mKeyword;
+        std::size_t mMinFields;
+        std::size_t mMaxFields;
+    } keywords[] = {
+        {"monitoring", Keyword::MONITORING, 1, 1},
+        {"shards", Keyword::SHARDS, 1, 1},
+        {"card", Keyword::CARD, 3, 3},
+        {"command", Keyword::COMMAND, 3, 3},
+        {"reader", Keyword::READER, 2, 3},
+        {"poolreader", Keyword::POOL_READER, 2, 3},
+        {"elasticgroup", Keyword::ELASTIC_GROUP, 4, 5}
+    };
+
+    std::vector<std::string> fields;
+    const char* current = begin;
+
+    while (current < end) {
+        part.mLineCount++;
+
+        /* Split the line into fields, up to the end of line or a comment */
+        fields.clear();
+        while (current < end && *current != '\n') {
+            if (*current == ' ' || *current == '\t' || *current == '\r') {
+                current++;
+            } else if (*current == '#') {
+                while (current < end && *current != '\n') {
+                    current++;
+                }
+            } else {
+                const char* const field = current;
+                while (current < end &&
+                       *current != ' ' &&
+                       *current != '\t' &&
+                       *current != '\r' &&
+                       *current != '\n' &&
+                       *current != '#') {
+                    current++;
+                }
+                fields.emplace_back(field, current);
+            }
+        }
+
+        /* Skip the end of line */
+        if (current < end) {
+            current++;
+        }
+
+        if (fields.empty()) {
+            continue;
+        }
+
+        bool found = false;
+        for (const auto& keyword : keywords) {
+            if (fields[0] != keyword.mName) {
+                continue;
+            }
+
+            found = true;
+
+            if (fields.size() - 1 < keyword.mMinFields || fields.size() - 1 > keyword.mMaxFields) {
+                part.mError = "wrong number of fields for '" + fields[0] + "'";
+                part.mErrorLine = part.mLineCount;
+                return;
+            }
+
+            Declaration declaration;
+            declaration.mKeyword = keyword.mKeyword;
+            declaration.mLine = part.mLineCount;
+            declaration.mFields.assign(std::make_move_iterator(fields.begin() + 1),
+                                       std::make_move_iterator(fields.end()));
+            part.mDeclarations.push_back(std::move(declaration));
+            break;
+        }
+
+        if (!found) {
+            part.mError = "unknown keyword '" + fields[0] + "'";
+            part.mErrorLine = part.mLineCount;
+            return;
+        }
+    }
+}
+
+std::map<std::string, std::shared_ptr<StubSmartCard>> StubFleetLoader::buildCards(
+    const std::vector<Declaration>& declarations)
+{
+    struct Profile {
+        const Declaration* mDeclaration;
+        std::map<std::string, std::string> mHexCommands;
+    };
+
+    std::map<std::string, Profile> profiles;
+
+    for (const auto& declaration : declarations) {
+        if (declaration.mKeyword != Keyword::CARD) {
+            continue;
+        }
+
+        if (!HexUtil::isValid(declaration.mFields[1])) {
+            throw IllegalArgumentException(
+                      formatError(declaration.mLine, "invalid power-on data"));
+        }
+
+        if (!profiles.insert({declaration.mFields[0], {&declaration, {}}}).second) {
+            throw IllegalArgumentException(
+                      formatError(declaration.mLine,
+                                  "card profile '" + declaration.mFields[0] + "' already defined"));
+        }
+    }
+
+    for (const auto& declaration : declarations) {
+        if (declaration.mKeyword != Keyword::COMMAND) {
+            continue;
+        }
+
+        const auto profile = profiles.find(declaration.mFields[0]);
+        if (profile == profiles.end()) {
+            throw IllegalArgumentException(
+                      formatError(declaration.mLine,
+                                  "unknown card profile '" + declaration.mFields[0] + "'"));
+        }
+
+        /* Like StubSmartCard::Builder, the first response of a command wins */
+        profile->second.mHexCommands.insert({declaration.mFields[1], declaration.mFields[2]});
+    }
+
+    /* Identical profiles are built once, whatever their name */
+    std::map<std::string, std::shared_ptr<StubSmartCard>> cardsByContent;
+    std::map<std::string, std::shared_ptr<StubSmartCard>> cards;
+
+    for (const auto& profile : profiles) {
+        const std::vector<std::string>& fields = profile.second.mDeclaration->mFields;
+
+        std::string content = fields[1] + '\n' + fields[2];
+        for (const auto& hexCommand : profile.second.mHexCommands) {
+            content += '\n' + hexCommand.first + '\n' + hexCommand.second;
+        }
+
+        std::shared_ptr<StubSmartCard>& card = cardsByContent[content];
+        if (card == nullptr) {
+            const auto builder = StubSmartCard::builder();
+            StubSmartCard::CommandStep& commandStep =
+                builder->withPowerOnData(HexUtil::toByteArray(fields[1])).withProtocol(fields[2]);
+
+            StubSmartCard::SimulatedCommandStep* simulatedCommandStep = nullptr;
+            for (const auto& hexCommand : profile.second.mHexCommands) {
+                simulatedCommandStep =
+                    simulatedCommandStep == nullptr ?
+                        &commandStep.withSimulatedCommand(hexCommand.first, hexCommand.second) :
+                        &simulatedCommandStep->withSimulatedCommand(hexCommand.first,
+                                                                    hexCommand.second);
+            }
+
+            card = simulatedCommandStep == nullptr ? commandStep.build() :
+                                                     simulatedCommandStep->build();
+        }
+
+        cards.insert({profile.first, card});
+    }
+
+    return cards;
+}
+
+std::shared_ptr<StubSmartCard> StubFleetLoader::getCard(
+    const std::map<std::string, std::shared_ptr<StubSmartCard>>& cards,
+    const Declaration& declaration,
+    const std::size_t index)
+{
+    if (declaration.mFields.size() <= index) {
+        return nullptr;
+    }
+
+    const auto card = cards.find(declaration.mFields[index]);
+    if (card == cards.end()) {
+        throw IllegalArgumentException(
+                  formatError(declaration.mLine,
+                              "unknown card profile '" + declaration.mFields[index] + "'"));
+    }
+
+    /* Each reader gets its own card, sharing the simulated commands of the profile */
+    return card->second->copy();
+}
+
+int StubFleetLoader::toNumber(const Declaration& declaration, const std::size_t index)
+{
+    const std::string& field = declaration.mFields[index];
+
+    long number = 0;
+    for (const char c : field) {
+        if (c < '0' || c > '9' || number > 0x7FFFFFFF / 10) {
+            throw IllegalArgumentException(
+                      formatError(declaration.mLine, "invalid number '" + field + "'"));
+        }
+        number = number * 10 + (c - '0');
+    }
+
+    if (number > 0x7FFFFFFF) {
+        throw IllegalArgumentException(
+                  formatError(declaration.mLine, "invalid number '" + field + "'"));
+    }
+
+    return static_cast<int>(number);
+}
+
+std::string StubFleetLoader::formatError(const std::size_t line, const std::string& message)
+{
+    return "Invalid fleet description, line " + std::to_string(line) + ": " + message;
+}
+
+}
+}
+}
@@ -0,0 +1,233 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+#include "StubPluginFactory.h"
+#include "StubPoolPluginFactory.h"
+#include "StubSmartCard.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+/**
+ * Builds the plugin factories from a fleet description, so that the readers and cards of a test
+ * bench can be changed without recompiling it.
+ *
+ * <p>The description is a text with one declaration per line, made of fields separated by spaces
+ * or tabs. Empty lines and text following a '#' are ignored.
+ *
+ * <pre>
+ * monitoring &lt;duration&gt;
+ * shards &lt;count&gt;
+ * card &lt;profile&gt; &lt;powerOnDataHex&gt; &lt;protocol&gt;
+ * command &lt;profile&gt; &lt;commandHex&gt; &lt;responseHex&gt;
+ * reader &lt;name&gt; contact|contactless [&lt;profile&gt;]
+ * poolreader &lt;groupReference&gt; &lt;name&gt; [&lt;profile&gt;]
+ * elasticgroup &lt;groupReference&gt; &lt;minSize&gt; &lt;maxSize&gt; &lt;idleCooldown&gt;
+ *              [&lt;profile&gt;]
+ * </pre>
+ *
+ * <p>A card profile is used by any number of readers, each reader getting its own card. Profiles
+ * are deduplicated: all the cards of identical profiles share a single set of simulated commands,
+ * whatever the name of the profile. The declarations may appear in any order.
+ *
+ * <p>'reader' declarations are only allowed when loading a StubPluginFactory; 'shards',
+ * 'poolreader' and 'elasticgroup' declarations only when loading a StubPoolPluginFactory.
+ *
+ * <p>Large descriptions can be parsed by several threads, each one handling a part of the text.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubFleetLoader final {
+public:
+    /**
+     * Builds a StubPluginFactory from a fleet description file.
+     *
+     * @param path path of the file
+     * @param parserCount number of threads parsing the description (at least 1)
+     * @return a new factory
+     * @throw IllegalArgumentException if the file cannot be read or is not a valid description
+     * @since 2.2.0
+     */
+    static std::shared_ptr<StubPluginFactory> loadPluginFactory(const std::string& path,
+                                                                const std::size_t parserCount = 1);
+
+    /**
+     * Builds a StubPluginFactory from a fleet description.
+     *
+     * @param fleet the description
+     * @param parserCount number of threads parsing the description (at least 1)
+     * @return a new factory
+     * @throw IllegalArgumentException if the description is not valid
+     * @since 2.2.0
+     */
+    static std::shared_ptr<StubPluginFactory> parsePluginFactory(const std::string& fleet,
+                                                                 const std::size_t parserCount = 1);
+
+    /**
+     * Builds a StubPoolPluginFactory from a fleet description file.
+     *
+     * @param path path of the file
+     * @param parserCount number of threads parsing the description (at least 1)
+     * @return a new factory
+     * @throw IllegalArgumentException if the file cannot be read or is not a valid description
+     * @since 2.2.0
+     */
+    static std::shared_ptr<StubPoolPluginFactory> loadPoolPluginFactory(
+        const std::string& path, const std::size_t parserCount = 1);
+
+    /**
+     * Builds a StubPoolPluginFactory from a fleet description.
+     *
+     * @param fleet the description
+     * @param parserCount number of threads parsing the description (at least 1)
+     * @return a new factory
+     * @throw IllegalArgumentException if the description is not valid
+     * @since 2.2.0
+     */
+    static std::shared_ptr<StubPoolPluginFactory> parsePoolPluginFactory(
+        const std::string& fleet, const std::size_t parserCount = 1);
+
+private:
+    /**
+     *
+     */
+    enum class Keyword {
+        MONITORING,
+        SHARDS,
+        CARD,
+        COMMAND,
+        READER,
+        POOL_READER,
+        ELASTIC_GROUP
+    };
+
+    /**
+     * A declaration of the description
+     */
+    struct Declaration {
+        /**
+         *
+         */
+        Keyword mKeyword;
+
+        /**
+         * Line number, starting from 1
+         */
+        std::size_t mLine;
+
+        /**
+         * Fields following the keyword
+         */
+        std::vector<std::string> mFields;
+    };
+
+    /**
+     * Result of the parsing of a part of the description
+     */
+    struct Part {
+        /**
+         *
+         */
+        std::vector<Declaration> mDeclarations;
+
+        /**
+         * Number of lines of the part
+         */
+        std::size_t mLineCount = 0;
+
+        /**
+         * Error found in the part, empty if none
+         */
+        std::string mError;
+
+        /**
+         * Line of the error, relative to the part
+         */
+        std::size_t mErrorLine = 0;
+    };
+
+    /**
+     *
+     */
+    StubFleetLoader() {}
+
+    /**
+     * (private)<br>
+     * Reads a whole file.
+     */
+    static std::string read(const std::string& path);
+
+    /**
+     * (private)<br>
+     * Splits the description into declarations, using parserCount threads.
+     *
+     * @throw IllegalArgumentException if a line is not valid
+     */
+    static std::vector<Declaration> parse(const std::string& fleet, const std::size_t parserCount);
+
+    /**
+     * (private)<br>
+     * Parses the lines of the description found between begin and end.
+     */
+    static void parsePart(const char* begin, const char* end, Part& part);
+
+    /**
+     * (private)<br>
+     * Builds a card for each profile of the description, identical profiles sharing the same
+     * card.
+     *
+     * @throw IllegalArgumentException if a profile is not valid
+     */
+    static std::map<std::string, std::shared_ptr<StubSmartCard>> buildCards(
+        const std::vector<Declaration>& declarations);
+
+    /**
+     * (private)<br>
+     * Returns a new card for the profile named by the optional field at the provided index,
+     * nullptr if there is no such field.
+     *
+     * @throw IllegalArgumentException if the profile is unknown
+     */
+    static std::shared_ptr<StubSmartCard> getCard(
+        const std::map<std::string, std::shared_ptr<StubSmartCard>>& cards,
+        const Declaration& declaration,
+        const std::size_t index);
+
+    /**
+     * (private)<br>
+     * Converts a field into a positive number.
+     *
+     * @throw IllegalArgumentException if the field is not a number
+     */
+    static int toNumber(const Declaration& declaration, const std::size_t index);
+
+    /**
+     * (private)<br>
+     * Formats the message of an error found at the provided line.
+     */
+    static std::string formatError(const std::size_t line, const std::string& message);
+};
+
+}
+}
+}
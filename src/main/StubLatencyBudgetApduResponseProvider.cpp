@@ -0,0 +1,138 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubLatencyBudgetApduResponseProvider.h"
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+#include "KeypleAssert.h"
+
+/* Keyple Plugin Stub */
+#include "StubMetrics.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util;
+
+static const uint64_t NANOSECONDS_PER_MICROSECOND = 1000;
+static const uint64_t NANOSECONDS_PER_MILLISECOND = 1000000;
+
+const std::unique_ptr<Logger> StubLatencyBudgetApduResponseProvider::mLogger =
+    LoggerFactory::getLogger(typeid(StubLatencyBudgetApduResponseProvider));
+
+StubLatencyBudgetApduResponseProvider::StubLatencyBudgetApduResponseProvider(
+    const std::shared_ptr<ApduResponseProviderSpi> apduResponseProvider,
+    const int latencyBudget,
+    const std::string& failFastStatusWord,
+    const int reportSamplingRate,
+    const int reportInterval)
+: mApduResponseProvider(apduResponseProvider),
+  mLatencyBudget(static_cast<uint64_t>(latencyBudget) * NANOSECONDS_PER_MICROSECOND),
+  mFailFastStatusWord(failFastStatusWord),
+  mReportSamplingRate(static_cast<uint64_t>(reportSamplingRate)),
+  mReportInterval(static_cast<uint64_t>(reportInterval) * NANOSECONDS_PER_MILLISECOND),
+  mCallCount(0),
+  mOverBudgetCount(0),
+  mReportCount(0),
+  mMaxLatency(0),
+  mNextReportTime(0)
+{
+    Assert::getInstance().notNull(apduResponseProvider, "apduResponseProvider")
+                         .greaterOrEqual(latencyBudget, 1, "latencyBudget")
+                         .greaterOrEqual(reportSamplingRate, 1, "reportSamplingRate")
+                         .greaterOrEqual(reportInterval, 0, "reportInterval")
+                         .isTrue(failFastStatusWord.empty() ||
+                                 (failFastStatusWord.size() == 4 &&
+                                  HexUtil::isValid(failFastStatusWord)),
+                                 "failFastStatusWord");
+}
+
+const std::string StubLatencyBudgetApduResponseProvider::getResponseFromRequest(
+    const std::string& apduRequest)
+{
+    const uint64_t start = StubMetrics::now();
+    const std::string response = mApduResponseProvider->getResponseFromRequest(apduRequest);
+    const uint64_t end = StubMetrics::now();
+
+    const uint64_t latency = end - start;
+    mCallCount.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t maxLatency = mMaxLatency.load(std::memory_order_relaxed);
+    while (latency > maxLatency &&
+           !mMaxLatency.compare_exchange_weak(maxLatency, latency, std::memory_order_relaxed)) {}
+
+    if (latency <= mLatencyBudget) {
+        return response;
+    }
+
+    onOverBudget(apduRequest, latency, end);
+
+    /* The late response is discarded */
+    return mFailFastStatusWord.empty() ? response : mFailFastStatusWord;
+}
+
+uint64_t StubLatencyBudgetApduResponseProvider::getCallCount() const
+{
+    return mCallCount.load(std::memory_order_relaxed);
+}
+
+uint64_t StubLatencyBudgetApduResponseProvider::getOverBudgetCount() const
+{
+    return mOverBudgetCount.load(std::memory_order_relaxed);
+}
+
+uint64_t StubLatencyBudgetApduResponseProvider::getReportCount() const
+{
+    return mReportCount.load(std::memory_order_relaxed);
+}
+
+uint64_t StubLatencyBudgetApduResponseProvider::getMaxLatency() const
+{
+    return mMaxLatency.load(std::memory_order_relaxed);
+}
+
+void StubLatencyBudgetApduResponseProvider::onOverBudget(const std::string& apduRequest,
+                                                         const uint64_t latency,
+                                                         const uint64_t end)
+{
+    const uint64_t overBudgetCount =
+        mOverBudgetCount.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    /* Sampled: the first over budget call, then one out of mReportSamplingRate */
+    if ((overBudgetCount - 1) % mReportSamplingRate != 0) {
+        return;
+    }
+
+    /* Rate limited: a single caller claims the next report */
+    uint64_t nextReportTime = mNextReportTime.load(std::memory_order_relaxed);
+    if (end < nextReportTime ||
+        !mNextReportTime.compare_exchange_strong(nextReportTime,
+                                                 end + mReportInterval,
+                                                 std::memory_order_relaxed)) {
+        return;
+    }
+
+    mReportCount.fetch_add(1, std::memory_order_relaxed);
+
+    mLogger->warn("APDU response provider call took % us, over the budget of % us "
+                  "(% over budget calls so far), request: %\n",
+                  latency / NANOSECONDS_PER_MICROSECOND,
+                  mLatencyBudget / NANOSECONDS_PER_MICROSECOND,
+                  overBudgetCount,
+                  apduRequest);
+}
+
+}
+}
+}
@@ -0,0 +1,174 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/* Keyple Core Util */
+#include "LoggerFactory.h"
+
+/* Keyple Plugin Stub */
+#include "ApduResponseProviderSpi.h"
+#include "KeyplePluginStubExport.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util::cpp;
+using namespace keyple::plugin::stub::spi;
+
+/**
+ * APDU response provider watching the latency of another provider against a budget.
+ *
+ * <p>Each call is timed with a monotonic clock, without any additional thread. A call exceeding
+ * the budget is counted and reported as a warning with its request. Only one over budget call out
+ * of reportSamplingRate is reported, and at most one report per reportInterval, the others are
+ * only counted.
+ *
+ * <p>When a fail fast status word is set, the response of a call exceeding the budget is discarded
+ * and the status word is returned in its place, so that the card answers as a card which failed
+ * instead of carrying on with a late response.
+ *
+ * <p>To set a budget for a card, pass it to StubSmartCard::Builder::withApduResponseProvider() in
+ * place of the provider it wraps. The copies of the card share its budget and counters.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubLatencyBudgetApduResponseProvider final
+: public ApduResponseProviderSpi {
+public:
+    /**
+     * Watches the calls to a provider.
+     *
+     * @param apduResponseProvider the provider
+     * @param latencyBudget maximum duration of a call, in microseconds
+     * @param failFastStatusWord status word returned in place of the response of a call exceeding
+     *        the budget, as 4 hexadecimal digits, empty to keep the response
+     * @param reportSamplingRate one over budget call out of this number is reported
+     * @param reportInterval minimum time between two reports, in milliseconds
+     * @throw IllegalArgumentException if the provider is null, the budget or the sampling rate is
+     *        not strictly positive, the interval is negative or the status word is not valid
+     * @since 2.2.0
+     */
+    StubLatencyBudgetApduResponseProvider(
+        const std::shared_ptr<ApduResponseProviderSpi> apduResponseProvider,
+        const int latencyBudget,
+        const std::string& failFastStatusWord = "",
+        const int reportSamplingRate = 1,
+        const int reportInterval = 1000);
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    const std::string getResponseFromRequest(const std::string& apduRequest) override;
+
+    /**
+     * Gets the number of calls to the provider.
+     *
+     * @since 2.2.0
+     */
+    uint64_t getCallCount() const;
+
+    /**
+     * Gets the number of calls which exceeded the budget.
+     *
+     * @since 2.2.0
+     */
+    uint64_t getOverBudgetCount() const;
+
+    /**
+     * Gets the number of over budget calls which were reported.
+     *
+     * @since 2.2.0
+     */
+    uint64_t getReportCount() const;
+
+    /**
+     * Gets the longest duration of a call, in nanoseconds.
+     *
+     * @since 2.2.0
+     */
+    uint64_t getMaxLatency() const;
+
+private:
+    /**
+     *
+     */
+    static const std::unique_ptr<Logger> mLogger;
+
+    /**
+     *
+     */
+    const std::shared_ptr<ApduResponseProviderSpi> mApduResponseProvider;
+
+    /**
+     * In nanoseconds
+     */
+    const uint64_t mLatencyBudget;
+
+    /**
+     *
+     */
+    const std::string mFailFastStatusWord;
+
+    /**
+     *
+     */
+    const uint64_t mReportSamplingRate;
+
+    /**
+     * In nanoseconds
+     */
+    const uint64_t mReportInterval;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mCallCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mOverBudgetCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mReportCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mMaxLatency;
+
+    /**
+     * Monotonic time in nanoseconds before which no report is made
+     */
+    std::atomic<uint64_t> mNextReportTime;
+
+    /**
+     * (private)<br>
+     * Counts a call exceeding the budget, and reports it if sampled and not rate limited.
+     */
+    void onOverBudget(const std::string& apduRequest, const uint64_t latency, const uint64_t end);
+};
+
+}
+}
+}
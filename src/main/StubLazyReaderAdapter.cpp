@@ -0,0 +1,165 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubLazyReaderAdapter.h"
+
+/* Keyple Plugin Stub */
+#include "StubPluginAdapter.h"
+
+/* Keyple Core Util */
+#include "IllegalStateException.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util::cpp::exception;
+
+StubLazyReaderAdapter::StubLazyReaderAdapter(
+  std::weak_ptr<StubPluginAdapter> plugin,
+  std::shared_ptr<StubPluginFactoryAdapter::StubReaderConfiguration> configuration)
+: mPlugin(plugin), mConfiguration(configuration) {}
+
+void StubLazyReaderAdapter::onStartDetection()
+{
+    getReader().onStartDetection();
+}
+
+void StubLazyReaderAdapter::onStopDetection()
+{
+    getReader().onStopDetection();
+}
+
+const std::string& StubLazyReaderAdapter::getName() const
+{
+    return mConfiguration->getName();
+}
+
+bool StubLazyReaderAdapter::isProtocolSupported(const std::string& readerProtocol) const
+{
+    return getReader().isProtocolSupported(readerProtocol);
+}
+
+void StubLazyReaderAdapter::activateProtocol(const std::string& readerProtocol)
+{
+    getReader().activateProtocol(readerProtocol);
+}
+
+void StubLazyReaderAdapter::deactivateProtocol(const std::string& readerProtocol)
+{
+    getReader().deactivateProtocol(readerProtocol);
+}
+
+bool StubLazyReaderAdapter::isCurrentProtocol(const std::string& readerProtocol) const
+{
+    return getReader().isCurrentProtocol(readerProtocol);
+}
+
+void StubLazyReaderAdapter::openPhysicalChannel()
+{
+    getReader().openPhysicalChannel();
+}
+
+void StubLazyReaderAdapter::closePhysicalChannel()
+{
+    getReader().closePhysicalChannel();
+}
+
+bool StubLazyReaderAdapter::isPhysicalChannelOpen() const
+{
+    return getReader().isPhysicalChannelOpen();
+}
+
+bool StubLazyReaderAdapter::checkCardPresence()
+{
+    return getReader().checkCardPresence();
+}
+
+const std::string StubLazyReaderAdapter::getPowerOnData() const
+{
+    return getReader().getPowerOnData();
+}
+
+const std::vector<uint8_t> StubLazyReaderAdapter::transmitApdu(const std::vector<uint8_t>& apduIn)
+{
+    return getReader().transmitApdu(apduIn);
+}
+
+bool StubLazyReaderAdapter::isContactless()
+{
+    return mConfiguration->getContactless();
+}
+
+void StubLazyReaderAdapter::onUnregister()
+{
+    /* NO-OP, as for the reader */
+}
+
+void StubLazyReaderAdapter::insertCard(std::shared_ptr<StubSmartCard> smartCard)
+{
+    getReader().insertCard(smartCard);
+}
+
+void StubLazyReaderAdapter::removeCard()
+{
+    getReader().removeCard();
+}
+
+std::shared_ptr<StubSmartCard> StubLazyReaderAdapter::getSmartcard()
+{
+    return getReader().getSmartcard();
+}
+
+void StubLazyReaderAdapter::waitForCardRemovalDuringProcessing()
+{
+    getReader().waitForCardRemovalDuringProcessing();
+}
+
+void StubLazyReaderAdapter::stopWaitForCardRemovalDuringProcessing()
+{
+    getReader().stopWaitForCardRemovalDuringProcessing();
+}
+
+const StubMetrics::ReaderMetrics StubLazyReaderAdapter::getMetrics() const
+{
+    return getReader().getMetrics();
+}
+
+void StubLazyReaderAdapter::resetMetrics()
+{
+    getReader().resetMetrics();
+}
+
+StubReaderAdapter& StubLazyReaderAdapter::getReader() const
+{
+    /* An exception leaves the flag unset, the creation is then retried on next call */
+    std::call_once(mReaderCreated, [this] {
+        const std::shared_ptr<StubPluginAdapter> plugin = mPlugin.lock();
+        if (plugin == nullptr) {
+            throw IllegalStateException("The plugin of the reader " + mConfiguration->getName() +
+                                        " has been released");
+        }
+
+        mReader = plugin->materializeReader(mConfiguration->getName());
+    });
+
+    if (mReader == nullptr) {
+        throw IllegalStateException("The reader " + mConfiguration->getName() +
+                                    " has been unplugged");
+    }
+
+    return *mReader;
+}
+
+}
+}
+}
@@ -0,0 +1,263 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Keyple Core Plugin */
+#include "ConfigurableReaderSpi.h"
+#include "ObservableReaderSpi.h"
+#include "WaitForCardInsertionNonBlockingSpi.h"
+#include "WaitForCardRemovalDuringProcessingBlockingSpi.h"
+#include "WaitForCardRemovalNonBlockingSpi.h"
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+#include "StubPluginFactoryAdapter.h"
+#include "StubReader.h"
+#include "StubReaderAdapter.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::plugin::spi::reader;
+using namespace keyple::core::plugin::spi::reader::observable;
+using namespace keyple::core::plugin::spi::reader::observable::state::insertion;
+using namespace keyple::core::plugin::spi::reader::observable::state::processing;
+using namespace keyple::core::plugin::spi::reader::observable::state::removal;
+
+class StubPluginAdapter;
+
+/**
+ * (package-private)<br>
+ * Stands for a configured reader of a lazy StubPluginAdapter not created yet, so that listing the
+ * readers, as the core does when registering the plugin, creates none of them.
+ *
+ * <p>The name and the kind of the reader are answered from its configuration. Any other call
+ * creates the reader through the plugin, once, and is forwarded to it. The proxy only holds a weak
+ * reference to the plugin, as the core may keep a reader after the plugin has been released.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubLazyReaderAdapter final
+: public StubReader,
+  public ConfigurableReaderSpi,
+  public ObservableReaderSpi,
+  public WaitForCardInsertionNonBlockingSpi,
+  public WaitForCardRemovalDuringProcessingBlockingSpi,
+  public WaitForCardRemovalNonBlockingSpi {
+public:
+    /**
+     * (package-private)<br>
+     *
+     * @param plugin the plugin creating the reader
+     * @param configuration the configuration of the reader
+     * @since 2.2.0
+     */
+    StubLazyReaderAdapter(
+        std::weak_ptr<StubPluginAdapter> plugin,
+        std::shared_ptr<StubPluginFactoryAdapter::StubReaderConfiguration> configuration);
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void onStartDetection() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void onStopDetection() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    const std::string& getName() const override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    bool isProtocolSupported(const std::string& readerProtocol) const override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void activateProtocol(const std::string& readerProtocol) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void deactivateProtocol(const std::string& readerProtocol) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    bool isCurrentProtocol(const std::string& readerProtocol) const override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void openPhysicalChannel() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void closePhysicalChannel() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    bool isPhysicalChannelOpen() const override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    bool checkCardPresence() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    const std::string getPowerOnData() const override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    const std::vector<uint8_t> transmitApdu(const std::vector<uint8_t>& apduIn) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    bool isContactless() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void onUnregister() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void insertCard(std::shared_ptr<StubSmartCard> smartCard) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void removeCard() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    std::shared_ptr<StubSmartCard> getSmartcard() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void waitForCardRemovalDuringProcessing() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void stopWaitForCardRemovalDuringProcessing() override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    const StubMetrics::ReaderMetrics getMetrics() const override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void resetMetrics() override;
+
+private:
+    /**
+     * Only needed to create the reader
+     */
+    const std::weak_ptr<StubPluginAdapter> mPlugin;
+
+    /**
+     *
+     */
+    const std::shared_ptr<StubPluginFactoryAdapter::StubReaderConfiguration> mConfiguration;
+
+    /**
+     * Guards the creation of mReader
+     */
+    mutable std::once_flag mReaderCreated;
+
+    /**
+     * The created reader, only accessed once mReaderCreated is set
+     */
+    mutable std::shared_ptr<StubReaderAdapter> mReader;
+
+    /**
+     * (private)<br>
+     * Gets the reader, created on first call.
+     *
+     * @return the reader
+     * @throw IllegalStateException if the reader has been unplugged, or the plugin released,
+     *        before the reader has been created
+     */
+    StubReaderAdapter& getReader() const;
+};
+
+}
+}
+}
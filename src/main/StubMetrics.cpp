@@ -0,0 +1,371 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubMetrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+const std::size_t StubMetrics::SHARD_COUNT;
+
+/* Buckets of the histograms: 8 sub-buckets (3 bits) per power of two, up to 2^40 */
+static const std::size_t SUB_BUCKET_BITS = 3;
+static const std::size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+static const std::size_t MAX_VALUE_BITS = 40;
+static const std::size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+/* Size of a cache line, separating the blocks of the shards */
+static const std::size_t CACHE_LINE_SIZE = 64;
+
+static std::size_t getBucket(const uint64_t value)
+{
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<std::size_t>(value);
+    }
+
+    if (value >> MAX_VALUE_BITS != 0) {
+        return BUCKET_COUNT - 1;
+    }
+
+    /* Highest bit set, found by halves */
+    std::size_t highestBit = 0;
+    for (std::size_t shift = 32; shift > 0; shift /= 2) {
+        if (value >> (highestBit + shift) != 0) {
+            highestBit += shift;
+        }
+    }
+
+    const std::size_t exponent = highestBit - SUB_BUCKET_BITS;
+
+    return (exponent + 1) * SUB_BUCKET_COUNT +
+           static_cast<std::size_t>((value >> exponent) - SUB_BUCKET_COUNT);
+}
+
+static uint64_t getBucketHighestValue(const std::size_t bucket)
+{
+    if (bucket < SUB_BUCKET_COUNT) {
+        return bucket;
+    }
+
+    const std::size_t exponent = bucket / SUB_BUCKET_COUNT - 1;
+    const uint64_t lowestValue =
+        static_cast<uint64_t>(SUB_BUCKET_COUNT + bucket % SUB_BUCKET_COUNT) << exponent;
+
+    return lowestValue + (static_cast<uint64_t>(1) << exponent) - 1;
+}
+
+/* HISTOGRAM ------------------------------------------------------------------------------------ */
+
+StubMetrics::Histogram::Histogram() : mBuckets(BUCKET_COUNT, 0), mCount(0), mSum(0), mMax(0) {}
+
+void StubMetrics::Histogram::record(const uint64_t value)
+{
+    mBuckets[getBucket(value)]++;
+    mCount++;
+    mSum += value;
+    mMax = std::max(mMax, value);
+}
+
+void StubMetrics::Histogram::merge(const Histogram& other)
+{
+    for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+        mBuckets[i] += other.mBuckets[i];
+    }
+
+    mCount += other.mCount;
+    mSum += other.mSum;
+    mMax = std::max(mMax, other.mMax);
+}
+
+uint64_t StubMetrics::Histogram::getCount() const
+{
+    return mCount;
+}
+
+uint64_t StubMetrics::Histogram::getSum() const
+{
+    return mSum;
+}
+
+uint64_t StubMetrics::Histogram::getMean() const
+{
+    return mCount == 0 ? 0 : mSum / mCount;
+}
+
+uint64_t StubMetrics::Histogram::getMax() const
+{
+    return mMax;
+}
+
+uint64_t StubMetrics::Histogram::getValueAtPercentile(const double percentile) const
+{
+    if (mCount == 0) {
+        return 0;
+    }
+
+    /* Rank of the value, from 1 to the count */
+    const double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    const uint64_t rank =
+        std::max(static_cast<uint64_t>(clamped / 100 * static_cast<double>(mCount) + 0.5),
+                 static_cast<uint64_t>(1));
+
+    uint64_t count = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+        count += mBuckets[i];
+        if (count >= rank) {
+            return std::min(getBucketHighestValue(i), mMax);
+        }
+    }
+
+    return mMax;
+}
+
+/* RECORDER ------------------------------------------------------------------------------------- */
+
+struct StubMetrics::Recorder::Block {
+    /**
+     * Keeps the counters off the cache line of the previous allocation
+     */
+    char mHeadPadding[CACHE_LINE_SIZE];
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mFailureCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mProviderCallCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mSum;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mMax;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mBuckets[BUCKET_COUNT];
+
+    /**
+     *
+     */
+    const std::unique_ptr<std::atomic<uint64_t>[]> mHits;
+
+    /**
+     * Keeps the counters off the cache line of the next allocation
+     */
+    char mTailPadding[CACHE_LINE_SIZE];
+
+    explicit Block(const std::size_t hitCount) : mHits(new std::atomic<uint64_t>[hitCount])
+    {
+        reset(hitCount);
+    }
+
+    void reset(const std::size_t hitCount)
+    {
+        mFailureCount.store(0, std::memory_order_relaxed);
+        mProviderCallCount.store(0, std::memory_order_relaxed);
+        mSum.store(0, std::memory_order_relaxed);
+        mMax.store(0, std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+            mBuckets[i].store(0, std::memory_order_relaxed);
+        }
+
+        for (std::size_t i = 0; i < hitCount; i++) {
+            mHits[i].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+StubMetrics::Recorder::Recorder(const std::size_t hitCount) : mHitCount(hitCount)
+{
+    for (std::size_t i = 0; i < SHARD_COUNT; i++) {
+        mBlocks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+StubMetrics::Recorder::~Recorder()
+{
+    for (std::size_t i = 0; i < SHARD_COUNT; i++) {
+        delete mBlocks[i].load(std::memory_order_relaxed);
+    }
+}
+
+void StubMetrics::Recorder::record(const uint64_t latency, const bool failed)
+{
+    Block& block = getBlock();
+
+    /* Each block is mostly written by a single thread: relaxed increments do not contend */
+    block.mBuckets[getBucket(latency)].fetch_add(1, std::memory_order_relaxed);
+    block.mSum.fetch_add(latency, std::memory_order_relaxed);
+
+    uint64_t max = block.mMax.load(std::memory_order_relaxed);
+    while (latency > max &&
+           !block.mMax.compare_exchange_weak(max, latency, std::memory_order_relaxed)) {}
+
+    if (failed) {
+        block.mFailureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void StubMetrics::Recorder::recordHit(const std::size_t entry)
+{
+    getBlock().mHits[entry].fetch_add(1, std::memory_order_relaxed);
+}
+
+void StubMetrics::Recorder::recordProviderCall()
+{
+    getBlock().mProviderCallCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StubMetrics::Recorder::getMetrics(const std::vector<std::string>& hitKeys,
+                                       CardMetrics& metrics) const
+{
+    std::vector<uint64_t> hits;
+    sum(metrics.mLatency, metrics.mMissCount, metrics.mProviderCallCount, hits);
+    metrics.mApduCount = metrics.mLatency.getCount();
+
+    metrics.mHitCounts.clear();
+    for (std::size_t i = 0; i < hitKeys.size() && i < hits.size(); i++) {
+        metrics.mHitCounts[hitKeys[i]] = hits[i];
+    }
+}
+
+void StubMetrics::Recorder::getMetrics(ReaderMetrics& metrics) const
+{
+    uint64_t providerCallCount;
+    std::vector<uint64_t> hits;
+    sum(metrics.mLatency, metrics.mErrorCount, providerCallCount, hits);
+    metrics.mApduCount = metrics.mLatency.getCount();
+}
+
+void StubMetrics::Recorder::getLatency(Histogram& latency, uint64_t& failureCount) const
+{
+    uint64_t providerCallCount;
+    std::vector<uint64_t> hits;
+    sum(latency, failureCount, providerCallCount, hits);
+}
+
+void StubMetrics::Recorder::reset()
+{
+    for (std::size_t i = 0; i < SHARD_COUNT; i++) {
+        Block* const block = mBlocks[i].load(std::memory_order_acquire);
+        if (block != nullptr) {
+            block->reset(mHitCount);
+        }
+    }
+}
+
+StubMetrics::Recorder::Block& StubMetrics::Recorder::getBlock()
+{
+    std::atomic<Block*>& shard = mBlocks[getShard()];
+
+    Block* block = shard.load(std::memory_order_acquire);
+    if (block != nullptr) {
+        return *block;
+    }
+
+    /* Another thread of the shard may have allocated the block meanwhile */
+    Block* const created = new Block(mHitCount);
+    if (shard.compare_exchange_strong(block, created, std::memory_order_acq_rel)) {
+        return *created;
+    }
+
+    delete created;
+
+    return *block;
+}
+
+void StubMetrics::Recorder::sum(Histogram& latency,
+                                uint64_t& failureCount,
+                                uint64_t& providerCallCount,
+                                std::vector<uint64_t>& hits) const
+{
+    latency = Histogram();
+    failureCount = 0;
+    providerCallCount = 0;
+    hits.assign(mHitCount, 0);
+
+    for (std::size_t i = 0; i < SHARD_COUNT; i++) {
+        const Block* const block = mBlocks[i].load(std::memory_order_acquire);
+        if (block == nullptr) {
+            continue;
+        }
+
+        for (std::size_t j = 0; j < BUCKET_COUNT; j++) {
+            const uint64_t count = block->mBuckets[j].load(std::memory_order_relaxed);
+            latency.mBuckets[j] += count;
+            latency.mCount += count;
+        }
+
+        latency.mSum += block->mSum.load(std::memory_order_relaxed);
+        latency.mMax = std::max(latency.mMax, block->mMax.load(std::memory_order_relaxed));
+        failureCount += block->mFailureCount.load(std::memory_order_relaxed);
+        providerCallCount += block->mProviderCallCount.load(std::memory_order_relaxed);
+
+        for (std::size_t j = 0; j < mHitCount; j++) {
+            hits[j] += block->mHits[j].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/* TIMER ---------------------------------------------------------------------------------------- */
+
+StubMetrics::Timer::Timer(Recorder& recorder) : mRecorder(recorder), mStart(now()) {}
+
+StubMetrics::Timer::~Timer()
+{
+    mRecorder.record(now() - mStart, std::uncaught_exception());
+}
+
+/* STUB METRICS --------------------------------------------------------------------------------- */
+
+bool StubMetrics::isEnabled()
+{
+#if defined(KEYPLE_STUB_METRICS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t StubMetrics::now()
+{
+    return static_cast<uint64_t>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+std::size_t StubMetrics::getShard()
+{
+    static std::atomic<std::size_t> nextShard(0);
+    thread_local const std::size_t shard = nextShard++ % SHARD_COUNT;
+
+    return shard;
+}
+
+}
+}
+}
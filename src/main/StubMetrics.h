@@ -0,0 +1,403 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+/**
+ * Metrics of the hot paths of the stub plugin: the APDUs processed by the cards and transmitted by
+ * the readers.
+ *
+ * <p>Metrics are only recorded when the library is built with KEYPLE_STUB_METRICS defined (CMake
+ * option of the same name). Otherwise the recording code is compiled out and the metrics read are
+ * always empty.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubMetrics final {
+public:
+    /**
+     * Number of shards of a recorder.
+     *
+     * @since 2.2.0
+     */
+    static const std::size_t SHARD_COUNT = 8;
+
+    /**
+     * Latency histogram with a bounded relative error, in the manner of HDR histograms: values are
+     * counted in 8 buckets per power of two, i.e. with a precision of 12.5%. Values of 2^40 ns
+     * (about 18 minutes) and more share the last bucket.
+     *
+     * @since 2.2.0
+     */
+    class KEYPLEPLUGINSTUB_API Histogram final {
+    public:
+        /**
+         * Creates an empty histogram.
+         *
+         * @since 2.2.0
+         */
+        Histogram();
+
+        /**
+         * Adds a value.
+         *
+         * @param value the value, in nanoseconds
+         * @since 2.2.0
+         */
+        void record(const uint64_t value);
+
+        /**
+         * Adds the values of another histogram.
+         *
+         * @param other the other histogram
+         * @since 2.2.0
+         */
+        void merge(const Histogram& other);
+
+        /**
+         * @return the number of values
+         * @since 2.2.0
+         */
+        uint64_t getCount() const;
+
+        /**
+         * @return the sum of the values
+         * @since 2.2.0
+         */
+        uint64_t getSum() const;
+
+        /**
+         * @return the mean of the values, 0 if there is none
+         * @since 2.2.0
+         */
+        uint64_t getMean() const;
+
+        /**
+         * @return the highest value, 0 if there is none
+         * @since 2.2.0
+         */
+        uint64_t getMax() const;
+
+        /**
+         * Gets the value below which fall a given percentage of the values.
+         *
+         * @param percentile the percentage, from 0 to 100
+         * @return the highest value of the bucket holding the percentile, at most getMax()
+         * @since 2.2.0
+         */
+        uint64_t getValueAtPercentile(const double percentile) const;
+
+    private:
+        /**
+         * Friend to fill the histogram from the shards of a recorder
+         */
+        friend class StubMetrics;
+
+        /**
+         *
+         */
+        std::vector<uint64_t> mBuckets;
+
+        /**
+         *
+         */
+        uint64_t mCount;
+
+        /**
+         *
+         */
+        uint64_t mSum;
+
+        /**
+         *
+         */
+        uint64_t mMax;
+    };
+
+    /**
+     * Metrics of a card.
+     *
+     * @since 2.2.0
+     */
+    struct CardMetrics {
+        /**
+         * APDUs processed
+         */
+        uint64_t mApduCount = 0;
+
+        /**
+         * APDUs for which no response was available
+         */
+        uint64_t mMissCount = 0;
+
+        /**
+         * Calls to the ApduResponseProviderSpi of the card
+         */
+        uint64_t mProviderCallCount = 0;
+
+        /**
+         * Number of APDUs answered by each simulated command of the card, by command
+         */
+        std::map<std::string, uint64_t> mHitCounts;
+
+        /**
+         * Processing time of the APDUs
+         */
+        Histogram mLatency;
+    };
+
+    /**
+     * Metrics of a reader.
+     *
+     * @since 2.2.0
+     */
+    struct ReaderMetrics {
+        /**
+         * APDUs transmitted
+         */
+        uint64_t mApduCount = 0;
+
+        /**
+         * Transmissions failed, for lack of card or of response of the card
+         */
+        uint64_t mErrorCount = 0;
+
+        /**
+         * Cards inserted
+         */
+        uint64_t mCardInsertionCount = 0;
+
+        /**
+         * Cards removed
+         */
+        uint64_t mCardRemovalCount = 0;
+
+        /**
+         * Transmission time of the APDUs
+         */
+        Histogram mLatency;
+    };
+
+    /**
+     * (package-private)<br>
+     * Lock-free recorder of the metrics of a card or a reader.
+     *
+     * <p>Recordings go to one of SHARD_COUNT blocks chosen by the calling thread, allocated on its
+     * first recording and on their own cache lines, so that threads exchanging with the same card
+     * or reader do not contend. The blocks are summed when read.
+     *
+     * @since 2.2.0
+     */
+    class KEYPLEPLUGINSTUB_API Recorder final {
+    public:
+        /**
+         * (package-private)<br>
+         *
+         * @param hitCount number of entries whose hits are counted
+         * @since 2.2.0
+         */
+        explicit Recorder(const std::size_t hitCount);
+
+        /**
+         *
+         */
+        ~Recorder();
+
+        /**
+         *
+         */
+        Recorder(const Recorder&) = delete;
+
+        /**
+         *
+         */
+        Recorder& operator=(const Recorder&) = delete;
+
+        /**
+         * (package-private)<br>
+         * Records an exchange.
+         *
+         * @param latency the duration of the exchange, in nanoseconds
+         * @param failed true if the exchange failed
+         * @since 2.2.0
+         */
+        void record(const uint64_t latency, const bool failed);
+
+        /**
+         * (package-private)<br>
+         * Counts a hit of an entry.
+         *
+         * @param entry the index of the entry, lower than the hit count
+         * @since 2.2.0
+         */
+        void recordHit(const std::size_t entry);
+
+        /**
+         * (package-private)<br>
+         * Counts a call to an ApduResponseProviderSpi.
+         *
+         * @since 2.2.0
+         */
+        void recordProviderCall();
+
+        /**
+         * (package-private)<br>
+         * Fills card metrics with the recordings.
+         *
+         * @param hitKeys keys of the entries, in the order of their index
+         * @param metrics the metrics to fill
+         * @since 2.2.0
+         */
+        void getMetrics(const std::vector<std::string>& hitKeys, CardMetrics& metrics) const;
+
+        /**
+         * (package-private)<br>
+         * Fills reader metrics with the recordings.
+         *
+         * @param metrics the metrics to fill
+         * @since 2.2.0
+         */
+        void getMetrics(ReaderMetrics& metrics) const;
+
+        /**
+         * (package-private)<br>
+         * Gets the latencies and the failures recorded.
+         *
+         * @param latency the histogram to fill with the latencies
+         * @param failureCount the number of failed exchanges
+         * @since 2.2.0
+         */
+        void getLatency(Histogram& latency, uint64_t& failureCount) const;
+
+        /**
+         * (package-private)<br>
+         * Sets all the recordings to zero. Recordings made concurrently may be partially kept.
+         *
+         * @since 2.2.0
+         */
+        void reset();
+
+    private:
+        /**
+         * (private)<br>
+         * Recordings of a shard
+         */
+        struct Block;
+
+        /**
+         *
+         */
+        const std::size_t mHitCount;
+
+        /**
+         * Blocks of the shards, null until the first recording of the shard
+         */
+        std::atomic<Block*> mBlocks[SHARD_COUNT];
+
+        /**
+         * (private)<br>
+         * Gets the block of the calling thread, allocating it if needed.
+         */
+        Block& getBlock();
+
+        /**
+         * (private)<br>
+         * Sums the blocks.
+         *
+         * @param latency the histogram of the latencies
+         * @param failureCount the number of failed exchanges
+         * @param providerCallCount the number of provider calls
+         * @param hits the hits of each entry
+         */
+        void sum(Histogram& latency,
+                 uint64_t& failureCount,
+                 uint64_t& providerCallCount,
+                 std::vector<uint64_t>& hits) const;
+    };
+
+    /**
+     * (package-private)<br>
+     * Records the duration of an exchange on destruction, as failed if an exception is being
+     * thrown.
+     *
+     * @since 2.2.0
+     */
+    class KEYPLEPLUGINSTUB_API Timer final {
+    public:
+        /**
+         * (package-private)<br>
+         * Starts timing.
+         *
+         * @param recorder the recorder of the exchange
+         * @since 2.2.0
+         */
+        explicit Timer(Recorder& recorder);
+
+        /**
+         *
+         */
+        ~Timer();
+
+    private:
+        /**
+         *
+         */
+        Recorder& mRecorder;
+
+        /**
+         *
+         */
+        const uint64_t mStart;
+    };
+
+    /**
+     * Indicates whether the library records metrics.
+     *
+     * @return true if built with KEYPLE_STUB_METRICS defined
+     * @since 2.2.0
+     */
+    static bool isEnabled();
+
+    /**
+     * (package-private)<br>
+     * Gets the time of a monotonic clock.
+     *
+     * @return the time, in nanoseconds
+     * @since 2.2.0
+     */
+    static uint64_t now();
+
+private:
+    /**
+     * (private)<br>
+     * Gets the shard of the calling thread, assigned in turn to the threads.
+     */
+    static std::size_t getShard();
+};
+
+}
+}
+}
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 /* Keyple Core Common */
 #include "KeyplePluginExtension.h"
@@ -53,10 +54,42 @@ public:
      * READER_DISCONNECTED event. The reader is removed from the * available list of reader. It does
      * nothing if no reader matches the name.
      *
+     * <p>A reader created by {@link #plugReaders} is retained as described in
+     * {@link #unplugReaders}.
+     *
      * @param name the name of the reader to unplug (not nullable)
      * @since 2.0.0
      */
     virtual void unplugReader(const std::string& name) = 0;
+
+    /**
+     * Plug several {@link StubReader} at once. The readers are created in a single block of memory
+     * and made available together, as a single change of the reader list. Names already plugged
+     * are ignored.
+     *
+     * @param names names for the readers (unique)
+     * @param isContactless true if the created readers should be contactless, false if not.
+     * @param cards either empty (no card) or one card (nullable) per name, in the same order
+     * @throw IllegalArgumentException if cards is neither empty nor as long as names
+     * @since 2.2.0
+     */
+    virtual void plugReaders(const std::vector<std::string>& names,
+                             const bool isContactless,
+                             const std::vector<std::shared_ptr<StubSmartCard>>& cards) = 0;
+
+    /**
+     * Unplug several {@link StubReader} at once, as a single change of the reader list. Names
+     * matching no reader are ignored.
+     *
+     * <p>The readers created together by {@link #plugReaders} share a single block of memory,
+     * released only once all of them are unplugged and no longer referenced. Until then, an
+     * unplugged reader keeps its inserted card and its metrics; remove the card beforehand to
+     * release it earlier.
+     *
+     * @param names the names of the readers to unplug
+     * @since 2.2.0
+     */
+    virtual void unplugReaders(const std::vector<std::string>& names) = 0;
 };
 
 }
@@ -12,6 +12,13 @@
 
 #include "StubPluginAdapter.h"
 
+#include <algorithm>
+#include <iterator>
+
+/* Keyple Plugin Stub */
+#include "StubLazyReaderAdapter.h"
+#include "StubReaderSlab.h"
+
 namespace keyple {
 namespace plugin {
 namespace stub {
@@ -19,14 +26,38 @@ namespace stub {
 StubPluginAdapter::StubPluginAdapter(
   const std::string& name,
   const std::vector<std::shared_ptr<StubReaderConfiguration>>& readerConfigurations,
-  const int monitoringCycleDuration)
-: mName(name), mMonitoringCycleDuration(monitoringCycleDuration)
+  const int monitoringCycleDuration,
+  const bool lazyReaderCreation)
+: StubPluginAdapter(
+      name,
+      std::make_shared<const std::vector<std::shared_ptr<StubReaderConfiguration>>>(
+          readerConfigurations),
+      monitoringCycleDuration,
+      lazyReaderCreation) {}
+
+StubPluginAdapter::StubPluginAdapter(
+  const std::string& name,
+  const StubPluginFactoryAdapter::ReaderConfigurations& readerConfigurations,
+  const int monitoringCycleDuration,
+  const bool lazyReaderCreation)
+: mName(name),
+  mMonitoringCycleDuration(monitoringCycleDuration),
+  mPendingReaderCount(0),
+  mPlugCount(0),
+  mUnplugCount(0)
 {
-    for (const auto& configuration : readerConfigurations) {
-        plugReader(configuration->getName(),
-                   configuration->getContactless(),
-                   configuration->getCard());
+    if (lazyReaderCreation) {
+        /* Only keep the configurations, readers are created on first access */
+        for (const auto& configuration : *readerConfigurations) {
+            mPendingReaders.insert({configuration->getName(), {configuration, nullptr}});
+        }
+
+        mPendingReaderCount = mPendingReaders.size();
+
+        return;
     }
+
+    plugConfiguredReaders(*readerConfigurations);
 }
 
 int StubPluginAdapter::getMonitoringCycleDuration() const
@@ -36,22 +67,49 @@ int StubPluginAdapter::getMonitoringCycleDuration() const
 
 const std::vector<std::string> StubPluginAdapter::searchAvailableReaderNames()
 {
-    std::vector<std::string> readers;
-    for (const auto& reader : mStubReaders) {
-        readers.push_back(reader.first);
+    if (mPendingReaderCount == 0) {
+        return mStubReaders.getSnapshot()->getReaderNames();
     }
 
-    return readers;
+    /* Names are known without creating the pending readers */
+    std::lock_guard<std::mutex> lock(mPendingReadersMutex);
+
+    const std::vector<std::string>& readerNames = mStubReaders.getSnapshot()->getReaderNames();
+
+    std::vector<std::string> pendingReaderNames;
+    pendingReaderNames.reserve(mPendingReaders.size());
+    for (const auto& pendingReader : mPendingReaders) {
+        pendingReaderNames.push_back(pendingReader.first);
+    }
+
+    std::vector<std::string> names;
+    names.reserve(readerNames.size() + pendingReaderNames.size());
+    std::merge(readerNames.begin(),
+               readerNames.end(),
+               pendingReaderNames.begin(),
+               pendingReaderNames.end(),
+               std::back_inserter(names));
+
+    return names;
 }
 
 std::shared_ptr<ReaderSpi> StubPluginAdapter::searchReader(const std::string& readerName)
 {
-    const auto it = mStubReaders.find(readerName);
-    if (it != mStubReaders.end()) {
-        return it->second;
+    const std::shared_ptr<StubReaderAdapter> reader = mStubReaders.find(readerName);
+    if (reader != nullptr || mPendingReaderCount == 0) {
+        return reader;
+    }
+
+    /* Not created yet, the reader is stood for by its proxy */
+    std::lock_guard<std::mutex> lock(mPendingReadersMutex);
+
+    const auto it = mPendingReaders.find(readerName);
+    if (it == mPendingReaders.end()) {
+        /* Unknown, unplugged or created in the meantime */
+        return mStubReaders.find(readerName);
     }
 
-    return nullptr;
+    return getProxy(it->second);
 }
 
 const std::string& StubPluginAdapter::getName() const
@@ -61,12 +119,34 @@ const std::string& StubPluginAdapter::getName() const
 
 const std::vector<std::shared_ptr<ReaderSpi>> StubPluginAdapter::searchAvailableReaders()
 {
-    std::vector<std::shared_ptr<ReaderSpi>> readers;
-    for (const auto& reader : mStubReaders) {
-        readers.push_back(reader.second);
+    if (mPendingReaderCount == 0) {
+        return mStubReaders.getSnapshot()->getReaders();
     }
 
-    return readers;
+    /* Called by the core on registration, the pending readers are listed without being created */
+    std::lock_guard<std::mutex> lock(mPendingReadersMutex);
+
+    const std::vector<std::shared_ptr<ReaderSpi>>& readers =
+        mStubReaders.getSnapshot()->getReaders();
+
+    std::vector<std::shared_ptr<ReaderSpi>> pendingReaders;
+    pendingReaders.reserve(mPendingReaders.size());
+    for (auto& pendingReader : mPendingReaders) {
+        pendingReaders.push_back(getProxy(pendingReader.second));
+    }
+
+    std::vector<std::shared_ptr<ReaderSpi>> allReaders;
+    allReaders.reserve(readers.size() + pendingReaders.size());
+    std::merge(readers.begin(),
+               readers.end(),
+               pendingReaders.begin(),
+               pendingReaders.end(),
+               std::back_inserter(allReaders),
+               [](const std::shared_ptr<ReaderSpi>& a, const std::shared_ptr<ReaderSpi>& b) {
+                   return a->getName() < b->getName();
+               });
+
+    return allReaders;
 }
 
 void StubPluginAdapter::onUnregister()
@@ -78,12 +158,291 @@ void StubPluginAdapter::plugReader(const std::string& name,
                                    const bool isContactless,
                                    std::shared_ptr<StubSmartCard> card)
 {
-    mStubReaders.insert({name, std::make_shared<StubReaderAdapter>(name, isContactless, card)});
+    /* A configured reader keeps precedence over a reader plugged with the same name */
+    if (mPendingReaderCount > 0) {
+        materializeReader(name);
+    }
+
+    if (mStubReaders.insert(std::make_shared<StubReaderAdapter>(name, isContactless, card))) {
+        mPlugCount++;
+    }
 }
 
 void StubPluginAdapter::unplugReader(const std::string& name)
 {
-    mStubReaders.erase(name);
+    if (mPendingReaderCount > 0) {
+        std::lock_guard<std::mutex> lock(mPendingReadersMutex);
+        mPendingReaderCount -= mPendingReaders.erase(name);
+    }
+
+    if (mStubReaders.erase(name) != nullptr) {
+        mUnplugCount++;
+    }
+}
+
+void StubPluginAdapter::plugReaders(const std::vector<std::string>& names,
+                                    const bool isContactless,
+                                    const std::vector<std::shared_ptr<StubSmartCard>>& cards)
+{
+    if (mPendingReaderCount > 0) {
+        for (const auto& name : names) {
+            materializeReader(name);
+        }
+    }
+
+    mPlugCount += mStubReaders.insert(StubReaderSlab::create(names, isContactless, cards));
+}
+
+void StubPluginAdapter::unplugReaders(const std::vector<std::string>& names)
+{
+    if (mPendingReaderCount > 0) {
+        std::lock_guard<std::mutex> lock(mPendingReadersMutex);
+        for (const auto& name : names) {
+            mPendingReaderCount -= mPendingReaders.erase(name);
+        }
+    }
+
+    mUnplugCount += mStubReaders.erase(names);
+}
+
+std::shared_ptr<const StubReaderRegistry::Snapshot> StubPluginAdapter::getReadersSnapshot()
+{
+    if (mPendingReaderCount > 0) {
+        materializeReaders();
+    }
+
+    return mStubReaders.getSnapshot();
+}
+
+const std::vector<uint8_t> StubPluginAdapter::createSnapshot()
+{
+    StubPluginSnapshot::Encoder encoder;
+    writeReaders(encoder);
+
+    return encoder.toBytes();
+}
+
+void StubPluginAdapter::restoreSnapshot(const std::vector<uint8_t>& snapshot)
+{
+    /* Read the whole snapshot before changing anything */
+    StubPluginSnapshot::Decoder decoder(snapshot);
+    const std::vector<StubPluginSnapshot::ReaderState> readerStates = decoder.readReaders();
+    decoder.checkEnd();
+
+    restoreReaders(readerStates);
+}
+
+void StubPluginAdapter::writeReaders(StubPluginSnapshot::Encoder& encoder)
+{
+    const std::shared_ptr<const StubReaderRegistry::Snapshot> snapshot = getReadersSnapshot();
+
+    std::vector<std::shared_ptr<StubReaderAdapter>> readers;
+    readers.reserve(snapshot->getReaders().size());
+    for (const auto& readerSpi : snapshot->getReaders()) {
+        readers.push_back(std::dynamic_pointer_cast<StubReaderAdapter>(readerSpi));
+    }
+
+    encoder.writeReaders(readers);
+}
+
+void StubPluginAdapter::restoreReaders(
+    const std::vector<StubPluginSnapshot::ReaderState>& readerStates)
+{
+    {
+        std::lock_guard<std::mutex> lock(mPendingReadersMutex);
+        mPendingReaders.clear();
+        mPendingReaderCount = 0;
+    }
+
+    mStubReaders.erase(mStubReaders.getSnapshot()->getReaderNames());
+
+    mStubReaders.insert(StubPluginSnapshot::createReaders(readerStates));
+}
+
+uint64_t StubPluginAdapter::getPlugCount() const
+{
+    return mPlugCount;
+}
+
+uint64_t StubPluginAdapter::getUnplugCount() const
+{
+    return mUnplugCount;
+}
+
+const std::string StubPluginAdapter::getPrometheusMetrics()
+{
+    StubPrometheusWriter writer;
+    writeMetrics(writer);
+
+    return writer.toString();
+}
+
+void StubPluginAdapter::writePrometheusMetrics(const std::string& path)
+{
+    StubPrometheusWriter::writeFile(path, getPrometheusMetrics());
+}
+
+void StubPluginAdapter::writeMetrics(StubPrometheusWriter& writer)
+{
+    /* The snapshot is immutable, plugging and unplugging readers go on meanwhile */
+    const std::shared_ptr<const StubReaderRegistry::Snapshot> snapshot =
+        mStubReaders.getSnapshot();
+    const StubPrometheusWriter::Labels labels = {{"plugin", mName}};
+
+    writer.writeFamily("keyple_stub_plugin_readers", "gauge", "Readers of the plugin.");
+    writer.writeSample("keyple_stub_plugin_readers",
+                       labels,
+                       static_cast<uint64_t>(snapshot->getReaders().size() + mPendingReaderCount));
+
+    writer.writeFamily("keyple_stub_plugin_reader_plugs_total", "counter", "Readers plugged.");
+    writer.writeSample("keyple_stub_plugin_reader_plugs_total", labels, getPlugCount());
+
+    writer.writeFamily("keyple_stub_plugin_reader_unplugs_total", "counter", "Readers unplugged.");
+    writer.writeSample("keyple_stub_plugin_reader_unplugs_total", labels, getUnplugCount());
+
+    if (!StubMetrics::isEnabled()) {
+        return;
+    }
+
+    /* Read once, the families list the readers in the same order */
+    std::vector<StubPrometheusWriter::Labels> readerLabels;
+    std::vector<StubMetrics::ReaderMetrics> readerMetrics;
+    std::vector<StubMetrics::CardMetrics> cardMetrics;
+    for (const auto& readerSpi : snapshot->getReaders()) {
+        const auto reader = std::dynamic_pointer_cast<StubReaderAdapter>(readerSpi);
+        const std::shared_ptr<StubSmartCard> card = reader->getSmartcard();
+
+        readerLabels.push_back({{"plugin", mName}, {"reader", reader->getName()}});
+        readerMetrics.push_back(reader->getMetrics());
+        cardMetrics.push_back(card != nullptr ? card->getMetrics() : StubMetrics::CardMetrics());
+    }
+
+    writer.writeFamily("keyple_stub_reader_apdus_total", "counter", "APDUs transmitted.");
+    for (std::size_t i = 0; i < readerMetrics.size(); i++) {
+        writer.writeSample("keyple_stub_reader_apdus_total",
+                           readerLabels[i],
+                           readerMetrics[i].mApduCount);
+    }
+
+    writer.writeFamily("keyple_stub_reader_errors_total",
+                       "counter",
+                       "APDU transmissions failed.");
+    for (std::size_t i = 0; i < readerMetrics.size(); i++) {
+        writer.writeSample("keyple_stub_reader_errors_total",
+                           readerLabels[i],
+                           readerMetrics[i].mErrorCount);
+    }
+
+    writer.writeFamily("keyple_stub_reader_card_insertions_total", "counter", "Cards inserted.");
+    for (std::size_t i = 0; i < readerMetrics.size(); i++) {
+        writer.writeSample("keyple_stub_reader_card_insertions_total",
+                           readerLabels[i],
+                           readerMetrics[i].mCardInsertionCount);
+    }
+
+    writer.writeFamily("keyple_stub_reader_card_removals_total", "counter", "Cards removed.");
+    for (std::size_t i = 0; i < readerMetrics.size(); i++) {
+        writer.writeSample("keyple_stub_reader_card_removals_total",
+                           readerLabels[i],
+                           readerMetrics[i].mCardRemovalCount);
+    }
+
+    writer.writeFamily("keyple_stub_reader_transmit_seconds",
+                       "summary",
+                       "Transmission time of the APDUs.");
+    for (std::size_t i = 0; i < readerMetrics.size(); i++) {
+        writer.writeSummary("keyple_stub_reader_transmit_seconds",
+                            readerLabels[i],
+                            readerMetrics[i].mLatency);
+    }
+
+    writer.writeFamily("keyple_stub_card_misses_total",
+                       "counter",
+                       "APDUs without response of the card inserted in the reader.");
+    for (std::size_t i = 0; i < cardMetrics.size(); i++) {
+        writer.writeSample("keyple_stub_card_misses_total",
+                           readerLabels[i],
+                           cardMetrics[i].mMissCount);
+    }
+
+    writer.writeFamily("keyple_stub_card_provider_calls_total",
+                       "counter",
+                       "Calls to the APDU response provider of the card inserted in the reader.");
+    for (std::size_t i = 0; i < cardMetrics.size(); i++) {
+        writer.writeSample("keyple_stub_card_provider_calls_total",
+                           readerLabels[i],
+                           cardMetrics[i].mProviderCallCount);
+    }
+}
+
+std::shared_ptr<StubLazyReaderAdapter> StubPluginAdapter::getProxy(PendingReader& pendingReader)
+{
+    if (pendingReader.mProxy == nullptr) {
+        pendingReader.mProxy =
+            std::make_shared<StubLazyReaderAdapter>(shared_from_this(),
+                                                    pendingReader.mConfiguration);
+    }
+
+    return pendingReader.mProxy;
+}
+
+std::shared_ptr<StubReaderAdapter> StubPluginAdapter::materializeReader(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mPendingReadersMutex);
+
+    const auto it = mPendingReaders.find(name);
+    if (it == mPendingReaders.end()) {
+        /* Unknown, unplugged or created in the meantime */
+        return mStubReaders.find(name);
+    }
+
+    const std::shared_ptr<StubReaderConfiguration> configuration = it->second.mConfiguration;
+    mStubReaders.insert(std::make_shared<StubReaderAdapter>(configuration->getName(),
+                                                            configuration->getContactless(),
+                                                            configuration->getCard()));
+
+    /* Removed once inserted so that concurrent lookups find it in one place or the other */
+    mPendingReaders.erase(it);
+    mPendingReaderCount--;
+
+    return mStubReaders.find(name);
+}
+
+void StubPluginAdapter::plugConfiguredReaders(
+    const std::vector<std::shared_ptr<StubReaderConfiguration>>& readerConfigurations)
+{
+    /* Slabs hold readers of the same kind */
+    std::vector<std::string> names[2];
+    std::vector<std::shared_ptr<StubSmartCard>> cards[2];
+    for (const auto& configuration : readerConfigurations) {
+        const std::size_t kind = configuration->getContactless() ? 1 : 0;
+        names[kind].push_back(configuration->getName());
+        cards[kind].push_back(configuration->getCard());
+    }
+
+    for (std::size_t kind = 0; kind < 2; kind++) {
+        mStubReaders.insert(StubReaderSlab::create(names[kind], kind == 1, cards[kind]));
+    }
+}
+
+void StubPluginAdapter::materializeReaders()
+{
+    std::lock_guard<std::mutex> lock(mPendingReadersMutex);
+
+    if (mPendingReaders.empty()) {
+        return;
+    }
+
+    std::vector<std::shared_ptr<StubReaderConfiguration>> readerConfigurations;
+    readerConfigurations.reserve(mPendingReaders.size());
+    for (const auto& pendingReader : mPendingReaders) {
+        readerConfigurations.push_back(pendingReader.second.mConfiguration);
+    }
+
+    plugConfiguredReaders(readerConfigurations);
+
+    mPendingReaders.clear();
+    mPendingReaderCount = 0;
 }
 
 }
@@ -12,8 +12,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -24,7 +26,10 @@
 #include "KeyplePluginStubExport.h"
 #include "StubPlugin.h"
 #include "StubPluginFactoryAdapter.h"
+#include "StubPluginSnapshot.h"
+#include "StubPrometheusWriter.h"
 #include "StubReaderAdapter.h"
+#include "StubReaderRegistry.h"
 
 namespace keyple {
 namespace plugin {
@@ -34,13 +39,25 @@ using StubReaderConfiguration = StubPluginFactoryAdapter::StubReaderConfiguratio
 
 using namespace keyple::core::plugin::spi;
 
+class StubLazyReaderAdapter;
+
 /**
  * (package-private)<br>
  * Internal adapter of the {@link StubPlugin}
  *
+ * <p>Readers can be plugged and unplugged while other threads search them (since 2.2.0).
+ *
+ * <p>In lazy mode, searchAvailableReaders() and searchReader() return a proxy for each configured
+ * reader not created yet, always the same one, and the reader is only created when first used
+ * through it, so that registering the plugin creates none of them (since 2.2.0). The plugin must
+ * then be owned by a shared_ptr.
+ *
  * @since 2.0.0
  */
-class KEYPLEPLUGINSTUB_API StubPluginAdapter : public StubPlugin, public ObservablePluginSpi {
+class KEYPLEPLUGINSTUB_API StubPluginAdapter
+: public StubPlugin,
+  public ObservablePluginSpi,
+  public std::enable_shared_from_this<StubPluginAdapter> {
 public:
     /**
      * (package-private )constructor
@@ -48,12 +65,30 @@ public:
      * @param name name of the plugin
      * @param readerConfigurations configurations of the reader to plug initially
      * @param monitoringCycleDuration duration between two monitoring cycles
+     * @param lazyReaderCreation true to create the configured readers on first access (since
+     *        2.2.0)
      * @since 2.0.0
      */
     StubPluginAdapter(
         const std::string& name,
         const std::vector<std::shared_ptr<StubReaderConfiguration>>& readerConfigurations,
-        const int monitoringCycleDuration);
+        const int monitoringCycleDuration,
+        const bool lazyReaderCreation = false);
+
+    /**
+     * (package-private)<br>
+     * Constructor sharing the reader configurations of the factory.
+     *
+     * @param name name of the plugin
+     * @param readerConfigurations configurations of the reader to plug initially (not null)
+     * @param monitoringCycleDuration duration between two monitoring cycles
+     * @param lazyReaderCreation true to create the configured readers on first access
+     * @since 2.2.0
+     */
+    StubPluginAdapter(const std::string& name,
+                      const StubPluginFactoryAdapter::ReaderConfigurations& readerConfigurations,
+                      const int monitoringCycleDuration,
+                      const bool lazyReaderCreation = false);
 
     /**
      * {@inheritDoc}
@@ -113,7 +148,153 @@ public:
      */
     void unplugReader(const std::string& name) override;
 
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void plugReaders(const std::vector<std::string>& names,
+                     const bool isContactless,
+                     const std::vector<std::shared_ptr<StubSmartCard>>& cards) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void unplugReaders(const std::vector<std::string>& names) override;
+
+    /**
+     * (package-private)<br>
+     * Gets the plugged readers without copying them. The snapshot is shared and only rebuilt
+     * after a reader has been plugged or unplugged, searchAvailableReaders() and
+     * searchAvailableReaderNames() return copies of it. In lazy mode, the readers not created yet
+     * are created first.
+     *
+     * @return an immutable snapshot of the readers, sorted by name
+     * @since 2.2.0
+     */
+    std::shared_ptr<const StubReaderRegistry::Snapshot> getReadersSnapshot();
+
+    /**
+     * (package-private)<br>
+     * Saves the state of the plugin: its readers, their activated protocols and their cards,
+     * including the state of the physical channel and the simulated commands of the cards.
+     *
+     * @return the snapshot
+     * @throw IllegalStateException if a card gets its responses from an ApduResponseProviderSpi
+     *        or from a compiled profile
+     * @since 2.2.0
+     */
+    const std::vector<uint8_t> createSnapshot();
+
+    /**
+     * (package-private)<br>
+     * Replaces the readers of the plugin by those of a snapshot. The readers are created at once,
+     * as by plugReaders(), and the cards sharing their simulated commands when the snapshot was
+     * created share them again. The plugin is left untouched if the snapshot is not valid.
+     *
+     * @param snapshot a snapshot created by createSnapshot()
+     * @throw IllegalArgumentException if the snapshot is not valid
+     * @since 2.2.0
+     */
+    void restoreSnapshot(const std::vector<uint8_t>& snapshot);
+
+    /**
+     * (package-private)<br>
+     * Writes the state of the readers into a snapshot, the readers not created yet are created
+     * first.
+     *
+     * @param encoder the encoder of the snapshot
+     * @throw IllegalStateException if the card of a reader cannot be saved
+     * @since 2.2.0
+     */
+    void writeReaders(StubPluginSnapshot::Encoder& encoder);
+
+    /**
+     * (package-private)<br>
+     * Replaces the readers of the plugin by readers read from a snapshot.
+     *
+     * @param readerStates the state of the readers
+     * @since 2.2.0
+     */
+    void restoreReaders(const std::vector<StubPluginSnapshot::ReaderState>& readerStates);
+
+    /**
+     * (package-private)<br>
+     * Gets the number of readers plugged through plugReader() and plugReaders().
+     *
+     * @return a positive number
+     * @since 2.2.0
+     */
+    uint64_t getPlugCount() const;
+
+    /**
+     * (package-private)<br>
+     * Gets the number of readers unplugged through unplugReader() and unplugReaders().
+     *
+     * @return a positive number
+     * @since 2.2.0
+     */
+    uint64_t getUnplugCount() const;
+
+    /**
+     * (package-private)<br>
+     * Renders the metrics of the plugin in the Prometheus text format: the number of readers, the
+     * plugs and unplugs and, if the library is built with KEYPLE_STUB_METRICS defined, the APDUs,
+     * errors, card swaps and transmission latency of each reader and the misses and provider calls
+     * of its card.
+     *
+     * <p>The metrics are read from the current reader snapshot without blocking the readers, the
+     * readers not created yet in lazy mode are not created.
+     *
+     * @return the metrics
+     * @since 2.2.0
+     */
+    const std::string getPrometheusMetrics();
+
+    /**
+     * (package-private)<br>
+     * Writes the metrics rendered by getPrometheusMetrics() to a file, replacing it at once.
+     *
+     * @param path the path of the file
+     * @throw IllegalArgumentException if the file cannot be written
+     * @since 2.2.0
+     */
+    void writePrometheusMetrics(const std::string& path);
+
+    /**
+     * (package-private)<br>
+     * Writes the metrics of the plugin.
+     *
+     * @param writer the writer
+     * @since 2.2.0
+     */
+    void writeMetrics(StubPrometheusWriter& writer);
+
 private:
+    /**
+     * Creates the readers it stands for
+     */
+    friend class StubLazyReaderAdapter;
+
+    /**
+     * (private)<br>
+     * Configured reader not created yet
+     */
+    struct PendingReader {
+        /**
+         *
+         */
+        std::shared_ptr<StubReaderConfiguration> mConfiguration;
+
+        /**
+         * Stands for the reader until it is created, built on first listing or lookup as the plugin
+         * cannot refer to itself while being constructed
+         */
+        std::shared_ptr<StubLazyReaderAdapter> mProxy;
+    };
+
     /**
      *
      */
@@ -127,7 +308,65 @@ private:
     /**
      *
      */
-    std::map<std::string, std::shared_ptr<StubReaderAdapter>> mStubReaders;
+    StubReaderRegistry mStubReaders;
+
+    /**
+     * Guards mPendingReaders
+     */
+    std::mutex mPendingReadersMutex;
+
+    /**
+     * Configured readers not created yet (lazy mode)
+     */
+    std::map<std::string, PendingReader> mPendingReaders;
+
+    /**
+     * Size of mPendingReaders, lets lookups skip the lock once every reader has been created
+     */
+    std::atomic<std::size_t> mPendingReaderCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mPlugCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mUnplugCount;
+
+    /**
+     * (private)<br>
+     * Gets the proxy of a pending reader, built on first call, mPendingReadersMutex must be held.
+     *
+     * @param pendingReader the pending reader
+     * @return a not null proxy
+     */
+    std::shared_ptr<StubLazyReaderAdapter> getProxy(PendingReader& pendingReader);
+
+    /**
+     * (private)<br>
+     * Creates a configured reader if it is still pending.
+     *
+     * @param name name of the reader
+     * @return the reader or nullptr if no reader has this name
+     */
+    std::shared_ptr<StubReaderAdapter> materializeReader(const std::string& name);
+
+    /**
+     * (private)<br>
+     * Creates all the pending configured readers at once.
+     */
+    void materializeReaders();
+
+    /**
+     * (private)<br>
+     * Plugs configured readers at once, in one slab per kind of reader.
+     *
+     * @param readerConfigurations the configurations
+     */
+    void plugConfiguredReaders(
+        const std::vector<std::shared_ptr<StubReaderConfiguration>>& readerConfigurations);
 };
 
 }
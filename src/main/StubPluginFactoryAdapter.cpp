@@ -19,6 +19,7 @@
 #include "CommonApiProperties.h"
 
 /* Keyple Plugin Stub */
+#include "StubAutonomousPluginAdapter.h"
 #include "StubPluginAdapter.h"
 
 namespace keyple {
@@ -54,9 +55,27 @@ std::shared_ptr<StubSmartCard> StubPluginFactoryAdapter::StubReaderConfiguration
 StubPluginFactoryAdapter::StubPluginFactoryAdapter(
   const std::string& pluginName,
   const std::vector<std::shared_ptr<StubReaderConfiguration>> readerConfigurations,
-  const int monitoringCycleDuration)
+  const int monitoringCycleDuration,
+  const bool lazyReaderCreation,
+  const bool autonomousObservation)
+: StubPluginFactoryAdapter(
+      pluginName,
+      std::make_shared<const std::vector<std::shared_ptr<StubReaderConfiguration>>>(
+          readerConfigurations),
+      monitoringCycleDuration,
+      lazyReaderCreation,
+      autonomousObservation) {}
+
+StubPluginFactoryAdapter::StubPluginFactoryAdapter(
+  const std::string& pluginName,
+  const ReaderConfigurations& readerConfigurations,
+  const int monitoringCycleDuration,
+  const bool lazyReaderCreation,
+  const bool autonomousObservation)
 : mReaderConfigurations(readerConfigurations),
   mMonitoringCycleDuration(monitoringCycleDuration),
+  mLazyReaderCreation(lazyReaderCreation),
+  mAutonomousObservation(autonomousObservation),
   mPluginName(pluginName) {}
 
 const std::string& StubPluginFactoryAdapter::getPluginApiVersion() const
@@ -76,9 +95,16 @@ const std::string& StubPluginFactoryAdapter::getPluginName() const
 
 std::shared_ptr<PluginSpi> StubPluginFactoryAdapter::getPlugin()
 {
+    if (mAutonomousObservation) {
+        return std::make_shared<StubAutonomousPluginAdapter>(mPluginName,
+                                                             mReaderConfigurations,
+                                                             mLazyReaderCreation);
+    }
+
     return std::make_shared<StubPluginAdapter>(mPluginName,
                                                mReaderConfigurations,
-                                               mMonitoringCycleDuration);
+                                               mMonitoringCycleDuration,
+                                               mLazyReaderCreation);
 }
 
 }
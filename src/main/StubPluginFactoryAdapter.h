@@ -99,6 +99,16 @@ public:
         std::shared_ptr<StubSmartCard> mCard;
     };
 
+    /**
+     * (package-private)<br>
+     * Immutable set of reader configurations, shared by the builder, the factory and the plugins
+     * instead of being copied from one to the other.
+     *
+     * @since 2.2.0
+     */
+    using ReaderConfigurations =
+        std::shared_ptr<const std::vector<std::shared_ptr<StubReaderConfiguration>>>;
+
     /**
      * (package-private)<br>
      * Creates an instance, sets the fields from the factory builder.
@@ -106,12 +116,33 @@ public:
      * @param pluginName name of the plugin
      * @param readerConfigurations readerConfigurations to be created at init
      * @param monitoringCycleDuration duration of each monitoring cycle
+     * @param lazyReaderCreation true to create the readers on first access (since 2.2.0)
+     * @param autonomousObservation true to push the reader changes to the core (since 2.2.0)
      * @since 2.0.0
      */
     StubPluginFactoryAdapter(
         const std::string& pluginName,
         const std::vector<std::shared_ptr<StubReaderConfiguration>> readerConfigurations,
-        const int monitoringCycleDuration);
+        const int monitoringCycleDuration,
+        const bool lazyReaderCreation = false,
+        const bool autonomousObservation = false);
+
+    /**
+     * (package-private)<br>
+     * Creates an instance sharing the reader configurations of the factory builder.
+     *
+     * @param pluginName name of the plugin
+     * @param readerConfigurations readerConfigurations to be created at init (not null)
+     * @param monitoringCycleDuration duration of each monitoring cycle
+     * @param lazyReaderCreation true to create the readers on first access
+     * @param autonomousObservation true to push the reader changes to the core
+     * @since 2.2.0
+     */
+    StubPluginFactoryAdapter(const std::string& pluginName,
+                             const ReaderConfigurations& readerConfigurations,
+                             const int monitoringCycleDuration,
+                             const bool lazyReaderCreation = false,
+                             const bool autonomousObservation = false);
 
     /**
      * {@inheritDoc}
@@ -145,13 +176,23 @@ private:
     /**
      *
      */
-    std::vector<std::shared_ptr<StubReaderConfiguration>> mReaderConfigurations;
+    const ReaderConfigurations mReaderConfigurations;
 
     /**
      *
      */
     const int mMonitoringCycleDuration;
 
+    /**
+     *
+     */
+    const bool mLazyReaderCreation;
+
+    /**
+     *
+     */
+    const bool mAutonomousObservation;
+
     /**
      *
      */
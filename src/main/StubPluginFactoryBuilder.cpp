@@ -22,13 +22,27 @@ const std::string StubPluginFactoryBuilder::PLUGIN_NAME = "StubPlugin";
 
 /* BUILDER -------------------------------------------------------------------------------------- */
 
-Builder::Builder() : mMonitoringCycleDuration(0) {}
+Builder::Builder()
+: mReaderConfigurations(
+      std::make_shared<std::vector<std::shared_ptr<StubReaderConfiguration>>>()),
+  mReaderConfigurationsShared(false),
+  mMonitoringCycleDuration(0),
+  mLazyReaderCreation(false),
+  mAutonomousObservation(false) {}
 
 Builder& Builder::withStubReader(const std::string& name,
                                  const bool isContactLess,
                                  std::shared_ptr<StubSmartCard> card)
 {
-    mReaderConfigurations.push_back(
+    /* Copy on write, the factories already built keep their configurations */
+    if (mReaderConfigurationsShared) {
+        mReaderConfigurations =
+            std::make_shared<std::vector<std::shared_ptr<StubReaderConfiguration>>>(
+                *mReaderConfigurations);
+        mReaderConfigurationsShared = false;
+    }
+
+    mReaderConfigurations->push_back(
         std::make_shared<StubReaderConfiguration>(name, isContactLess, card));
 
     return *this;
@@ -41,11 +55,29 @@ Builder& Builder::withMonitoringCycleDuration(const int duration)
     return *this;
 }
 
+Builder& Builder::withLazyReaderCreation()
+{
+    mLazyReaderCreation = true;
+
+    return *this;
+}
+
+Builder& Builder::withAutonomousObservation()
+{
+    mAutonomousObservation = true;
+
+    return *this;
+}
+
 std::shared_ptr<StubPluginFactory> Builder::build() const
 {
+    mReaderConfigurationsShared = true;
+
     return std::make_shared<StubPluginFactoryAdapter>(PLUGIN_NAME,
                                                       mReaderConfigurations,
-                                                      mMonitoringCycleDuration);
+                                                      mMonitoringCycleDuration,
+                                                      mLazyReaderCreation,
+                                                      mAutonomousObservation);
 }
 
 /* STUB PLUGIN FACTORY BUILDER ------------------------------------------------------------------ */
@@ -73,6 +73,27 @@ public:
          */
         Builder& withMonitoringCycleDuration(const int duration);
 
+        /**
+         * Defers the creation of the readers added with withStubReader() until they are first
+         * searched by name or used. Registering the plugin only lists them, startup time and
+         * memory then depend on the readers actually used, which suits configurations with a large
+         * number of readers.
+         *
+         * @return instance of the builder
+         * @since 2.2.0
+         */
+        Builder& withLazyReaderCreation();
+
+        /**
+         * Makes the plugin notify the readers plugged or unplugged with StubPlugin to the core as
+         * soon as they change, through an autonomous observable plugin. The core no longer polls
+         * the reader names and the monitoring cycle duration is ignored.
+         *
+         * @return instance of the builder
+         * @since 2.2.0
+         */
+        Builder& withAutonomousObservation();
+
         /**
          * Returns an instance of StubPluginFactory created from the fields set on this builder.
          *
@@ -83,15 +104,31 @@ public:
 
     private:
         /**
-         *
+         * Shared with the factories built, copied before being modified again
          */
-        std::vector<std::shared_ptr<StubReaderConfiguration>> mReaderConfigurations;
+        std::shared_ptr<std::vector<std::shared_ptr<StubReaderConfiguration>>>
+            mReaderConfigurations;
+
+        /**
+         * True once mReaderConfigurations has been handed to a factory
+         */
+        mutable bool mReaderConfigurationsShared;
 
         /**
          *
          */
         int mMonitoringCycleDuration;
 
+        /**
+         *
+         */
+        bool mLazyReaderCreation;
+
+        /**
+         *
+         */
+        bool mAutonomousObservation;
+
         /**
          * (private) Constructs an empty Builder
          */
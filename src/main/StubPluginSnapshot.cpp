@@ -0,0 +1,334 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubPluginSnapshot.h"
+
+/* Keyple Plugin Stub */
+#include "StubReaderSlab.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+#include "IllegalStateException.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util::cpp::exception;
+
+const uint32_t StubPluginSnapshot::FORMAT_VERSION = 2;
+const uint32_t StubPluginSnapshot::MAGIC = 0x5350534B;
+
+/* STUB PLUGIN SNAPSHOT ------------------------------------------------------------------------- */
+
+const std::vector<std::shared_ptr<StubReaderAdapter>> StubPluginSnapshot::createReaders(
+    const std::vector<ReaderState>& readerStates)
+{
+    /* Slabs hold readers of the same kind */
+    std::vector<const ReaderState*> states[2];
+    std::vector<std::string> names[2];
+    std::vector<std::shared_ptr<StubSmartCard>> cards[2];
+    for (const auto& readerState : readerStates) {
+        const std::size_t kind = readerState.mIsContactless ? 1 : 0;
+        states[kind].push_back(&readerState);
+        names[kind].push_back(readerState.mName);
+        cards[kind].push_back(readerState.mCard);
+    }
+
+    std::vector<std::shared_ptr<StubReaderAdapter>> readers;
+    readers.reserve(readerStates.size());
+    for (std::size_t kind = 0; kind < 2; kind++) {
+        const std::vector<std::shared_ptr<StubReaderAdapter>> slabReaders =
+            StubReaderSlab::create(names[kind], kind == 1, cards[kind]);
+
+        for (std::size_t i = 0; i < slabReaders.size(); i++) {
+            slabReaders[i]->mActivatedProtocols = states[kind][i]->mActivatedProtocols;
+            for (const auto& protocol : states[kind][i]->mOtherActivatedProtocols) {
+                slabReaders[i]->activateProtocol(protocol);
+            }
+            readers.push_back(slabReaders[i]);
+        }
+    }
+
+    return readers;
+}
+
+/* ENCODER -------------------------------------------------------------------------------------- */
+
+StubPluginSnapshot::Encoder::Encoder() {}
+
+void StubPluginSnapshot::Encoder::writeInt(const std::size_t value)
+{
+    for (std::size_t i = 0; i < 4; i++) {
+        mContent += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void StubPluginSnapshot::Encoder::writeLong(const uint64_t value)
+{
+    writeInt(static_cast<std::size_t>(value & 0xFFFFFFFF));
+    writeInt(static_cast<std::size_t>(value >> 32));
+}
+
+void StubPluginSnapshot::Encoder::writeString(const std::string& value)
+{
+    writeInt(value.size());
+    mContent += value;
+}
+
+void StubPluginSnapshot::Encoder::writeCard(const std::shared_ptr<StubSmartCard> card)
+{
+    if (card == nullptr) {
+        writeInt(0);
+        return;
+    }
+
+    const auto it = mCardIndexes.find(card.get());
+    if (it != mCardIndexes.end()) {
+        writeInt(it->second + 1);
+        return;
+    }
+
+    if (card->mApduResponseProvider != nullptr || card->mProfile != nullptr) {
+        throw IllegalStateException("A card whose responses are not simulated commands of its " \
+                                    "own cannot be saved");
+    }
+
+    if (mCommandTableIndexes.find(card->mCommandTable.get()) == mCommandTableIndexes.end()) {
+        mCommandTableIndexes.insert({card->mCommandTable.get(), mCommandTables.size()});
+        mCommandTables.push_back(card->mCommandTable);
+    }
+
+    mCardIndexes.insert({card.get(), mCards.size()});
+    mCards.push_back(card);
+
+    writeInt(mCards.size());
+}
+
+void StubPluginSnapshot::Encoder::writeReaders(
+    const std::vector<std::shared_ptr<StubReaderAdapter>>& readers)
+{
+    writeInt(readers.size());
+    for (const auto& reader : readers) {
+        writeString(reader->mName);
+        writeInt(reader->mIsContactLess ? 1 : 0);
+        writeLong(reader->mActivatedProtocols);
+
+        /* Protocols interned after the table was full, if any */
+        const std::vector<std::string> noProtocols;
+        const std::vector<std::string>& otherProtocols =
+            reader->mOtherActivatedProtocols != nullptr ? *reader->mOtherActivatedProtocols
+                                                        : noProtocols;
+        writeInt(otherProtocols.size());
+        for (const auto& protocol : otherProtocols) {
+            writeString(protocol);
+        }
+        writeCard(reader->mSmartCard);
+    }
+}
+
+const std::vector<uint8_t> StubPluginSnapshot::Encoder::toBytes() const
+{
+    /* The tables are only known once the content is written, they are encoded apart */
+    Encoder tables;
+    tables.writeInt(MAGIC);
+    tables.writeInt(FORMAT_VERSION);
+
+    /* The bits of the readers refer to the protocols interned at the time of the snapshot */
+    const std::vector<std::string> protocols = StubReaderAdapter::getProtocols();
+    tables.writeInt(protocols.size());
+    for (const auto& protocol : protocols) {
+        tables.writeString(protocol);
+    }
+
+    tables.writeInt(mCommandTables.size());
+    for (const auto& commandTable : mCommandTables) {
+        tables.writeInt(commandTable->size());
+        for (std::size_t i = 0; i < commandTable->size(); i++) {
+            tables.writeString(commandTable->getCommand(i));
+            tables.writeString(commandTable->getResponse(i));
+        }
+    }
+
+    tables.writeInt(mCards.size());
+    for (const auto& card : mCards) {
+        tables.writeString(std::string(card->mPowerOnData.begin(), card->mPowerOnData.end()));
+        tables.writeString(card->mCardProtocol);
+        tables.writeInt(card->mIsPhysicalChannelOpen ? 1 : 0);
+        tables.writeInt(mCommandTableIndexes.at(card->mCommandTable.get()));
+    }
+
+    std::vector<uint8_t> snapshot;
+    snapshot.reserve(tables.mContent.size() + mContent.size());
+    snapshot.insert(snapshot.end(), tables.mContent.begin(), tables.mContent.end());
+    snapshot.insert(snapshot.end(), mContent.begin(), mContent.end());
+
+    return snapshot;
+}
+
+/* DECODER -------------------------------------------------------------------------------------- */
+
+StubPluginSnapshot::Decoder::Decoder(const std::vector<uint8_t>& snapshot)
+: mSnapshot(snapshot), mOffset(0)
+{
+    if (mSnapshot.size() < 8 || readInt() != MAGIC) {
+        throw IllegalArgumentException("Not a stub plugin snapshot");
+    }
+
+    const uint32_t version = readInt();
+    if (version != FORMAT_VERSION) {
+        throw IllegalArgumentException("Unsupported stub plugin snapshot version " +
+                                       std::to_string(version));
+    }
+
+    const uint32_t protocolCount = readInt();
+    if (protocolCount > 64) {
+        throw IllegalArgumentException("Corrupted stub plugin snapshot");
+    }
+
+    for (uint32_t i = 0; i < protocolCount; i++) {
+        mProtocols.push_back(readString());
+    }
+
+    /* Each set of simulated commands is created once and shared by its cards */
+    const uint32_t hexCommandsCount = readInt();
+    std::vector<std::shared_ptr<const StubCommandTable>> hexCommandsTable;
+    for (uint32_t i = 0; i < hexCommandsCount; i++) {
+        const uint32_t hexCommandCount = readInt();
+        std::map<std::string, std::string> hexCommands;
+        for (uint32_t j = 0; j < hexCommandCount; j++) {
+            const std::string command = readString();
+            hexCommands.insert({command, readString()});
+        }
+        hexCommandsTable.push_back(std::make_shared<const StubCommandTable>(hexCommands));
+    }
+
+    const uint32_t cardCount = readInt();
+    for (uint32_t i = 0; i < cardCount; i++) {
+        const std::string powerOnData = readString();
+        const std::string cardProtocol = readString();
+        const bool isPhysicalChannelOpen = readInt() != 0;
+        const uint32_t hexCommandsIndex = readInt();
+        if (hexCommandsIndex >= hexCommandsTable.size()) {
+            throw IllegalArgumentException("Corrupted stub plugin snapshot");
+        }
+
+        const std::shared_ptr<StubSmartCard> card(
+            new StubSmartCard(std::vector<uint8_t>(powerOnData.begin(), powerOnData.end()),
+                              cardProtocol,
+                              hexCommandsTable[hexCommandsIndex],
+                              nullptr));
+        card->mIsPhysicalChannelOpen = isPhysicalChannelOpen;
+        mCards.push_back(card);
+    }
+
+    /* Protocols are interned once the tables are known to be valid */
+    for (const auto& protocol : mProtocols) {
+        mProtocolBits.push_back(StubReaderAdapter::getProtocolBit(protocol, true));
+    }
+}
+
+uint32_t StubPluginSnapshot::Decoder::readInt()
+{
+    const uint8_t* const bytes = read(4);
+
+    return static_cast<uint32_t>(bytes[0]) |
+           static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 |
+           static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+uint64_t StubPluginSnapshot::Decoder::readLong()
+{
+    const uint64_t low = readInt();
+
+    return low | static_cast<uint64_t>(readInt()) << 32;
+}
+
+std::string StubPluginSnapshot::Decoder::readString()
+{
+    const uint32_t length = readInt();
+    const char* const chars = reinterpret_cast<const char*>(read(length));
+
+    return std::string(chars, length);
+}
+
+std::shared_ptr<StubSmartCard> StubPluginSnapshot::Decoder::readCard()
+{
+    const uint32_t reference = readInt();
+    if (reference > mCards.size()) {
+        throw IllegalArgumentException("Corrupted stub plugin snapshot");
+    }
+
+    return reference == 0 ? nullptr : mCards[reference - 1];
+}
+
+const std::vector<StubPluginSnapshot::ReaderState> StubPluginSnapshot::Decoder::readReaders()
+{
+    const uint32_t readerCount = readInt();
+
+    std::vector<ReaderState> readers;
+    for (uint32_t i = 0; i < readerCount; i++) {
+        ReaderState reader;
+        reader.mName = readString();
+        reader.mIsContactless = readInt() != 0;
+
+        /* Bits of the snapshot translated into bits of the current process */
+        const uint64_t protocols = readLong();
+        reader.mActivatedProtocols = 0;
+        for (std::size_t bit = 0; bit < 64; bit++) {
+            if ((protocols >> bit) & 1) {
+                if (bit >= mProtocolBits.size()) {
+                    throw IllegalArgumentException("Corrupted stub plugin snapshot");
+                }
+                if (mProtocolBits[bit] != 0) {
+                    reader.mActivatedProtocols |= mProtocolBits[bit];
+                } else {
+                    reader.mOtherActivatedProtocols.push_back(mProtocols[bit]);
+                }
+            }
+        }
+
+        const uint32_t otherProtocolCount = readInt();
+        for (uint32_t j = 0; j < otherProtocolCount; j++) {
+            reader.mOtherActivatedProtocols.push_back(readString());
+        }
+
+        reader.mCard = readCard();
+        readers.push_back(reader);
+    }
+
+    return readers;
+}
+
+void StubPluginSnapshot::Decoder::checkEnd() const
+{
+    if (mOffset != mSnapshot.size()) {
+        throw IllegalArgumentException("Corrupted stub plugin snapshot");
+    }
+}
+
+const uint8_t* StubPluginSnapshot::Decoder::read(const std::size_t length)
+{
+    if (length > mSnapshot.size() - mOffset) {
+        throw IllegalArgumentException("Truncated stub plugin snapshot");
+    }
+
+    const uint8_t* const bytes = mSnapshot.data() + mOffset;
+    mOffset += length;
+
+    return bytes;
+}
+
+}
+}
+}
@@ -0,0 +1,305 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+#include "StubReaderAdapter.h"
+#include "StubSmartCard.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+/**
+ * (package-private)<br>
+ * Binary encoding of the state of a stub plugin: its readers, the cards inserted in them and the
+ * simulated commands of the cards.
+ *
+ * <p>A snapshot starts with a versioned header followed by the tables shared by its content: the
+ * protocol names, the sets of simulated commands and the cards. A card inserted in several readers
+ * is saved once, as is a set of simulated commands shared by several cards (e.g. the copies of a
+ * card template). On restore, they are shared again rather than duplicated.
+ *
+ * <p>The content following the tables is written and read in sequence by the plugins.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubPluginSnapshot final {
+public:
+    /**
+     * Version of the format written by the encoder.
+     *
+     * @since 2.2.0
+     */
+    static const uint32_t FORMAT_VERSION;
+
+    /**
+     * (package-private)<br>
+     * State of a reader read from a snapshot.
+     *
+     * @since 2.2.0
+     */
+    struct ReaderState {
+        /**
+         *
+         */
+        std::string mName;
+
+        /**
+         *
+         */
+        bool mIsContactless;
+
+        /**
+         * Activated protocols, as bits of the protocols interned by the current process
+         */
+        uint64_t mActivatedProtocols;
+
+        /**
+         * Activated protocols without a bit in the current process
+         */
+        std::vector<std::string> mOtherActivatedProtocols;
+
+        /**
+         * Inserted card, can be null
+         */
+        std::shared_ptr<StubSmartCard> mCard;
+    };
+
+    /**
+     * (package-private)<br>
+     * Writes a snapshot.
+     *
+     * @since 2.2.0
+     */
+    class KEYPLEPLUGINSTUB_API Encoder final {
+    public:
+        /**
+         * (package-private)<br>
+         *
+         * @since 2.2.0
+         */
+        Encoder();
+
+        /**
+         * (package-private)<br>
+         * Appends an unsigned 32 bits integer.
+         *
+         * @since 2.2.0
+         */
+        void writeInt(const std::size_t value);
+
+        /**
+         * (package-private)<br>
+         * Appends an unsigned 64 bits integer.
+         *
+         * @since 2.2.0
+         */
+        void writeLong(const uint64_t value);
+
+        /**
+         * (package-private)<br>
+         * Appends a string, preceded by its length.
+         *
+         * @since 2.2.0
+         */
+        void writeString(const std::string& value);
+
+        /**
+         * (package-private)<br>
+         * Appends a reference to a card, adding the card to the table of the cards if it is seen
+         * for the first time.
+         *
+         * @param card the card (can be null)
+         * @throw IllegalStateException if the card gets its responses from an
+         *        ApduResponseProviderSpi or from a compiled profile
+         * @since 2.2.0
+         */
+        void writeCard(const std::shared_ptr<StubSmartCard> card);
+
+        /**
+         * (package-private)<br>
+         * Appends the state of readers.
+         *
+         * @param readers the readers
+         * @throw IllegalStateException if the card of a reader cannot be saved
+         * @since 2.2.0
+         */
+        void writeReaders(const std::vector<std::shared_ptr<StubReaderAdapter>>& readers);
+
+        /**
+         * (package-private)<br>
+         * Builds the snapshot: the header, the tables and the content written so far.
+         *
+         * @since 2.2.0
+         */
+        const std::vector<uint8_t> toBytes() const;
+
+    private:
+        /**
+         * Content written by the plugin
+         */
+        std::string mContent;
+
+        /**
+         * Cards in the order of the table, referenced by their index + 1
+         */
+        std::vector<std::shared_ptr<StubSmartCard>> mCards;
+
+        /**
+         *
+         */
+        std::map<const StubSmartCard*, std::size_t> mCardIndexes;
+
+        /**
+         * Sets of simulated commands in the order of the table
+         */
+        std::vector<std::shared_ptr<const StubCommandTable>> mCommandTables;
+
+        /**
+         *
+         */
+        std::map<const StubCommandTable*, std::size_t> mCommandTableIndexes;
+    };
+
+    /**
+     * (package-private)<br>
+     * Reads a snapshot. The tables are read, and the cards created, on construction.
+     *
+     * @since 2.2.0
+     */
+    class KEYPLEPLUGINSTUB_API Decoder final {
+    public:
+        /**
+         * (package-private)<br>
+         *
+         * @param snapshot the snapshot, which must outlive the decoder
+         * @throw IllegalArgumentException if the snapshot is not valid
+         * @since 2.2.0
+         */
+        explicit Decoder(const std::vector<uint8_t>& snapshot);
+
+        /**
+         * (package-private)<br>
+         *
+         * @throw IllegalArgumentException if the snapshot is truncated
+         * @since 2.2.0
+         */
+        uint32_t readInt();
+
+        /**
+         * (package-private)<br>
+         *
+         * @throw IllegalArgumentException if the snapshot is truncated
+         * @since 2.2.0
+         */
+        uint64_t readLong();
+
+        /**
+         * (package-private)<br>
+         *
+         * @throw IllegalArgumentException if the snapshot is truncated
+         * @since 2.2.0
+         */
+        std::string readString();
+
+        /**
+         * (package-private)<br>
+         *
+         * @return the card, shared by all its references, or null
+         * @throw IllegalArgumentException if the reference is not valid
+         * @since 2.2.0
+         */
+        std::shared_ptr<StubSmartCard> readCard();
+
+        /**
+         * (package-private)<br>
+         * Reads the state of the readers written by Encoder::writeReaders().
+         *
+         * @throw IllegalArgumentException if the snapshot is not valid
+         * @since 2.2.0
+         */
+        const std::vector<ReaderState> readReaders();
+
+        /**
+         * (package-private)<br>
+         * Checks that the whole snapshot has been read.
+         *
+         * @throw IllegalArgumentException if some content is left
+         * @since 2.2.0
+         */
+        void checkEnd() const;
+
+    private:
+        /**
+         *
+         */
+        const std::vector<uint8_t>& mSnapshot;
+
+        /**
+         * Offset of the next value to read
+         */
+        std::size_t mOffset;
+
+        /**
+         * Protocols of the snapshot
+         */
+        std::vector<std::string> mProtocols;
+
+        /**
+         * Bits of the current process for the protocols of the snapshot, 0 if none is left
+         */
+        std::vector<uint64_t> mProtocolBits;
+
+        /**
+         * Cards of the table, referenced by their index + 1
+         */
+        std::vector<std::shared_ptr<StubSmartCard>> mCards;
+
+        /**
+         * (private)<br>
+         * Gets a pointer on the next bytes to read and skips them.
+         *
+         * @throw IllegalArgumentException if the snapshot is truncated
+         */
+        const uint8_t* read(const std::size_t length);
+    };
+
+    /**
+     * (package-private)<br>
+     * Creates readers from their state read from a snapshot, in one slab per kind of reader.
+     *
+     * @param readerStates the state of the readers
+     * @return the readers
+     * @since 2.2.0
+     */
+    static const std::vector<std::shared_ptr<StubReaderAdapter>> createReaders(
+        const std::vector<ReaderState>& readerStates);
+
+private:
+    /**
+     * "KSPS"
+     */
+    static const uint32_t MAGIC;
+};
+
+}
+}
+}
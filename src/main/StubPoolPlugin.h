@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 /* Keyple Core Common */
 #include "KeyplePluginExtension.h"
 
@@ -56,6 +60,30 @@ public:
      * @since 2.0.0
      */
     virtual void unplugPoolReader(const std::string& readerName) = 0;
+
+    /**
+     * Plug synchronously several StubReader in the StubPoolPlugin, all associated to
+     * groupReference. The readers are created in a single block of memory and made available
+     * together. Names already plugged are ignored.
+     *
+     * @param groupReference group reference of the new stub readers (mandatory)
+     * @param readerNames names of the new stub readers (mandatory, unique)
+     * @param cards either empty (no card) or one card (nullable) per reader name, in the same
+     *        order
+     * @throw IllegalArgumentException if cards is neither empty nor as long as readerNames
+     * @since 2.2.0
+     */
+    virtual void plugPoolReaders(const std::string& groupReference,
+                                 const std::vector<std::string>& readerNames,
+                                 const std::vector<std::shared_ptr<StubSmartCard>>& cards) = 0;
+
+    /**
+     * Unplug synchronously several pool readers at once. Names matching no reader are ignored.
+     *
+     * @param readerNames names of the readers to be unplugged
+     * @since 2.2.0
+     */
+    virtual void unplugPoolReadersByName(const std::vector<std::string>& readerNames) = 0;
 };
 
 }
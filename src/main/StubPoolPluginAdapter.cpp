@@ -13,6 +13,12 @@
 #include "StubPoolPluginAdapter.h"
 
 #include <algorithm>
+#include <functional>
+#include <thread>
+#include <tuple>
+
+/* Keyple Plugin Stub */
+#include "StubTracer.h"
 
 /* Keyple Core Plugin */
 #include "PluginIOException.h"
@@ -29,28 +35,79 @@ using namespace keyple::core::plugin;
 using namespace keyple::core::util;
 using namespace keyple::core::util::cpp::exception;
 
+const int StubPoolPluginAdapter::TIMER_WHEEL_TICK_DURATION = 50;
+const std::size_t StubPoolPluginAdapter::TIMER_WHEEL_SIZE = 512;
+
+StubPoolPluginAdapter::ElasticGroup::ElasticGroup(
+  std::shared_ptr<StubElasticGroupConfiguration> configuration)
+: mConfiguration(configuration), mSize(0) {}
+
 StubPoolPluginAdapter::StubPoolPluginAdapter(
   const std::string& name,
   const std::vector<std::shared_ptr<StubPoolReaderConfiguration>>& readerConfigurations,
-  const int monitoringCycleDuration)
+  const int monitoringCycleDuration,
+  const std::vector<std::shared_ptr<StubElasticGroupConfiguration>>& elasticGroupConfigurations,
+  const std::size_t shardCount)
+: mLastElasticReader(0),
+  mLastIdleTimer(0),
+  mScaleUpCount(0),
+  mScaleDownCount(0),
+  mLastLease(0),
+  mReclaimedLeaseCount(0)
+#if defined(KEYPLE_STUB_METRICS)
+  , mAllocationMetrics(0)
+#endif
+  , mUnregistered(false)
 {
+    Assert::getInstance().greaterOrEqual(static_cast<int>(shardCount), 1, "shardCount");
+
+    for (std::size_t i = 0; i < shardCount; i++) {
+        mShards.push_back(std::unique_ptr<Shard>(new Shard()));
+    }
+
+    mStubPluginAdapter = std::make_shared<StubPluginAdapter>(
+                             name,
+                             std::vector<std::shared_ptr<StubReaderConfiguration>>(),
+                             monitoringCycleDuration);
+
     /*
-     * C++: cannot directly use readerConfigurations to build mStubPluginAdapter, need to cast
-     *      to a new sort of vector
+     * The configured readers are plugged in bulk straight from the configurations of the factory,
+     * without building an intermediate set of base class configurations
      */
-    std::vector<std::shared_ptr<StubReaderConfiguration>> configurations;
-    for (const auto &config : readerConfigurations) {
-        configurations.push_back(std::dynamic_pointer_cast<StubReaderConfiguration>(config));
+    std::vector<std::string> readerNames;
+    std::vector<std::shared_ptr<StubSmartCard>> cards;
+    readerNames.reserve(readerConfigurations.size());
+    cards.reserve(readerConfigurations.size());
+    for (const auto& readerConfiguration : readerConfigurations) {
+        readerNames.push_back(readerConfiguration->getName());
+        cards.push_back(readerConfiguration->getCard());
     }
 
-    mStubPluginAdapter = std::make_shared<StubPluginAdapter>(name,
-                                                             configurations,
-                                                             monitoringCycleDuration);
+    mStubPluginAdapter->plugReaders(readerNames, false, cards);
 
+    for (const auto& elasticGroupConfiguration : elasticGroupConfigurations) {
+        mElasticGroups.emplace(std::piecewise_construct,
+                               std::forward_as_tuple(elasticGroupConfiguration->getGroupReference()),
+                               std::forward_as_tuple(elasticGroupConfiguration));
+    }
+
+    /* The adapter is not shared yet, no lock is needed */
     for (const auto& readerConfiguration : readerConfigurations) {
-        mReaderToGroup.insert({readerConfiguration->getName(),
-                               readerConfiguration->getGroupReference()});
+        addPoolReader(readerConfiguration->getGroupReference(),
+                      readerConfiguration->getName(),
+                      readerConfiguration->getCard());
+    }
+
+    /* Plug the minimum number of readers of the elastic groups */
+    for (const auto& elasticGroup : mElasticGroups) {
+        const std::size_t minSize = elasticGroup.second.mConfiguration->getMinSize();
+        if (elasticGroup.second.mSize < minSize) {
+            scaleUp(elasticGroup.first, minSize - elasticGroup.second.mSize);
+        }
     }
+
+    /* Initial readers are not scaling events */
+    mScaleUpCount = 0;
 }
 
 const std::string& StubPoolPluginAdapter::getName() const
@@ -65,9 +122,13 @@ const std::vector<std::shared_ptr<ReaderSpi>> StubPoolPluginAdapter::searchAvail
 
 const std::vector<std::string> StubPoolPluginAdapter::getReaderGroupReferences() const
 {
+    const auto shardLocks = lockShards();
+
     std::vector<std::string> references;
-    for (const auto& ref : mReaderToGroup) {
-        references.push_back(ref.second);
+    for (const auto& shard : mShards) {
+        for (const auto& ref : shard->mPoolReaders) {
+            references.push_back(ref.second.mGroupReference);
+        }
     }
 
     return references;
@@ -76,23 +137,49 @@ const std::vector<std::string> StubPoolPluginAdapter::getReaderGroupReferences()
 std::shared_ptr<ReaderSpi> StubPoolPluginAdapter::allocateReader(
     const std::string& readerGroupReference)
 {
-    std::vector<std::string> candidateReadersName;
+    return allocateReader(readerGroupReference, 0);
+}
 
-    if (readerGroupReference == "") {
-        /* Every reader is candidate for allocation */
-        candidateReadersName = mStubPluginAdapter->searchAvailableReaderNames();
-    } else {
-        /* Only readers from the readerGroupReference are candidates for allocation */
-        candidateReadersName = listReadersByGroup(readerGroupReference);
-    }
-
-    /* Find the first non allocated reader among candidates */
-    for (const auto& readerName : candidateReadersName) {
-        /* Find if already existing */
-        const auto it = std::find(mAllocatedReaders.begin(), mAllocatedReaders.end(), readerName);
-        if (it == mAllocatedReaders.end()) {
-            mAllocatedReaders.push_back(readerName);
-            return mStubPluginAdapter->searchReader(readerName);
+std::shared_ptr<ReaderSpi> StubPoolPluginAdapter::allocateReader(
+    const std::string& readerGroupReference, const int leaseDuration)
+{
+#if defined(KEYPLE_STUB_TRACE)
+    const StubTracer::Scope scope("allocateReader", readerGroupReference);
+#endif
+
+#if defined(KEYPLE_STUB_METRICS)
+    /* Records the allocation as failed if it throws */
+    const StubMetrics::Timer timer(mAllocationMetrics);
+#endif
+
+    const std::size_t localShardIndex = getLocalShardIndex();
+
+    /* Local shard first, the other ones only when it has no available reader */
+    for (std::size_t i = 0; i < mShards.size(); i++) {
+        Shard& shard = *mShards[(localShardIndex + i) % mShards.size()];
+        std::lock_guard<std::mutex> lock(shard.mMutex);
+
+        /* Candidates are kept sorted, the first non allocated reader is the first candidate */
+        const std::set<std::string>& candidateReadersName =
+            getAvailableReaders(shard, readerGroupReference);
+        if (!candidateReadersName.empty()) {
+            return allocate(shard, *candidateReadersName.begin(), leaseDuration);
+        }
+    }
+
+    /* Slow path: plug a reader if the group is elastic */
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto shardLocks = lockShards();
+
+    if (countAvailableReaders(readerGroupReference) == 0) {
+        scaleUp(readerGroupReference, 1);
+    }
+
+    for (const auto& shard : mShards) {
+        const std::set<std::string>& candidateReadersName =
+            getAvailableReaders(*shard, readerGroupReference);
+        if (!candidateReadersName.empty()) {
+            return allocate(*shard, *candidateReadersName.begin(), leaseDuration);
         }
     }
 
@@ -100,60 +187,393 @@ std::shared_ptr<ReaderSpi> StubPoolPluginAdapter::allocateReader(
                             readerGroupReference);
 }
 
+const std::vector<std::shared_ptr<ReaderSpi>> StubPoolPluginAdapter::allocateReaders(
+    const std::string& readerGroupReference,
+    const std::size_t readerCount,
+    const int leaseDuration)
+{
+#if defined(KEYPLE_STUB_TRACE)
+    const StubTracer::Scope scope("allocateReaders", readerGroupReference);
+#endif
+
+#if defined(KEYPLE_STUB_METRICS)
+    const StubMetrics::Timer timer(mAllocationMetrics);
+#endif
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto shardLocks = lockShards();
+
+    /* All or nothing: checked before plugging anything */
+    const std::size_t availableReaderCount = countAvailableReaders(readerGroupReference);
+    if (availableReaderCount + getScaleUpCapacity(readerGroupReference) < readerCount) {
+        throw PluginIOException("Not enough readers available in the groupReference : " +
+                                readerGroupReference + " (requested: " +
+                                std::to_string(readerCount) + ", available: " +
+                                std::to_string(availableReaderCount) + ")");
+    }
+
+    if (availableReaderCount < readerCount) {
+        scaleUp(readerGroupReference, readerCount - availableReaderCount);
+    }
+
+    /* Pick the names first as allocating a reader removes it from the candidates */
+    std::vector<std::pair<Shard*, std::string>> readerNames;
+    readerNames.reserve(readerCount);
+    const std::size_t localShardIndex = getLocalShardIndex();
+    for (std::size_t i = 0; i < mShards.size() && readerNames.size() < readerCount; i++) {
+        Shard& shard = *mShards[(localShardIndex + i) % mShards.size()];
+        const std::set<std::string>& candidateReadersName =
+            getAvailableReaders(shard, readerGroupReference);
+        for (auto it = candidateReadersName.begin();
+             it != candidateReadersName.end() && readerNames.size() < readerCount;
+             ++it) {
+            readerNames.push_back({&shard, *it});
+        }
+    }
+
+    std::vector<std::shared_ptr<ReaderSpi>> readers;
+    readers.reserve(readerCount);
+    for (const auto& readerName : readerNames) {
+        readers.push_back(allocate(*readerName.first, readerName.second, leaseDuration));
+    }
+
+    return readers;
+}
+
 void StubPoolPluginAdapter::releaseReader(std::shared_ptr<ReaderSpi> readerSpi)
+{
+    releaseReaders({readerSpi});
+}
+
+void StubPoolPluginAdapter::releaseReaders(
+    const std::vector<std::shared_ptr<ReaderSpi>>& readerSpis)
+{
+    /* Check every reader before releasing any of them */
+    for (const auto& readerSpi : readerSpis) {
+        Assert::getInstance().notNull(readerSpi, "reader SPI");
+
+        const auto stub = std::dynamic_pointer_cast<StubReader>(readerSpi);
+        if (!stub) {
+            throw IllegalArgumentException("Can not release reader, Reader should be of type " \
+                                           "StubReader");
+        }
+    }
+
+    for (const auto& readerSpi : readerSpis) {
+#if defined(KEYPLE_STUB_TRACE)
+        const StubTracer::Scope scope("releaseReader", readerSpi->getName());
+#endif
+
+        Shard& shard = getShard(readerSpi->getName());
+        std::lock_guard<std::mutex> lock(shard.mMutex);
+
+        release(shard, readerSpi->getName());
+    }
+}
+
+void StubPoolPluginAdapter::renewLease(std::shared_ptr<ReaderSpi> readerSpi,
+                                       const int leaseDuration)
 {
     Assert::getInstance().notNull(readerSpi, "reader SPI");
 
-    const auto stub = std::dynamic_pointer_cast<StubReader>(readerSpi);
-    if (!stub) {
-        throw IllegalArgumentException("Can not release reader, Reader should be of type " \
-                                       "StubReader");
+    Shard& shard = getShard(readerSpi->getName());
+    std::lock_guard<std::mutex> lock(shard.mMutex);
+
+    if (shard.mAllocatedReaders.find(readerSpi->getName()) == shard.mAllocatedReaders.end()) {
+        throw IllegalArgumentException("Can not renew the lease, reader " + readerSpi->getName() +
+                                       " is not allocated");
     }
 
-    const auto it = std::find(mAllocatedReaders.begin(),
-                              mAllocatedReaders.end(),
-                              readerSpi->getName());
-    mAllocatedReaders.erase(it);
+    lease(shard, readerSpi->getName(), leaseDuration);
+}
+
+uint64_t StubPoolPluginAdapter::getReclaimedLeaseCount() const
+{
+    return mReclaimedLeaseCount;
+}
+
+uint64_t StubPoolPluginAdapter::getScaleUpCount() const
+{
+    return mScaleUpCount;
+}
+
+uint64_t StubPoolPluginAdapter::getScaleDownCount() const
+{
+    return mScaleDownCount;
+}
+
+const std::vector<uint8_t> StubPoolPluginAdapter::createSnapshot()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto shardLocks = lockShards();
+
+    StubPluginSnapshot::Encoder encoder;
+    mStubPluginAdapter->writeReaders(encoder);
+
+    encoder.writeLong(mLastElasticReader);
+
+    std::size_t poolReaderCount = 0;
+    for (const auto& shard : mShards) {
+        poolReaderCount += shard->mPoolReaders.size();
+    }
+
+    encoder.writeInt(poolReaderCount);
+    for (const auto& shard : mShards) {
+        for (const auto& poolReader : shard->mPoolReaders) {
+            encoder.writeString(poolReader.first);
+            encoder.writeString(poolReader.second.mGroupReference);
+            encoder.writeCard(poolReader.second.mCard);
+            encoder.writeInt(shard->mAllocatedReaders.count(poolReader.first));
+        }
+    }
+
+    return encoder.toBytes();
+}
+
+void StubPoolPluginAdapter::restoreSnapshot(const std::vector<uint8_t>& snapshot)
+{
+    struct PoolReaderState {
+        std::string mName;
+        std::string mGroupReference;
+        std::shared_ptr<StubSmartCard> mCard;
+        bool mIsAllocated;
+    };
+
+    /* Read the whole snapshot before changing anything */
+    StubPluginSnapshot::Decoder decoder(snapshot);
+    const std::vector<StubPluginSnapshot::ReaderState> readerStates = decoder.readReaders();
+    const uint64_t lastElasticReader = decoder.readLong();
+
+    std::set<std::string> readerNames;
+    for (const auto& readerState : readerStates) {
+        readerNames.insert(readerState.mName);
+    }
+
+    const uint32_t poolReaderCount = decoder.readInt();
+    std::vector<PoolReaderState> poolReaderStates;
+    for (uint32_t i = 0; i < poolReaderCount; i++) {
+        PoolReaderState poolReaderState;
+        poolReaderState.mName = decoder.readString();
+        poolReaderState.mGroupReference = decoder.readString();
+        poolReaderState.mCard = decoder.readCard();
+        poolReaderState.mIsAllocated = decoder.readInt() != 0;
+
+        if (readerNames.find(poolReaderState.mName) == readerNames.end()) {
+            throw IllegalArgumentException("Corrupted stub plugin snapshot, unknown pool " \
+                                           "reader " + poolReaderState.mName);
+        }
+
+        poolReaderStates.push_back(poolReaderState);
+    }
+
+    decoder.checkEnd();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto shardLocks = lockShards();
+
+    /* Pending timers find their lease or idle timer gone and do nothing */
+    for (const auto& shard : mShards) {
+        shard->mPoolReaders.clear();
+        shard->mAllocatedReaders.clear();
+        shard->mAvailableReaders.clear();
+        shard->mAvailableReadersByGroup.clear();
+        shard->mLeases.clear();
+    }
+
+    mPoolCards.clear();
+
+    for (auto& elasticGroup : mElasticGroups) {
+        elasticGroup.second.mSize = 0;
+    }
+
+    mStubPluginAdapter->restoreReaders(readerStates);
+    mLastElasticReader = lastElasticReader;
+
+    for (const auto& poolReaderState : poolReaderStates) {
+        addPoolReader(poolReaderState.mGroupReference,
+                      poolReaderState.mName,
+                      poolReaderState.mCard);
+
+        if (poolReaderState.mIsAllocated) {
+            allocate(getShard(poolReaderState.mName), poolReaderState.mName, 0);
+        }
+    }
+}
+
+const std::string StubPoolPluginAdapter::getPrometheusMetrics()
+{
+    StubPrometheusWriter writer;
+    mStubPluginAdapter->writeMetrics(writer);
+
+    /* Readers and allocated readers by group, one shard at a time */
+    std::map<std::string, std::pair<uint64_t, uint64_t>> groups;
+    for (const auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard->mMutex);
+        for (const auto& poolReader : shard->mPoolReaders) {
+            std::pair<uint64_t, uint64_t>& group = groups[poolReader.second.mGroupReference];
+            group.first++;
+            group.second += shard->mAllocatedReaders.count(poolReader.first);
+        }
+    }
+
+    const StubPrometheusWriter::Labels labels = {{"plugin", getName()}};
+
+    uint64_t readerCount = 0;
+    uint64_t allocatedReaderCount = 0;
+    writer.writeFamily("keyple_stub_pool_readers", "gauge", "Readers of the group.");
+    for (const auto& group : groups) {
+        writer.writeSample("keyple_stub_pool_readers",
+                           {{"plugin", getName()}, {"group", group.first}},
+                           group.second.first);
+        readerCount += group.second.first;
+        allocatedReaderCount += group.second.second;
+    }
+
+    writer.writeFamily("keyple_stub_pool_allocated_readers",
+                       "gauge",
+                       "Allocated readers of the group.");
+    for (const auto& group : groups) {
+        writer.writeSample("keyple_stub_pool_allocated_readers",
+                           {{"plugin", getName()}, {"group", group.first}},
+                           group.second.second);
+    }
+
+    writer.writeFamily("keyple_stub_pool_utilization",
+                       "gauge",
+                       "Ratio of allocated readers in the pool.");
+    writer.writeSample("keyple_stub_pool_utilization",
+                       labels,
+                       readerCount == 0 ? 0.0 : static_cast<double>(allocatedReaderCount) /
+                                                static_cast<double>(readerCount));
+
+    writer.writeFamily("keyple_stub_pool_scale_ups_total",
+                       "counter",
+                       "Readers plugged on demand in elastic groups.");
+    writer.writeSample("keyple_stub_pool_scale_ups_total", labels, getScaleUpCount());
+
+    writer.writeFamily("keyple_stub_pool_scale_downs_total",
+                       "counter",
+                       "Idle readers unplugged from elastic groups.");
+    writer.writeSample("keyple_stub_pool_scale_downs_total", labels, getScaleDownCount());
+
+    writer.writeFamily("keyple_stub_pool_reclaimed_leases_total",
+                       "counter",
+                       "Readers released on lease expiry.");
+    writer.writeSample("keyple_stub_pool_reclaimed_leases_total",
+                       labels,
+                       getReclaimedLeaseCount());
+
+#if defined(KEYPLE_STUB_METRICS)
+    StubMetrics::Histogram latency;
+    uint64_t failureCount;
+    mAllocationMetrics.getLatency(latency, failureCount);
+
+    writer.writeFamily("keyple_stub_pool_allocation_requests_total",
+                       "counter",
+                       "Allocation requests, of one or several readers.");
+    writer.writeSample("keyple_stub_pool_allocation_requests_total", labels, latency.getCount());
+
+    writer.writeFamily("keyple_stub_pool_allocation_failures_total",
+                       "counter",
+                       "Allocation requests failed for lack of available reader.");
+    writer.writeSample("keyple_stub_pool_allocation_failures_total", labels, failureCount);
+
+    writer.writeFamily("keyple_stub_pool_allocation_seconds",
+                       "summary",
+                       "Duration of the allocation requests, lock waits included.");
+    writer.writeSummary("keyple_stub_pool_allocation_seconds", labels, latency);
+#endif
+
+    return writer.toString();
+}
+
+void StubPoolPluginAdapter::writePrometheusMetrics(const std::string& path)
+{
+    StubPrometheusWriter::writeFile(path, getPrometheusMetrics());
 }
 
 void StubPoolPluginAdapter::onUnregister()
 {
-    /* NO-OP */
+    std::unique_ptr<StubTimerWheel> timerWheel;
+
+    {
+        std::lock_guard<std::mutex> lock(mTimerWheelMutex);
+        timerWheel = std::move(mTimerWheel);
+
+        /* A later release or renewal, or a running timer task, must not start a new wheel */
+        mUnregistered = true;
+    }
+
+    /* Stopped without the lock as a running timer task may be waiting for it */
+    if (timerWheel != nullptr) {
+        timerWheel->stop();
+    }
 }
 
 void StubPoolPluginAdapter::plugPoolReader(const std::string& groupReference,
                                            const std::string& readerName,
                                            std::shared_ptr<StubSmartCard> card)
 {
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::lock_guard<std::mutex> shardLock(getShard(readerName).mMutex);
+
     /* Create new reader */
     mStubPluginAdapter->plugReader(readerName, false, card);
 
     /* Map reader to groupReference */
-    mReaderToGroup.insert({readerName, groupReference});
+    addPoolReader(groupReference, readerName, card);
 }
 
 void StubPoolPluginAdapter::unplugPoolReaders(const std::string& groupReference)
 {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto shardLocks = lockShards();
+
     /* Find the reader in the readerPool */
     const std::vector<std::string> readerNames = listReadersByGroup(groupReference);
     for (const auto& readerName : readerNames) {
-        unplugPoolReader(readerName);
+        removePoolReader(readerName);
     }
+
+    mStubPluginAdapter->unplugReaders(readerNames);
 }
 
 void StubPoolPluginAdapter::unplugPoolReader(const std::string& readerName)
 {
-    /* Remove reader from pool */
-    mReaderToGroup.erase(mReaderToGroup.find(readerName));
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::lock_guard<std::mutex> shardLock(getShard(readerName).mMutex);
 
-    /* Remove reader from allocate list */
-    const auto it = std::find(mAllocatedReaders.begin(), mAllocatedReaders.end(), readerName);
-    if (it != mAllocatedReaders.end()) {
-        mAllocatedReaders.erase(it);
+    removePoolReader(readerName);
+    mStubPluginAdapter->unplugReader(readerName);
+}
+
+void StubPoolPluginAdapter::plugPoolReaders(
+    const std::string& groupReference,
+    const std::vector<std::string>& readerNames,
+    const std::vector<std::shared_ptr<StubSmartCard>>& cards)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto shardLocks = lockShards();
+
+    /* Create the readers at once, it checks the number of cards */
+    mStubPluginAdapter->plugReaders(readerNames, false, cards);
+
+    /* Map readers to groupReference */
+    for (std::size_t i = 0; i < readerNames.size(); i++) {
+        addPoolReader(groupReference, readerNames[i], cards.empty() ? nullptr : cards[i]);
     }
+}
 
-    /* Remove reader from plugin */
-    mStubPluginAdapter->unplugReader(readerName);
+void StubPoolPluginAdapter::unplugPoolReadersByName(const std::vector<std::string>& readerNames)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto shardLocks = lockShards();
+
+    for (const auto& readerName : readerNames) {
+        removePoolReader(readerName);
+    }
+
+    mStubPluginAdapter->unplugReaders(readerNames);
 }
 
 int StubPoolPluginAdapter::getMonitoringCycleDuration() const
@@ -171,23 +591,324 @@ std::shared_ptr<ReaderSpi> StubPoolPluginAdapter::searchReader(const std::string
     return mStubPluginAdapter->searchReader(readerName);
 }
 
+StubPoolPluginAdapter::Shard& StubPoolPluginAdapter::getShard(const std::string& readerName) const
+{
+    return *mShards[std::hash<std::string>()(readerName) % mShards.size()];
+}
+
+std::size_t StubPoolPluginAdapter::getLocalShardIndex() const
+{
+    /* Threads are spread over the shards, approximating one shard per core */
+    return std::hash<std::thread::id>()(std::this_thread::get_id()) % mShards.size();
+}
+
+std::vector<std::unique_lock<std::mutex>> StubPoolPluginAdapter::lockShards() const
+{
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(mShards.size());
+    for (const auto& shard : mShards) {
+        locks.push_back(std::unique_lock<std::mutex>(shard->mMutex));
+    }
+
+    return locks;
+}
+
 const std::vector<std::string> StubPoolPluginAdapter::listReadersByGroup(
     const std::string& aGroupReference)
 {
     std::vector<std::string> readers;
 
     /* Find the reader in the readerPool */
-    for (const auto& entry : mReaderToGroup) {
-        const std::string readerName = entry.first;
-        const std::string groupReference = entry.second;
-        if (groupReference == aGroupReference) {
-            readers.push_back(readerName);
+    for (const auto& shard : mShards) {
+        for (const auto& entry : shard->mPoolReaders) {
+            const std::string readerName = entry.first;
+            const std::string groupReference = entry.second.mGroupReference;
+            if (groupReference == aGroupReference) {
+                readers.push_back(readerName);
+            }
         }
     }
 
     return readers;
 }
 
+const std::set<std::string>& StubPoolPluginAdapter::getAvailableReaders(
+    const Shard& shard, const std::string& readerGroupReference)
+{
+    static const std::set<std::string> noReader;
+
+    if (readerGroupReference == "") {
+        /* Every reader is candidate for allocation */
+        return shard.mAvailableReaders;
+    }
+
+    /* Only readers from the readerGroupReference are candidates for allocation */
+    const auto it = shard.mAvailableReadersByGroup.find(readerGroupReference);
+
+    return it != shard.mAvailableReadersByGroup.end() ? it->second : noReader;
+}
+
+std::size_t StubPoolPluginAdapter::countAvailableReaders(
+    const std::string& readerGroupReference) const
+{
+    std::size_t count = 0;
+    for (const auto& shard : mShards) {
+        count += getAvailableReaders(*shard, readerGroupReference).size();
+    }
+
+    return count;
+}
+
+void StubPoolPluginAdapter::addPoolReader(const std::string& groupReference,
+                                          const std::string& readerName,
+                                          std::shared_ptr<StubSmartCard> card)
+{
+    Shard& shard = getShard(readerName);
+
+    if (shard.mPoolReaders.find(readerName) != shard.mPoolReaders.end()) {
+        /* Reader names are unique, the reader is already part of the pool */
+        return;
+    }
+
+    /* Keep the reader at hand, allocating and releasing it do not need to search it */
+    const auto reader =
+        std::dynamic_pointer_cast<StubReaderAdapter>(mStubPluginAdapter->searchReader(readerName));
+
+    /* Release resets the card of the reader in place, it must not be used by another one */
+    if (card != nullptr && !mPoolCards.insert(card.get()).second) {
+        card = card->copy();
+        mPoolCards.insert(card.get());
+        reader->reset(card);
+    }
+
+    shard.mPoolReaders.insert({readerName, {groupReference, reader, card, 0}});
+
+    const auto elasticGroup = mElasticGroups.find(groupReference);
+    if (elasticGroup != mElasticGroups.end()) {
+        elasticGroup->second.mSize++;
+    }
+
+    shard.mAvailableReaders.insert(readerName);
+    shard.mAvailableReadersByGroup[groupReference].insert(readerName);
+}
+
+void StubPoolPluginAdapter::removePoolReader(const std::string& readerName)
+{
+    Shard& shard = getShard(readerName);
+
+    /* Remove reader from pool */
+    const auto it = shard.mPoolReaders.find(readerName);
+    if (it != shard.mPoolReaders.end()) {
+        const auto elasticGroup = mElasticGroups.find(it->second.mGroupReference);
+        if (elasticGroup != mElasticGroups.end()) {
+            elasticGroup->second.mSize--;
+        }
+
+        shard.mAvailableReadersByGroup[it->second.mGroupReference].erase(readerName);
+        mPoolCards.erase(it->second.mCard.get());
+        shard.mPoolReaders.erase(it);
+    }
+
+    /* Remove reader from allocate list */
+    shard.mAllocatedReaders.erase(readerName);
+    shard.mAvailableReaders.erase(readerName);
+    shard.mLeases.erase(readerName);
+}
+
+std::shared_ptr<ReaderSpi> StubPoolPluginAdapter::allocate(Shard& shard,
+                                                           const std::string readerName,
+                                                           const int leaseDuration)
+{
+    /* readerName is a copy as the caller may pass an element of the sets updated below */
+    const PoolReader& poolReader = shard.mPoolReaders[readerName];
+
+    shard.mAvailableReaders.erase(readerName);
+    shard.mAvailableReadersByGroup[poolReader.mGroupReference].erase(readerName);
+    shard.mAllocatedReaders.insert(readerName);
+
+    lease(shard, readerName, leaseDuration);
+
+    return poolReader.mReader;
+}
+
+void StubPoolPluginAdapter::release(Shard& shard, const std::string& readerName)
+{
+    if (shard.mAllocatedReaders.erase(readerName) == 0) {
+        /* Not allocated, nothing to release */
+        return;
+    }
+
+    shard.mLeases.erase(readerName);
+
+    const auto it = shard.mPoolReaders.find(readerName);
+    if (it != shard.mPoolReaders.end()) {
+        /*
+         * Give the next user the reader as it was configured, whatever the last user did. The
+         * configured card is held by this reader only, it is reinserted with its channel closed.
+         */
+        it->second.mReader->reset(it->second.mCard);
+
+        shard.mAvailableReaders.insert(readerName);
+        shard.mAvailableReadersByGroup[it->second.mGroupReference].insert(readerName);
+
+        /* An extra reader of an elastic group is unplugged if it stays idle */
+        const auto elasticGroup = mElasticGroups.find(it->second.mGroupReference);
+        if (elasticGroup != mElasticGroups.end() &&
+            elasticGroup->second.mSize > elasticGroup->second.mConfiguration->getMinSize()) {
+            startIdleTimer(readerName, it->second, elasticGroup->second);
+        }
+    }
+}
+
+std::size_t StubPoolPluginAdapter::getScaleUpCapacity(
+    const std::string& readerGroupReference) const
+{
+    const auto it = mElasticGroups.find(readerGroupReference);
+    if (it == mElasticGroups.end()) {
+        return 0;
+    }
+
+    const std::size_t maxSize = it->second.mConfiguration->getMaxSize();
+
+    return it->second.mSize >= maxSize ? 0 : maxSize - it->second.mSize;
+}
+
+void StubPoolPluginAdapter::scaleUp(const std::string& readerGroupReference,
+                                    const std::size_t readerCount)
+{
+    const auto it = mElasticGroups.find(readerGroupReference);
+    if (it == mElasticGroups.end()) {
+        return;
+    }
+
+    /* Up to the maximum size, the caller checks whether it got enough readers */
+    const std::size_t count = std::min(readerCount, getScaleUpCapacity(readerGroupReference));
+    if (count == 0) {
+        return;
+    }
+
+    const std::shared_ptr<StubSmartCard> cardTemplate = it->second.mConfiguration->getCardTemplate();
+
+    std::vector<std::string> readerNames;
+    std::vector<std::shared_ptr<StubSmartCard>> cards;
+    readerNames.reserve(count);
+    cards.reserve(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        std::string readerName;
+        do {
+            readerName = readerGroupReference + "#" + std::to_string(++mLastElasticReader);
+        } while (mStubPluginAdapter->searchReader(readerName) != nullptr);
+
+        readerNames.push_back(readerName);
+
+        /* The copy shares the simulated commands of the template */
+        cards.push_back(cardTemplate != nullptr ? cardTemplate->copy() : nullptr);
+    }
+
+    mStubPluginAdapter->plugReaders(readerNames, false, cards);
+
+    for (std::size_t i = 0; i < count; i++) {
+        addPoolReader(readerGroupReference, readerNames[i], cards[i]);
+
+        /* Unplugged if the caller cannot use it, e.g. not enough readers could be plugged */
+        if (it->second.mSize > it->second.mConfiguration->getMinSize()) {
+            startIdleTimer(readerNames[i],
+                           getShard(readerNames[i]).mPoolReaders.at(readerNames[i]),
+                           it->second);
+        }
+    }
+
+    mScaleUpCount += count;
+}
+
+void StubPoolPluginAdapter::onIdleTimerExpired(const std::string& readerName,
+                                               const uint64_t idleTimer)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    Shard& shard = getShard(readerName);
+    std::lock_guard<std::mutex> shardLock(shard.mMutex);
+
+    const auto it = shard.mPoolReaders.find(readerName);
+    if (it == shard.mPoolReaders.end() ||
+        it->second.mIdleTimer != idleTimer ||
+        shard.mAllocatedReaders.find(readerName) != shard.mAllocatedReaders.end()) {
+        /* Unplugged, allocated or released again in the meantime */
+        return;
+    }
+
+    const ElasticGroup& elasticGroup = mElasticGroups.at(it->second.mGroupReference);
+    if (elasticGroup.mSize <= elasticGroup.mConfiguration->getMinSize()) {
+        return;
+    }
+
+    removePoolReader(readerName);
+    mStubPluginAdapter->unplugReader(readerName);
+
+    mScaleDownCount++;
+}
+
+void StubPoolPluginAdapter::startIdleTimer(const std::string& readerName,
+                                           PoolReader& poolReader,
+                                           const ElasticGroup& elasticGroup)
+{
+    const uint64_t idleTimer = ++mLastIdleTimer;
+    poolReader.mIdleTimer = idleTimer;
+    schedule(elasticGroup.mConfiguration->getIdleCooldown(), [this, readerName, idleTimer] {
+        onIdleTimerExpired(readerName, idleTimer);
+    });
+}
+
+void StubPoolPluginAdapter::schedule(const int delay, const StubTimerWheel::Task& task)
+{
+    std::lock_guard<std::mutex> lock(mTimerWheelMutex);
+
+    if (mUnregistered) {
+        return;
+    }
+
+    if (mTimerWheel == nullptr) {
+        mTimerWheel = std::unique_ptr<StubTimerWheel>(
+                          new StubTimerWheel(TIMER_WHEEL_TICK_DURATION, TIMER_WHEEL_SIZE));
+    }
+
+    mTimerWheel->schedule(delay, task);
+}
+
+void StubPoolPluginAdapter::lease(Shard& shard,
+                                  const std::string& readerName,
+                                  const int leaseDuration)
+{
+    if (leaseDuration <= 0) {
+        shard.mLeases.erase(readerName);
+        return;
+    }
+
+    /* A renewal replaces the lease, the timer of the previous one will find it outdated */
+    const uint64_t leaseId = ++mLastLease;
+    shard.mLeases[readerName] = leaseId;
+
+    schedule(leaseDuration, [this, readerName, leaseId] {
+        onLeaseExpired(readerName, leaseId);
+    });
+}
+
+void StubPoolPluginAdapter::onLeaseExpired(const std::string& readerName, const uint64_t leaseId)
+{
+    Shard& shard = getShard(readerName);
+    std::lock_guard<std::mutex> lock(shard.mMutex);
+
+    const auto it = shard.mLeases.find(readerName);
+    if (it == shard.mLeases.end() || it->second != leaseId) {
+        /* Released or renewed in the meantime */
+        return;
+    }
+
+    release(shard, readerName);
+
+    mReclaimedLeaseCount++;
+}
+
 }
 }
 }
@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -23,6 +27,7 @@
 #include "StubPoolPlugin.h"
 #include "StubPoolPluginFactoryAdapter.h"
 #include "StubSmartCard.h"
+#include "StubTimerWheel.h"
 
 /* Keyple Core Plugin */
 #include "ObservablePluginSpi.h"
@@ -35,11 +40,18 @@ namespace stub {
 using namespace keyple::core::plugin::spi;
 
 using StubPoolReaderConfiguration = StubPoolPluginFactoryAdapter::StubPoolReaderConfiguration;
+using StubElasticGroupConfiguration = StubPoolPluginFactoryAdapter::StubElasticGroupConfiguration;
 
 /**
  * (package-private)<br>
  * Internal adapter of the {@link StubPoolPlugin}
  *
+ * <p>The readers can be partitioned into several shards, each with its own lock. A reader belongs
+ * to the shard given by the hash of its name, a thread allocates from the shard given by the hash
+ * of its id and takes readers from the other shards only when its own has none available.
+ * Operations involving several readers (batch allocation, scale-up, unplug of a group) lock all
+ * shards.
+ *
  * @since 2.0.0
  */
 class KEYPLEPLUGINSTUB_API StubPoolPluginAdapter
@@ -51,12 +63,18 @@ public:
      * @param name name of the plugin
      * @param readerConfigurations configurations of the reader to plug initially
      * @param monitoringCycleDuration duration between two monitoring cycle
+     * @param elasticGroupConfigurations groups whose size follows the demand (since 2.2.0)
+     * @param shardCount number of shards the readers are partitioned into (since 2.2.0)
      * @since 2.0.0
      */
     StubPoolPluginAdapter(
         const std::string& name,
         const std::vector<std::shared_ptr<StubPoolReaderConfiguration>>& readerConfigurations,
-        const int monitoringCycleDuration);
+        const int monitoringCycleDuration,
+        const std::vector<std::shared_ptr<StubElasticGroupConfiguration>>&
+            elasticGroupConfigurations =
+                std::vector<std::shared_ptr<StubElasticGroupConfiguration>>(),
+        const std::size_t shardCount = 1);
 
     /**
      * {@inheritDoc}
@@ -86,6 +104,21 @@ public:
      */
     std::shared_ptr<ReaderSpi> allocateReader(const std::string& readerGroupReference) override;
 
+    /**
+     * (package-private)<br>
+     * Allocates a reader for a limited duration. If the lease is not renewed with renewLease()
+     * before it expires, the reader is automatically released and its card state is reset.
+     *
+     * @param readerGroupReference reference of the group to allocate the reader from (empty to
+     *        allocate a reader from any group)
+     * @param leaseDuration duration of the lease in milliseconds, 0 for an unlimited allocation
+     * @return the allocated reader
+     * @throw PluginIOException if no reader is available in the group
+     * @since 2.2.0
+     */
+    std::shared_ptr<ReaderSpi> allocateReader(const std::string& readerGroupReference,
+                                              const int leaseDuration);
+
     /**
      * {@inheritDoc}
      *
@@ -93,6 +126,131 @@ public:
      */
     void releaseReader(std::shared_ptr<ReaderSpi> readerSpi) override;
 
+    /**
+     * (package-private)<br>
+     * Allocates several readers of a group in one pass. The allocation is all-or-nothing: if the
+     * group does not have enough available readers, no reader is allocated.
+     *
+     * @param readerGroupReference reference of the group to allocate the readers from (empty to
+     *        allocate readers from any group)
+     * @param readerCount number of readers to allocate
+     * @param leaseDuration duration of the lease of each reader in milliseconds, 0 (default) for
+     *        an unlimited allocation
+     * @return the allocated readers
+     * @throw PluginIOException if less than readerCount readers are available in the group
+     * @since 2.2.0
+     */
+    const std::vector<std::shared_ptr<ReaderSpi>> allocateReaders(
+        const std::string& readerGroupReference,
+        const std::size_t readerCount,
+        const int leaseDuration = 0);
+
+    /**
+     * (package-private)<br>
+     * Releases several readers in one pass. All readers are checked before any of them is
+     * released, so an invalid reader leaves the allocations untouched. Readers which are not
+     * allocated are ignored.
+     *
+     * @param readerSpis the readers to release
+     * @throw IllegalArgumentException if one of the readers is null or is not a StubReader
+     * @since 2.2.0
+     */
+    void releaseReaders(const std::vector<std::shared_ptr<ReaderSpi>>& readerSpis);
+
+    /**
+     * (package-private)<br>
+     * Renews the lease of an allocated reader, the new lease starts now. A reader allocated
+     * without lease becomes leased.
+     *
+     * @param readerSpi the allocated reader
+     * @param leaseDuration duration of the new lease in milliseconds, 0 to remove the lease
+     * @throw IllegalArgumentException if the reader is null or not allocated (e.g. its lease
+     *        already expired)
+     * @since 2.2.0
+     */
+    void renewLease(std::shared_ptr<ReaderSpi> readerSpi, const int leaseDuration);
+
+    /**
+     * (package-private)<br>
+     * Gets the number of leases which expired and whose reader has been reclaimed.
+     *
+     * @return a positive number
+     * @since 2.2.0
+     */
+    uint64_t getReclaimedLeaseCount() const;
+
+    /**
+     * (package-private)<br>
+     * Gets the number of readers plugged on demand in elastic groups.
+     *
+     * @return a positive number
+     * @since 2.2.0
+     */
+    uint64_t getScaleUpCount() const;
+
+    /**
+     * (package-private)<br>
+     * Gets the number of idle readers unplugged from elastic groups.
+     *
+     * @return a positive number
+     * @since 2.2.0
+     */
+    uint64_t getScaleDownCount() const;
+
+    /**
+     * (package-private)<br>
+     * Saves the state of the pool: the state of its readers as saved by
+     * StubPluginAdapter::createSnapshot(), their group, the card they get back on release and
+     * whether they are allocated.
+     *
+     * <p>Leases are not saved, the readers allocated with a lease are saved as allocated without
+     * lease.
+     *
+     * @return the snapshot
+     * @throw IllegalStateException if a card gets its responses from an ApduResponseProviderSpi
+     *        or from a compiled profile
+     * @since 2.2.0
+     */
+    const std::vector<uint8_t> createSnapshot();
+
+    /**
+     * (package-private)<br>
+     * Replaces the readers of the pool by those of a snapshot, in their allocation state. The
+     * readers are created at once, without going through the pool API. The elastic groups keep
+     * their configuration, their size being the number of their restored readers. The pool is left
+     * untouched if the snapshot is not valid.
+     *
+     * @param snapshot a snapshot created by createSnapshot()
+     * @throw IllegalArgumentException if the snapshot is not valid
+     * @since 2.2.0
+     */
+    void restoreSnapshot(const std::vector<uint8_t>& snapshot);
+
+    /**
+     * (package-private)<br>
+     * Renders the metrics of the pool in the Prometheus text format: the metrics of its readers,
+     * as rendered by StubPluginAdapter::getPrometheusMetrics(), the readers and allocated readers
+     * of each group, the utilization of the pool, the scaling and reclaim counters and, if the
+     * library is built with KEYPLE_STUB_METRICS defined, the allocation requests, their failures
+     * and their duration, lock waits included.
+     *
+     * <p>The shards are locked one after the other, allocations go on in the other shards.
+     *
+     * @return the metrics
+     * @since 2.2.0
+     */
+    const std::string getPrometheusMetrics();
+
+    /**
+     * (package-private)<br>
+     * Writes the metrics rendered by getPrometheusMetrics() to a file, replacing it at once.
+     *
+     * @param path the path of the file
+     * @throw IllegalArgumentException if the file cannot be written
+     * @since 2.2.0
+     */
+    void writePrometheusMetrics(const std::string& path);
+
     /**
      * {@inheritDoc}
      *
@@ -123,6 +281,22 @@ public:
      */
     void unplugPoolReader(const std::string& readerName) override;
 
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void plugPoolReaders(const std::string& groupReference,
+                         const std::vector<std::string>& readerNames,
+                         const std::vector<std::shared_ptr<StubSmartCard>>& cards) override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void unplugPoolReadersByName(const std::vector<std::string>& readerNames) override;
+
     /**
      * {@inheritDoc}
      *
@@ -145,28 +319,333 @@ public:
     std::shared_ptr<ReaderSpi> searchReader(const std::string& readerName) override;
 
 private:
+    /**
+     * (private)<br>
+     * A reader of the pool
+     */
+    struct PoolReader {
+        /**
+         *
+         */
+        std::string mGroupReference;
+
+        /**
+         *
+         */
+        std::shared_ptr<StubReaderAdapter> mReader;
+
+        /**
+         * Card inserted when the reader has been plugged, held by no other pool reader
+         */
+        std::shared_ptr<StubSmartCard> mCard;
+
+        /**
+         * Identifier of the idle timer started by the last release, 0 if none
+         */
+        uint64_t mIdleTimer;
+    };
+
+    /**
+     * (private)<br>
+     * A partition of the readers of the pool, guarded by its own lock
+     */
+    struct Shard {
+        /**
+         * Guards the state of the shard
+         */
+        std::mutex mMutex;
+
+        /**
+         * Readers of the shard by their readerName
+         */
+        std::map<std::string, PoolReader> mPoolReaders;
+
+        /**
+         * List of allocated readers by their readerName
+         */
+        std::set<std::string> mAllocatedReaders;
+
+        /**
+         * Non allocated readers, all groups included
+         */
+        std::set<std::string> mAvailableReaders;
+
+        /**
+         * Non allocated readers by group reference
+         */
+        std::map<std::string, std::set<std::string>> mAvailableReadersByGroup;
+
+        /**
+         * Current lease of the leased readers, by reader name
+         */
+        std::map<std::string, uint64_t> mLeases;
+    };
+
+    /**
+     * (private)<br>
+     * State of a group whose size follows the demand
+     */
+    struct ElasticGroup {
+        /**
+         *
+         */
+        explicit ElasticGroup(std::shared_ptr<StubElasticGroupConfiguration> configuration);
+
+        /**
+         *
+         */
+        const std::shared_ptr<StubElasticGroupConfiguration> mConfiguration;
+
+        /**
+         * Number of readers in the group, updated with mMutex held
+         */
+        std::atomic<std::size_t> mSize;
+    };
+
     /**
      *
      */
     std::shared_ptr<StubPluginAdapter> mStubPluginAdapter;
 
     /**
+     * Guards the structure of the pool (plugged readers and size of the groups), taken before
+     * any shard lock
+     */
+    std::mutex mMutex;
+
+    /**
+     * Never empty
+     */
+    std::vector<std::unique_ptr<Shard>> mShards;
+
+    /**
+     * Cards of the pool readers, updated with mMutex held
+     */
+    std::set<const StubSmartCard*> mPoolCards;
+
+    /**
+     * Elastic groups by group reference, the map is not modified after construction
+     */
+    std::map<std::string, ElasticGroup> mElasticGroups;
+
+    /**
+     * Suffix of the name of the last reader plugged on demand, updated with mMutex held
+     */
+    uint64_t mLastElasticReader;
+
+    /**
+     * Identifier of the last idle timer
+     */
+    std::atomic<uint64_t> mLastIdleTimer;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mScaleUpCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mScaleDownCount;
+
+    /**
+     * Identifier of the last granted lease
+     */
+    std::atomic<uint64_t> mLastLease;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mReclaimedLeaseCount;
+
+#if defined(KEYPLE_STUB_METRICS)
+    /**
+     * Allocation requests, failed if no reader could be allocated
+     */
+    StubMetrics::Recorder mAllocationMetrics;
+#endif
+
+    /**
+     * Guards mTimerWheel and mUnregistered, may be taken with a shard lock held
+     */
+    std::mutex mTimerWheelMutex;
+
+    /**
+     * Set by onUnregister(), no timer is scheduled anymore
+     */
+    bool mUnregistered;
+
+    /**
+     * Reclaims expired leases and unplugs idle elastic readers, created on first use. Declared
+     * last so that it is stopped before the state it accesses is destroyed.
+     */
+    std::unique_ptr<StubTimerWheel> mTimerWheel;
+
+    /**
+     * Resolution of the timer wheel in milliseconds
+     */
+    static const int TIMER_WHEEL_TICK_DURATION;
+
+    /**
+     * Number of slots of the timer wheel
+     */
+    static const std::size_t TIMER_WHEEL_SIZE;
+
+    /**
+     * (private) gets the shard a reader belongs to
      *
+     * @param readerName name of the reader
+     * @return the shard of the reader
      */
-    std::map<std::string, std::string> mReaderToGroup;
+    Shard& getShard(const std::string& readerName) const;
 
     /**
-     * List of allocated readers by their readerName
+     * (private) gets the index of the shard the calling thread allocates from first
+     *
+     * @return a shard index
+     */
+    std::size_t getLocalShardIndex() const;
+
+    /**
+     * (private) locks all shards, in index order
+     *
+     * @return the locks
      */
-    std::vector<std::string> mAllocatedReaders;
+    std::vector<std::unique_lock<std::mutex>> lockShards() const;
 
     /**
-     * (private) lists all readers that match a group reference
+     * (private) lists all readers that match a group reference, all shard locks must be held
      *
      * @param aGroupReference not nullable reference to a group reference
      * @return collection of reader names
      */
     const std::vector<std::string> listReadersByGroup(const std::string& aGroupReference);
+
+    /**
+     * (private) gets the non allocated readers of a group in a shard, the shard lock must be held
+     *
+     * @param shard the shard
+     * @param readerGroupReference group reference, empty for all groups
+     * @return the names of the available readers, sorted
+     */
+    static const std::set<std::string>& getAvailableReaders(
+        const Shard& shard, const std::string& readerGroupReference);
+
+    /**
+     * (private) counts the non allocated readers of a group, all shard locks must be held
+     *
+     * @param readerGroupReference group reference, empty for all groups
+     * @return a number of readers
+     */
+    std::size_t countAvailableReaders(const std::string& readerGroupReference) const;
+
+    /**
+     * (private) adds a reader plugged in mStubPluginAdapter to the pool, mMutex and the lock of
+     * the shard of the reader must be held. A card already held by another pool reader is replaced
+     * by a copy, so that releasing a reader can reset its card in place.
+     *
+     * @param groupReference group of the reader
+     * @param readerName name of the reader
+     * @param card card inserted in the reader (can be null)
+     */
+    void addPoolReader(const std::string& groupReference,
+                       const std::string& readerName,
+                       std::shared_ptr<StubSmartCard> card);
+
+    /**
+     * (private) removes a reader from the pool, mMutex and the lock of the shard of the reader
+     * must be held. The reader is left plugged in mStubPluginAdapter, so that several readers can
+     * be unplugged at once
+     *
+     * @param readerName name of the reader
+     */
+    void removePoolReader(const std::string& readerName);
+
+    /**
+     * (private) marks an available reader as allocated, the shard lock must be held
+     *
+     * @param shard the shard of the reader
+     * @param readerName name of the reader
+     * @param leaseDuration duration of the lease in milliseconds, 0 for no lease
+     * @return the allocated reader
+     */
+    std::shared_ptr<ReaderSpi> allocate(Shard& shard,
+                                        const std::string readerName,
+                                        const int leaseDuration);
+
+    /**
+     * (private) marks an allocated reader as available and restores its pristine state, the
+     * shard lock must be held
+     *
+     * @param shard the shard of the reader
+     * @param readerName name of the reader
+     */
+    void release(Shard& shard, const std::string& readerName);
+
+    /**
+     * (private) gets the number of readers scaleUp() can still plug in a group, mMutex must be
+     * held
+     *
+     * @param readerGroupReference group reference
+     * @return 0 if the group is not elastic or has reached its maximum size
+     */
+    std::size_t getScaleUpCapacity(const std::string& readerGroupReference) const;
+
+    /**
+     * (private) plugs readers on demand in an elastic group, mMutex and all shard locks must be
+     * held. Nothing is plugged if the group is not elastic, and no more readers than allowed by its
+     * maximum size. The readers plugged above the minimum size are unplugged if not allocated
+     * before the idle cooldown.
+     *
+     * @param readerGroupReference group reference
+     * @param readerCount number of readers to plug
+     */
+    void scaleUp(const std::string& readerGroupReference, const std::size_t readerCount);
+
+    /**
+     * (private) unplugs a reader of an elastic group if it stayed idle since the timer started
+     *
+     * @param readerName name of the reader
+     * @param idleTimer the expired idle timer
+     */
+    void onIdleTimerExpired(const std::string& readerName, const uint64_t idleTimer);
+
+    /**
+     * (private) starts the idle timer of a reader of an elastic group
+     *
+     * @param readerName name of the reader
+     * @param poolReader the reader
+     * @param elasticGroup the elastic group of the reader
+     */
+    void startIdleTimer(const std::string& readerName,
+                        PoolReader& poolReader,
+                        const ElasticGroup& elasticGroup);
+
+    /**
+     * (private) schedules a task on the timer wheel, creating it if needed, does nothing once the
+     * plugin is unregistered
+     *
+     * @param delay delay in milliseconds before running the task
+     * @param task the task to run
+     */
+    void schedule(const int delay, const StubTimerWheel::Task& task);
+
+    /**
+     * (private) grants a new lease to an allocated reader, the shard lock must be held
+     *
+     * @param shard the shard of the reader
+     * @param readerName name of the reader
+     * @param leaseDuration duration of the lease in milliseconds, 0 for no lease
+     */
+    void lease(Shard& shard, const std::string& readerName, const int leaseDuration);
+
+    /**
+     * (private) releases a reader if its lease is still the expired one
+     *
+     * @param readerName name of the reader
+     * @param leaseId the expired lease
+     */
+    void onLeaseExpired(const std::string& readerName, const uint64_t leaseId);
 };
 
 }
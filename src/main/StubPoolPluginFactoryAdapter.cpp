@@ -29,6 +29,7 @@ using namespace keyple::core::common;
 using namespace keyple::core::plugin;
 
 using StubPoolReaderConfiguration = StubPoolPluginFactoryAdapter::StubPoolReaderConfiguration;
+using StubElasticGroupConfiguration = StubPoolPluginFactoryAdapter::StubElasticGroupConfiguration;
 
 /* STUB POOL READER CONFIGURATION --------------------------------------------------------------- */
 
@@ -43,14 +44,71 @@ const std::string& StubPoolReaderConfiguration::getGroupReference() const
     return mGroupReference;
 }
 
+/* STUB ELASTIC GROUP CONFIGURATION ------------------------------------------------------------- */
+
+StubElasticGroupConfiguration::StubElasticGroupConfiguration(
+  const std::string& groupReference,
+  const std::size_t minSize,
+  const std::size_t maxSize,
+  std::shared_ptr<StubSmartCard> cardTemplate,
+  const int idleCooldown)
+: mGroupReference(groupReference),
+  mMinSize(minSize),
+  mMaxSize(maxSize),
+  mCardTemplate(cardTemplate),
+  mIdleCooldown(idleCooldown) {}
+
+const std::string& StubElasticGroupConfiguration::getGroupReference() const
+{
+    return mGroupReference;
+}
+
+std::size_t StubElasticGroupConfiguration::getMinSize() const
+{
+    return mMinSize;
+}
+
+std::size_t StubElasticGroupConfiguration::getMaxSize() const
+{
+    return mMaxSize;
+}
+
+std::shared_ptr<StubSmartCard> StubElasticGroupConfiguration::getCardTemplate() const
+{
+    return mCardTemplate;
+}
+
+int StubElasticGroupConfiguration::getIdleCooldown() const
+{
+    return mIdleCooldown;
+}
+
 /* STUB POOL PLUGIN FACTORY ADAPTER ------------------------------------------------------------- */
 
 StubPoolPluginFactoryAdapter::StubPoolPluginFactoryAdapter(
   const std::string& pluginName,
   const std::vector<std::shared_ptr<StubPoolReaderConfiguration>>& readerConfigurations,
-  const int monitoringCycleDuration)
+  const int monitoringCycleDuration,
+  const std::vector<std::shared_ptr<StubElasticGroupConfiguration>>& elasticGroupConfigurations,
+  const std::size_t shardCount)
+: StubPoolPluginFactoryAdapter(
+      pluginName,
+      std::make_shared<const std::vector<std::shared_ptr<StubPoolReaderConfiguration>>>(
+          readerConfigurations),
+      monitoringCycleDuration,
+      elasticGroupConfigurations,
+      shardCount) {}
+
+StubPoolPluginFactoryAdapter::StubPoolPluginFactoryAdapter(
+  const std::string& pluginName,
+  const PoolReaderConfigurations& readerConfigurations,
+  const int monitoringCycleDuration,
+  const std::vector<std::shared_ptr<StubElasticGroupConfiguration>>& elasticGroupConfigurations,
+  const std::size_t shardCount)
 : mReaderConfigurations(readerConfigurations),
+  mElasticGroupConfigurations(elasticGroupConfigurations),
   mMonitoringCycleDuration(monitoringCycleDuration),
+  mShardCount(shardCount),
   mPluginName(pluginName) {}
 
 const std::string& StubPoolPluginFactoryAdapter::getPluginApiVersion() const
@@ -71,8 +129,10 @@ const std::string& StubPoolPluginFactoryAdapter::getPoolPluginName() const
 std::shared_ptr<PoolPluginSpi> StubPoolPluginFactoryAdapter::getPoolPlugin()
 {
     return std::make_shared<StubPoolPluginAdapter>(mPluginName,
-                                                   mReaderConfigurations,
-                                                   mMonitoringCycleDuration);
+                                                   *mReaderConfigurations,
+                                                   mMonitoringCycleDuration,
+                                                   mElasticGroupConfigurations,
+                                                   mShardCount);
 }
 
 }
@@ -70,6 +70,94 @@ public:
 
     };
 
+    /**
+     * (package-private)
+     *
+     * <p>Configuration of a reader group whose size follows the demand
+     *
+     * @since 2.2.0
+     */
+    class KEYPLEPLUGINSTUB_API StubElasticGroupConfiguration {
+    public:
+        /**
+         * (package-private) constructor for an elastic group configuration
+         *
+         * @param groupReference groupReference of the group (not nullable)
+         * @param minSize number of readers kept plugged in the group
+         * @param maxSize maximum number of readers of the group
+         * @param cardTemplate card copied into each reader plugged on demand (nullable)
+         * @param idleCooldown duration in milliseconds after which an idle reader above minSize
+         *        is unplugged
+         * @since 2.2.0
+         */
+        StubElasticGroupConfiguration(const std::string& groupReference,
+                                      const std::size_t minSize,
+                                      const std::size_t maxSize,
+                                      std::shared_ptr<StubSmartCard> cardTemplate,
+                                      const int idleCooldown);
+
+        /**
+         *
+         */
+        const std::string& getGroupReference() const;
+
+        /**
+         *
+         */
+        std::size_t getMinSize() const;
+
+        /**
+         *
+         */
+        std::size_t getMaxSize() const;
+
+        /**
+         *
+         */
+        std::shared_ptr<StubSmartCard> getCardTemplate() const;
+
+        /**
+         *
+         */
+        int getIdleCooldown() const;
+
+    private:
+        /**
+         *
+         */
+        const std::string mGroupReference;
+
+        /**
+         *
+         */
+        const std::size_t mMinSize;
+
+        /**
+         *
+         */
+        const std::size_t mMaxSize;
+
+        /**
+         *
+         */
+        const std::shared_ptr<StubSmartCard> mCardTemplate;
+
+        /**
+         *
+         */
+        const int mIdleCooldown;
+    };
+
+    /**
+     * (package-private)<br>
+     * Immutable set of reader configurations, shared by the builder, the factory and the plugins
+     * instead of being copied from one to the other.
+     *
+     * @since 2.2.0
+     */
+    using PoolReaderConfigurations =
+        std::shared_ptr<const std::vector<std::shared_ptr<StubPoolReaderConfiguration>>>;
+
     /**
      * (package-private)<br>
      * Creates an instance, sets the fields from the factory builder.
@@ -77,12 +165,38 @@ public:
      * @param pluginName name of the plugin
      * @param readerConfigurations readerConfigurations to be created at init
      * @param monitoringCycleDuration duration of each monitoring cycle
+     * @param elasticGroupConfigurations groups whose size follows the demand (since 2.2.0)
+     * @param shardCount number of shards of the pool state (since 2.2.0)
      * @since 2.0.0
      */
     StubPoolPluginFactoryAdapter(
         const std::string& pluginName,
         const std::vector<std::shared_ptr<StubPoolReaderConfiguration>>& readerConfigurations,
-        const int monitoringCycleDuration);
+        const int monitoringCycleDuration,
+        const std::vector<std::shared_ptr<StubElasticGroupConfiguration>>&
+            elasticGroupConfigurations =
+                std::vector<std::shared_ptr<StubElasticGroupConfiguration>>(),
+        const std::size_t shardCount = 1);
+
+    /**
+     * (package-private)<br>
+     * Creates an instance sharing the reader configurations of the factory builder.
+     *
+     * @param pluginName name of the plugin
+     * @param readerConfigurations readerConfigurations to be created at init (not null)
+     * @param monitoringCycleDuration duration of each monitoring cycle
+     * @param elasticGroupConfigurations groups whose size follows the demand
+     * @param shardCount number of shards of the pool state
+     * @since 2.2.0
+     */
+    StubPoolPluginFactoryAdapter(
+        const std::string& pluginName,
+        const PoolReaderConfigurations& readerConfigurations,
+        const int monitoringCycleDuration,
+        const std::vector<std::shared_ptr<StubElasticGroupConfiguration>>&
+            elasticGroupConfigurations =
+                std::vector<std::shared_ptr<StubElasticGroupConfiguration>>(),
+        const std::size_t shardCount = 1);
 
     /**
      * {@inheritDoc}
@@ -116,13 +230,23 @@ private:
     /**
      *
      */
-    const std::vector<std::shared_ptr<StubPoolReaderConfiguration>> mReaderConfigurations;
+    const PoolReaderConfigurations mReaderConfigurations;
+
+    /**
+     *
+     */
+    const std::vector<std::shared_ptr<StubElasticGroupConfiguration>> mElasticGroupConfigurations;
 
     /**
      *
      */
     const int mMonitoringCycleDuration;
 
+    /**
+     *
+     */
+    const std::size_t mShardCount;
+
     /**
      *
      */
@@ -12,6 +12,9 @@
 
 #include "StubPoolPluginFactoryBuilder.h"
 
+/* Keyple Core Util */
+#include "KeypleAssert.h"
+
 /* Keyple Plugin Stub */
 #include "StubPoolPluginFactoryAdapter.h"
 
@@ -20,17 +23,33 @@ namespace plugin {
 namespace stub {
 
 using Builder = StubPoolPluginFactoryBuilder::Builder;
+using namespace keyple::core::util;
+
 using StubPoolReaderConfiguration = StubPoolPluginFactoryAdapter::StubPoolReaderConfiguration;
+using StubElasticGroupConfiguration = StubPoolPluginFactoryAdapter::StubElasticGroupConfiguration;
 
 /* BUILDER -------------------------------------------------------------------------------------- */
 
-Builder::Builder() : mMonitoringCycleDuration(0) {}
+Builder::Builder()
+: mReaderConfigurations(
+      std::make_shared<std::vector<std::shared_ptr<StubPoolReaderConfiguration>>>()),
+  mReaderConfigurationsShared(false),
+  mMonitoringCycleDuration(0),
+  mShardCount(1) {}
 
 Builder& Builder::withStubReader(const std::string& groupReference,
                                  const std::string& name,
                                  std::shared_ptr<StubSmartCard> card)
 {
-    mReaderConfigurations.push_back(
+    /* Copy on write, the factories already built keep their configurations */
+    if (mReaderConfigurationsShared) {
+        mReaderConfigurations =
+            std::make_shared<std::vector<std::shared_ptr<StubPoolReaderConfiguration>>>(
+                *mReaderConfigurations);
+        mReaderConfigurationsShared = false;
+    }
+
+    mReaderConfigurations->push_back(
         std::make_shared<StubPoolReaderConfiguration>(groupReference, name, card));
 
     return *this;
@@ -43,12 +62,44 @@ Builder& Builder::withMonitoringCycleDuration(const int duration)
     return *this;
 }
 
+Builder& Builder::withElasticReaderGroup(const std::string& groupReference,
+                                         const std::size_t minSize,
+                                         const std::size_t maxSize,
+                                         std::shared_ptr<StubSmartCard> cardTemplate,
+                                         const int idleCooldown)
+{
+    Assert::getInstance().isTrue(maxSize >= 1 && maxSize >= minSize, "maxSize >= minSize")
+                         .greaterOrEqual(idleCooldown, 0, "idleCooldown");
+
+    mElasticGroupConfigurations.push_back(
+        std::make_shared<StubElasticGroupConfiguration>(groupReference,
+                                                        minSize,
+                                                        maxSize,
+                                                        cardTemplate,
+                                                        idleCooldown));
+
+    return *this;
+}
+
+Builder& Builder::withShardCount(const std::size_t shardCount)
+{
+    Assert::getInstance().isTrue(shardCount >= 1, "shardCount >= 1");
+
+    mShardCount = shardCount;
+
+    return *this;
+}
+
 std::shared_ptr<StubPoolPluginFactory> Builder::build()
 {
+    mReaderConfigurationsShared = true;
+
     return std::shared_ptr<StubPoolPluginFactoryAdapter>(
               new StubPoolPluginFactoryAdapter(PLUGIN_NAME,
                                                mReaderConfigurations,
-                                               mMonitoringCycleDuration));
+                                               mMonitoringCycleDuration,
+                                               mElasticGroupConfigurations,
+                                               mShardCount));
 }
 
 /* STUB POOL PLUGIN FACTORY BUILDER ------------------------------------------------------------- */
@@ -27,6 +27,7 @@ namespace plugin {
 namespace stub {
 
 using StubPoolReaderConfiguration = StubPoolPluginFactoryAdapter::StubPoolReaderConfiguration;
+using StubElasticGroupConfiguration = StubPoolPluginFactoryAdapter::StubElasticGroupConfiguration;
 
 /**
  * Builds instances of StubPoolPluginFactory.
@@ -70,6 +71,43 @@ public:
          */
         Builder& withMonitoringCycleDuration(const int duration);
 
+        /**
+         * Makes the size of a reader group follow the demand. minSize readers are plugged at
+         * startup. When the group has no available reader left, a new reader holding a copy of
+         * cardTemplate is plugged on allocation, up to maxSize readers. A released reader which
+         * stays idle for idleCooldown milliseconds is unplugged while the group holds more than
+         * minSize readers.
+         *
+         * <p>Readers added with withStubReader() to the same group count in its size.
+         *
+         * @param groupReference Reader group reference.
+         * @param minSize number of readers kept plugged in the group
+         * @param maxSize maximum number of readers of the group (at least 1 and minSize)
+         * @param cardTemplate (optional) card copied into each plugged reader
+         * @param idleCooldown duration in milliseconds before an idle extra reader is unplugged
+         * @return instance of the builder
+         * @since 2.2.0
+         */
+        Builder& withElasticReaderGroup(const std::string& groupReference,
+                                        const std::size_t minSize,
+                                        const std::size_t maxSize,
+                                        std::shared_ptr<StubSmartCard> cardTemplate,
+                                        const int idleCooldown);
+
+        /**
+         * Splits the pool state into several shards, each one having its own lock, so that
+         * threads allocating and releasing readers concurrently rarely contend. Allocations are
+         * served by the shard of the calling thread first, then by the other shards.
+         *
+         * <p>With more than one shard, the first reader allocated in a group is no longer
+         * guaranteed to be the first one by name.
+         *
+         * @param shardCount number of shards (at least 1), default value : 1
+         * @return instance of the builder
+         * @since 2.2.0
+         */
+        Builder& withShardCount(const std::size_t shardCount);
+
         /**
          * Returns an instance of StubPoolPluginFactory created from the fields set on this builder.
          *
@@ -79,16 +117,32 @@ public:
         std::shared_ptr<StubPoolPluginFactory> build();
 
     private:
+        /**
+         * Shared with the factories built, copied before being modified again
+         */
+        std::shared_ptr<std::vector<std::shared_ptr<StubPoolReaderConfiguration>>>
+            mReaderConfigurations;
+
+        /**
+         * True once mReaderConfigurations has been handed to a factory
+         */
+        bool mReaderConfigurationsShared;
+
         /**
          *
          */
-        std::vector<std::shared_ptr<StubPoolReaderConfiguration>> mReaderConfigurations;
+        std::vector<std::shared_ptr<StubElasticGroupConfiguration>> mElasticGroupConfigurations;
 
         /**
          *
          */
         int mMonitoringCycleDuration;
 
+        /**
+         *
+         */
+        std::size_t mShardCount;
+
         /**
          * (private) Constructs an empty Builder
          */
@@ -0,0 +1,144 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubPrometheusWriter.h"
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util::cpp::exception;
+
+static const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+static const double NANOSECONDS_PER_SECOND = 1e9;
+
+static std::string escapeLabelValue(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char c : value) {
+        if (c == '\\') {
+            escaped += "\\\\";
+        } else if (c == '"') {
+            escaped += "\\\"";
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+StubPrometheusWriter::StubPrometheusWriter()
+{
+    mOutput.precision(std::numeric_limits<double>::digits10);
+}
+
+void StubPrometheusWriter::writeFamily(const std::string& name,
+                                       const std::string& type,
+                                       const std::string& help)
+{
+    mOutput << "# HELP " << name << " " << help << "\n"
+            << "# TYPE " << name << " " << type << "\n";
+}
+
+void StubPrometheusWriter::writeSample(const std::string& name,
+                                       const Labels& labels,
+                                       const uint64_t value)
+{
+    writeName(name, labels);
+    mOutput << " " << value << "\n";
+}
+
+void StubPrometheusWriter::writeSample(const std::string& name,
+                                       const Labels& labels,
+                                       const double value)
+{
+    writeName(name, labels);
+    mOutput << " " << value << "\n";
+}
+
+void StubPrometheusWriter::writeSummary(const std::string& name,
+                                        const Labels& labels,
+                                        const StubMetrics::Histogram& latency)
+{
+    for (const double quantile : QUANTILES) {
+        std::ostringstream quantileValue;
+        quantileValue << quantile;
+
+        Labels quantileLabels = labels;
+        quantileLabels.push_back({"quantile", quantileValue.str()});
+
+        const uint64_t value = latency.getValueAtPercentile(quantile * 100);
+        writeSample(name, quantileLabels, static_cast<double>(value) / NANOSECONDS_PER_SECOND);
+    }
+
+    writeSample(name + "_sum",
+                labels,
+                static_cast<double>(latency.getSum()) / NANOSECONDS_PER_SECOND);
+    writeSample(name + "_count", labels, latency.getCount());
+}
+
+const std::string StubPrometheusWriter::toString() const
+{
+    return mOutput.str();
+}
+
+void StubPrometheusWriter::writeFile(const std::string& path, const std::string& metrics)
+{
+    const std::string temporaryPath = path + ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file << metrics;
+        if (!file.good()) {
+            throw IllegalArgumentException("Unable to write the metrics file " + path);
+        }
+    }
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        throw IllegalArgumentException("Unable to write the metrics file " + path);
+    }
+}
+
+void StubPrometheusWriter::writeName(const std::string& name, const Labels& labels)
+{
+    mOutput << name;
+
+    if (labels.empty()) {
+        return;
+    }
+
+    mOutput << "{";
+    for (std::size_t i = 0; i < labels.size(); i++) {
+        if (i > 0) {
+            mOutput << ",";
+        }
+        mOutput << labels[i].first << "=\"" << escapeLabelValue(labels[i].second) << "\"";
+    }
+    mOutput << "}";
+}
+
+}
+}
+}
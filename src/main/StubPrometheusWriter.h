@@ -0,0 +1,137 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+#include "StubMetrics.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+/**
+ * (package-private)<br>
+ * Writes metrics in the Prometheus text exposition format (version 0.0.4).
+ *
+ * <p>The samples of a metric must follow its family header, the callers write all the samples of a
+ * family before starting the next one.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubPrometheusWriter final {
+public:
+    /**
+     * (package-private)<br>
+     * Labels of a sample, as name and value pairs.
+     *
+     * @since 2.2.0
+     */
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * (package-private)<br>
+     *
+     * @since 2.2.0
+     */
+    StubPrometheusWriter();
+
+    /**
+     * (package-private)<br>
+     * Starts a metric family with its HELP and TYPE lines.
+     *
+     * @param name the name of the metric
+     * @param type counter, gauge or summary
+     * @param help the description of the metric
+     * @since 2.2.0
+     */
+    void writeFamily(const std::string& name, const std::string& type, const std::string& help);
+
+    /**
+     * (package-private)<br>
+     * Writes an integer sample.
+     *
+     * @param name the name of the sample, the metric name possibly with a suffix
+     * @param labels the labels of the sample
+     * @param value the value
+     * @since 2.2.0
+     */
+    void writeSample(const std::string& name, const Labels& labels, const uint64_t value);
+
+    /**
+     * (package-private)<br>
+     * Writes a floating point sample.
+     *
+     * @param name the name of the sample, the metric name possibly with a suffix
+     * @param labels the labels of the sample
+     * @param value the value
+     * @since 2.2.0
+     */
+    void writeSample(const std::string& name, const Labels& labels, const double value);
+
+    /**
+     * (package-private)<br>
+     * Writes the samples of a summary of latencies, in seconds: the 0.5, 0.9, 0.99 and 0.999
+     * quantiles, the sum and the count.
+     *
+     * @param name the name of the metric
+     * @param labels the labels of the samples
+     * @param latency the latencies, in nanoseconds
+     * @since 2.2.0
+     */
+    void writeSummary(const std::string& name,
+                      const Labels& labels,
+                      const StubMetrics::Histogram& latency);
+
+    /**
+     * (package-private)<br>
+     *
+     * @return the metrics written so far
+     * @since 2.2.0
+     */
+    const std::string toString() const;
+
+    /**
+     * (package-private)<br>
+     * Replaces the content of a file by metrics. The metrics are written to a temporary file
+     * renamed once complete, so that a collector never reads a partial file.
+     *
+     * @param path the path of the file
+     * @param metrics the metrics
+     * @throw IllegalArgumentException if the file cannot be written
+     * @since 2.2.0
+     */
+    static void writeFile(const std::string& path, const std::string& metrics);
+
+private:
+    /**
+     *
+     */
+    std::ostringstream mOutput;
+
+    /**
+     * (private)<br>
+     * Writes the name and the labels of a sample.
+     */
+    void writeName(const std::string& name, const Labels& labels);
+};
+
+}
+}
+}
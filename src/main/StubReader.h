@@ -19,6 +19,7 @@
 #include "KeypleReaderExtension.h"
 
 /* Keyple Plugin Stub */
+#include "StubMetrics.h"
 #include "StubSmartCard.h"
 
 namespace keyple {
@@ -60,6 +61,23 @@ public:
      * @since 2.0.0
      */
     virtual std::shared_ptr<StubSmartCard> getSmartcard() = 0;
+
+    /**
+     * Gets the metrics of the APDUs transmitted by the reader, empty unless the library is built
+     * with KEYPLE_STUB_METRICS defined. The metrics of the card itself are given by
+     * StubSmartCard::getMetrics().
+     *
+     * @return the metrics
+     * @since 2.2.0
+     */
+    virtual const StubMetrics::ReaderMetrics getMetrics() const = 0;
+
+    /**
+     * Sets the metrics of the reader to zero.
+     *
+     * @since 2.2.0
+     */
+    virtual void resetMetrics() = 0;
 };
 
 }
@@ -12,8 +12,14 @@
 
 #include "StubReaderAdapter.h"
 
+#include <algorithm>
+#include <functional>
+#include <mutex>
+
+/* Keyple Plugin Stub */
+#include "StubTracer.h"
+
 /* Keyple Core Util */
-#include "Arrays.h"
 #include "HexUtil.h"
 #include "InterruptedException.h"
 #include "KeypleAssert.h"
@@ -32,12 +38,99 @@ using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
 using namespace keyple::core::util::cpp::exception;
 
+const std::unique_ptr<Logger> StubReaderAdapter::mLogger =
+    LoggerFactory::getLogger(typeid(StubReaderAdapter));
+
+const std::size_t StubReaderAdapter::MAX_PROTOCOL_COUNT = 64;
+
+/* PROTOCOL TABLE ------------------------------------------------------------------------------- */
+
+/*
+ * Open addressing set of the names, never removed: a lookup probes without lock, interning is
+ * serialized by the mutex and publishes the name before the slot referring to it
+ */
+struct StubReaderAdapter::ProtocolTable {
+    /**
+     * Number of slots, a power of two twice MAX_PROTOCOL_COUNT so that probes stay short
+     */
+    static const std::size_t SLOT_COUNT = 128;
+
+    /**
+     *
+     */
+    std::mutex mMutex;
+
+    /**
+     * Names by index, created on interning
+     */
+    std::atomic<const std::string*> mNames[SLOT_COUNT / 2];
+
+    /**
+     * Index of a name + 1, 0 for an empty slot
+     */
+    std::atomic<std::size_t> mSlots[SLOT_COUNT];
+
+    /**
+     *
+     */
+    std::atomic<std::size_t> mSize;
+
+    /**
+     *
+     */
+    ProtocolTable() : mSize(0)
+    {
+        for (std::size_t i = 0; i < SLOT_COUNT / 2; i++) {
+            mNames[i] = nullptr;
+        }
+
+        for (std::size_t i = 0; i < SLOT_COUNT; i++) {
+            mSlots[i] = 0;
+        }
+    }
+
+    /**
+     *
+     */
+    ~ProtocolTable()
+    {
+        for (std::size_t i = 0; i < mSize; i++) {
+            delete mNames[i].load();
+        }
+    }
+
+    /**
+     * Gets the slot of a name, or the empty slot ending its probe sequence
+     */
+    std::size_t findSlot(const std::string& protocol) const
+    {
+        std::size_t slot = std::hash<std::string>()(protocol) & (SLOT_COUNT - 1);
+        for (std::size_t index = mSlots[slot]; index != 0; index = mSlots[slot]) {
+            if (*mNames[index - 1] == protocol) {
+                break;
+            }
+            slot = (slot + 1) & (SLOT_COUNT - 1);
+        }
+
+        return slot;
+    }
+};
+
+/* STUB READER ADAPTER -------------------------------------------------------------------------- */
+
 StubReaderAdapter::StubReaderAdapter(
   const std::string& name, const bool isContactLess, std::shared_ptr<StubSmartCard> card)
 : mName(name),
   mIsContactLess(isContactLess),
+  mActivatedProtocols(0),
   mSmartCard(card),
-  mContinueWaitForCardRemovalTask(false) {}
+  mContinueWaitForCardRemovalTask(false)
+#if defined(KEYPLE_STUB_METRICS)
+  , mMetrics(0),
+  mCardInsertionCount(0),
+  mCardRemovalCount(0)
+#endif
+{}
 
 void StubReaderAdapter::onStartDetection()
 {
@@ -64,16 +157,35 @@ bool StubReaderAdapter::isProtocolSupported(const std::string& readerProtocol) c
 
 void StubReaderAdapter::activateProtocol(const std::string& readerProtocol)
 {
-    mActivatedProtocols.push_back(readerProtocol);
+    const uint64_t bit = getProtocolBit(readerProtocol, true);
+    if (bit != 0) {
+        mActivatedProtocols |= bit;
+        return;
+    }
+
+    /* No bit left for the protocol, kept by name */
+    if (mOtherActivatedProtocols == nullptr) {
+        mOtherActivatedProtocols.reset(new std::vector<std::string>());
+    }
+
+    if (!isProtocolActivated(readerProtocol)) {
+        mOtherActivatedProtocols->push_back(readerProtocol);
+    }
 }
 
 void StubReaderAdapter::deactivateProtocol(const std::string& readerProtocol)
 {
-    const auto it = std::find(mActivatedProtocols.begin(),
-                              mActivatedProtocols.end(),
-                              readerProtocol);
-    if (it != mActivatedProtocols.end()) {
-        mActivatedProtocols.erase(it);
+    const uint64_t bit = getProtocolBit(readerProtocol, false);
+    if (bit != 0) {
+        mActivatedProtocols &= ~bit;
+        return;
+    }
+
+    if (mOtherActivatedProtocols != nullptr) {
+        mOtherActivatedProtocols->erase(std::remove(mOtherActivatedProtocols->begin(),
+                                                    mOtherActivatedProtocols->end(),
+                                                    readerProtocol),
+                                        mOtherActivatedProtocols->end());
     }
 }
 
@@ -88,6 +200,10 @@ bool StubReaderAdapter::isCurrentProtocol(const std::string& readerProtocol) con
 
 void StubReaderAdapter::openPhysicalChannel()
 {
+#if defined(KEYPLE_STUB_TRACE)
+    const StubTracer::Scope scope("openPhysicalChannel", mName);
+#endif
+
     if (mSmartCard != nullptr) {
         mSmartCard->openPhysicalChannel();
     }
@@ -117,11 +233,37 @@ const std::string StubReaderAdapter::getPowerOnData() const
 
 const std::vector<uint8_t> StubReaderAdapter::transmitApdu(const std::vector<uint8_t>& apduIn)
 {
+    std::vector<uint8_t> apduOut;
+    transmitApdu(apduIn, apduOut);
+
+    return apduOut;
+}
+
+void StubReaderAdapter::transmitApdu(const std::vector<uint8_t>& apduIn,
+                                     std::vector<uint8_t>& apduOut)
+{
+    StubApdu response;
+    transmitApdu(StubApdu(apduIn), response);
+
+    apduOut.assign(response.begin(), response.end());
+}
+
+void StubReaderAdapter::transmitApdu(const StubApdu& apduIn, StubApdu& apduOut)
+{
+#if defined(KEYPLE_STUB_TRACE)
+    const StubTracer::Scope scope("transmitApdu", mName);
+#endif
+
+#if defined(KEYPLE_STUB_METRICS)
+    /* Records the transmission as an error if it throws */
+    const StubMetrics::Timer timer(mMetrics);
+#endif
+
     if (mSmartCard == nullptr) {
         throw CardIOException("No card available.");
     }
 
-    return mSmartCard->processApdu(apduIn);
+    mSmartCard->processApdu(apduIn, apduOut);
 }
 
 bool StubReaderAdapter::isContactless()
@@ -136,6 +278,10 @@ void StubReaderAdapter::onUnregister()
 
 void StubReaderAdapter::insertCard(std::shared_ptr<StubSmartCard> smartCard)
 {
+#if defined(KEYPLE_STUB_TRACE)
+    const StubTracer::Scope scope("insertCard", mName);
+#endif
+
     Assert::getInstance().notNull(smartCard, "smart card");
 
     if (checkCardPresence()) {
@@ -144,7 +290,7 @@ void StubReaderAdapter::insertCard(std::shared_ptr<StubSmartCard> smartCard)
     }
 
     const std::string protocol = smartCard->getCardProtocol();
-    if (!Arrays::contains(mActivatedProtocols, protocol)) {
+    if (!isProtocolActivated(protocol)) {
         mLogger->trace("Inserted card protocol % does not match any activated protocol, please " \
                        "use activateProtocol() method\n",
                        protocol);
@@ -155,14 +301,26 @@ void StubReaderAdapter::insertCard(std::shared_ptr<StubSmartCard> smartCard)
     mLogger->trace("Inserted card %\n", smartCard);
 
     mSmartCard = smartCard;
+
+#if defined(KEYPLE_STUB_METRICS)
+    mCardInsertionCount++;
+#endif
 }
 
 void StubReaderAdapter::removeCard()
 {
+#if defined(KEYPLE_STUB_TRACE)
+    const StubTracer::Scope scope("removeCard", mName);
+#endif
+
     if (mSmartCard != nullptr) {
         mLogger->trace("Remove card %\n", mSmartCard);
         closePhysicalChannel();
         mSmartCard = nullptr;
+
+#if defined(KEYPLE_STUB_METRICS)
+        mCardRemovalCount++;
+#endif
     }
 }
 
@@ -196,6 +354,107 @@ void StubReaderAdapter::stopWaitForCardRemovalDuringProcessing()
     mContinueWaitForCardRemovalTask = false;
 }
 
+const StubMetrics::ReaderMetrics StubReaderAdapter::getMetrics() const
+{
+    StubMetrics::ReaderMetrics metrics;
+
+#if defined(KEYPLE_STUB_METRICS)
+    mMetrics.getMetrics(metrics);
+    metrics.mCardInsertionCount = mCardInsertionCount;
+    metrics.mCardRemovalCount = mCardRemovalCount;
+#endif
+
+    return metrics;
+}
+
+void StubReaderAdapter::resetMetrics()
+{
+#if defined(KEYPLE_STUB_METRICS)
+    mMetrics.reset();
+    mCardInsertionCount = 0;
+    mCardRemovalCount = 0;
+#endif
+}
+
+void StubReaderAdapter::reset(std::shared_ptr<StubSmartCard> smartCard)
+{
+    stopWaitForCardRemovalDuringProcessing();
+
+    mActivatedProtocols = 0;
+    if (mOtherActivatedProtocols != nullptr) {
+        mOtherActivatedProtocols->clear();
+    }
+
+    mSmartCard = smartCard;
+    closePhysicalChannel();
+}
+
+bool StubReaderAdapter::isProtocolActivated(const std::string& protocol) const
+{
+    const uint64_t bit = getProtocolBit(protocol, false);
+    if (bit != 0) {
+        return (mActivatedProtocols & bit) != 0;
+    }
+
+    return mOtherActivatedProtocols != nullptr &&
+           std::find(mOtherActivatedProtocols->begin(), mOtherActivatedProtocols->end(), protocol)
+               != mOtherActivatedProtocols->end();
+}
+
+uint64_t StubReaderAdapter::getProtocolBit(const std::string& protocol, const bool intern)
+{
+    ProtocolTable& protocolTable = getProtocolTable();
+
+    std::size_t index = protocolTable.mSlots[protocolTable.findSlot(protocol)];
+    if (index != 0) {
+        return static_cast<uint64_t>(1) << (index - 1);
+    }
+
+    if (!intern) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(protocolTable.mMutex);
+
+    /* Another thread may have interned it while waiting for the lock */
+    const std::size_t slot = protocolTable.findSlot(protocol);
+    index = protocolTable.mSlots[slot];
+    if (index != 0) {
+        return static_cast<uint64_t>(1) << (index - 1);
+    }
+
+    const std::size_t size = protocolTable.mSize;
+    if (size == MAX_PROTOCOL_COUNT) {
+        return 0;
+    }
+
+    protocolTable.mNames[size] = new std::string(protocol);
+    protocolTable.mSlots[slot] = size + 1;
+    protocolTable.mSize = size + 1;
+
+    return static_cast<uint64_t>(1) << size;
+}
+
+const std::vector<std::string> StubReaderAdapter::getProtocols()
+{
+    const ProtocolTable& protocolTable = getProtocolTable();
+
+    std::vector<std::string> protocols;
+    const std::size_t size = protocolTable.mSize;
+    for (std::size_t i = 0; i < size; i++) {
+        protocols.push_back(*protocolTable.mNames[i]);
+    }
+
+    return protocols;
+}
+
+StubReaderAdapter::ProtocolTable& StubReaderAdapter::getProtocolTable()
+{
+    static ProtocolTable protocolTable;
+
+    return protocolTable;
+}
+
 }
 }
 }
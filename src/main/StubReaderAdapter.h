@@ -13,6 +13,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -29,6 +30,7 @@
 
 /* Keyple Plugin Stub */
 #include "KeyplePluginStubExport.h"
+#include "StubApdu.h"
 #include "StubReader.h"
 #include "StubSmartCard.h"
 
@@ -47,6 +49,11 @@ using namespace keyple::core::util::cpp;
  * (package-private)<br>
  * The adapter for the StubReader is also an ObservableReaderSpi
  *
+ * <p>Kept compact as simulations may plug a large number of readers: the logger is shared by all
+ * the readers and the activated protocols are bits of a word, each protocol name being interned
+ * once for the process (since 2.2.0). Protocols activated once all the bits are interned are kept
+ * by name by the reader.
+ *
  * @since 2.0.0
  */
 class KEYPLEPLUGINSTUB_API StubReaderAdapter final
@@ -165,6 +172,31 @@ public:
      */
     const std::vector<uint8_t> transmitApdu(const std::vector<uint8_t>& apduIn) override;
 
+    /**
+     * (package-private)<br>
+     * Transmits an APDU, writing the response into a buffer of the caller whose capacity is
+     * reused, so that the exchanges with a card made of plain simulated commands allocate nothing
+     * once the buffer is large enough.
+     *
+     * @param apduIn the APDU
+     * @param apduOut replaced by the response
+     * @throw CardIOException if no card is inserted or the card has no response to the APDU
+     * @since 2.2.0
+     */
+    void transmitApdu(const std::vector<uint8_t>& apduIn, std::vector<uint8_t>& apduOut);
+
+    /**
+     * (package-private)<br>
+     * Transmits an APDU held in a small buffer, short APDUs being exchanged without allocation
+     * under the same conditions as the vector based overload.
+     *
+     * @param apduIn the APDU
+     * @param apduOut replaced by the response
+     * @throw CardIOException if no card is inserted or the card has no response to the APDU
+     * @since 2.2.0
+     */
+    void transmitApdu(const StubApdu& apduIn, StubApdu& apduOut);
+
     /**
      * {@inheritDoc}
      *
@@ -218,11 +250,52 @@ public:
      */
     void stopWaitForCardRemovalDuringProcessing() override;
 
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    const StubMetrics::ReaderMetrics getMetrics() const override;
+
+    /**
+     * {@inheritDoc}
+     *
+     * @since 2.2.0
+     */
+    void resetMetrics() override;
+
+    /**
+     * (package-private)<br>
+     * Restores the reader to its pristine state without creating any object: no protocol is
+     * activated and the provided card is inserted with its physical channel closed. The card it
+     * replaces is left untouched, as it may be in use by another reader.
+     *
+     * @param smartCard the card to insert (can be null)
+     * @since 2.2.0
+     */
+    void reset(std::shared_ptr<StubSmartCard> smartCard);
+
 private:
+    /**
+     * (private)<br>
+     * Protocol names interned for the process, the index of a name being its bit
+     */
+    struct ProtocolTable;
+
+    /**
+     * Saves and restores the activated protocols
+     */
+    friend class StubPluginSnapshot;
+
     /**
      *
      */
-    const std::unique_ptr<Logger> mLogger = LoggerFactory::getLogger(typeid(StubReaderAdapter));
+    static const std::unique_ptr<Logger> mLogger;
+
+    /**
+     * Maximum number of distinct protocols, one bit of mActivatedProtocols per protocol
+     */
+    static const std::size_t MAX_PROTOCOL_COUNT;
 
     /**
      *
@@ -235,9 +308,15 @@ private:
     const bool mIsContactLess;
 
     /**
-     *
+     * One bit per activated protocol, see getProtocolBit()
+     */
+    uint64_t mActivatedProtocols;
+
+    /**
+     * Activated protocols left without a bit once MAX_PROTOCOL_COUNT protocols are interned,
+     * created only then
      */
-    std::vector<std::string> mActivatedProtocols;
+    std::unique_ptr<std::vector<std::string>> mOtherActivatedProtocols;
 
     /**
      *
@@ -248,6 +327,55 @@ private:
      *
      */
     std::atomic<bool> mContinueWaitForCardRemovalTask;
+
+#if defined(KEYPLE_STUB_METRICS)
+    /**
+     *
+     */
+    StubMetrics::Recorder mMetrics;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mCardInsertionCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mCardRemovalCount;
+#endif
+
+    /**
+     * (private)<br>
+     * Tells if a protocol is activated.
+     */
+    bool isProtocolActivated(const std::string& protocol) const;
+
+    /**
+     * (private)<br>
+     * Gets the bit of a protocol in mActivatedProtocols. Protocol names are interned in a table
+     * shared by all the readers, looked up without lock.
+     *
+     * @param protocol the protocol name
+     * @param intern true to allocate a bit to a protocol seen for the first time
+     * @return the bit, or 0 if the protocol has not been interned and intern is false or
+     *         MAX_PROTOCOL_COUNT protocols are already interned
+     */
+    static uint64_t getProtocolBit(const std::string& protocol, const bool intern);
+
+    /**
+     * (private)<br>
+     * Gets the interned protocol names.
+     *
+     * @return the names, the bit of a protocol being 1 shifted by its index
+     */
+    static const std::vector<std::string> getProtocols();
+
+    /**
+     * (private)<br>
+     * Gets the table of the interned protocols, created on first use.
+     */
+    static ProtocolTable& getProtocolTable();
 };
 
 }
@@ -0,0 +1,445 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubReaderRegistry.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+/* Keyple Core Util */
+#include "KeypleAssert.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util;
+
+/* SNAPSHOT ------------------------------------------------------------------------------------- */
+
+StubReaderRegistry::Snapshot::Snapshot(const uint64_t version,
+                                       const std::vector<std::shared_ptr<ReaderSpi>>& readers)
+: mVersion(version), mReaders(readers)
+{
+    mReaderNames.reserve(mReaders.size());
+    for (const auto& reader : mReaders) {
+        mReaderNames.push_back(reader->getName());
+    }
+}
+
+uint64_t StubReaderRegistry::Snapshot::getVersion() const
+{
+    return mVersion;
+}
+
+const std::vector<std::shared_ptr<ReaderSpi>>& StubReaderRegistry::Snapshot::getReaders() const
+{
+    return mReaders;
+}
+
+const std::vector<std::string>& StubReaderRegistry::Snapshot::getReaderNames() const
+{
+    return mReaderNames;
+}
+
+/* EPOCH ---------------------------------------------------------------------------------------- */
+
+StubReaderRegistry::Epoch::Epoch() : mEpoch(0)
+{
+    mReaders[0] = 0;
+    mReaders[1] = 0;
+}
+
+std::size_t StubReaderRegistry::Epoch::enter()
+{
+    const std::size_t counter = static_cast<std::size_t>(mEpoch.load() & 1);
+    mReaders[counter]++;
+
+    return counter;
+}
+
+void StubReaderRegistry::Epoch::leave(const std::size_t counter)
+{
+    mReaders[counter]--;
+}
+
+void StubReaderRegistry::Epoch::synchronize()
+{
+    /*
+     * A reader counts itself on the parity of the epoch it loaded, which may already be stale: one
+     * which loaded the epoch before an earlier call and counted itself after it may still reach
+     * the nodes unlinked now, on the parity this first flip does not wait for. Flipping twice waits
+     * for both counters, whatever epoch the readers loaded, while the flip before each wait keeps
+     * new readers off the drained counter
+     */
+    for (int i = 0; i < 2; i++) {
+        const uint64_t previousEpoch = mEpoch++;
+        while (mReaders[previousEpoch & 1] != 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/* READ SECTION --------------------------------------------------------------------------------- */
+
+StubReaderRegistry::ReadSection::ReadSection(Epoch& epoch)
+: mEpoch(epoch), mCounter(epoch.enter()) {}
+
+StubReaderRegistry::ReadSection::~ReadSection()
+{
+    mEpoch.leave(mCounter);
+}
+
+/* NODE ----------------------------------------------------------------------------------------- */
+
+StubReaderRegistry::Node::Node(std::shared_ptr<StubReaderAdapter> reader,
+                               const std::size_t hash,
+                               Node* next)
+: mReader(reader), mHash(hash), mNext(next) {}
+
+/* TABLE ---------------------------------------------------------------------------------------- */
+
+StubReaderRegistry::Table::Table(const std::size_t bucketCount)
+: mMask(bucketCount - 1), mBuckets(new std::atomic<Node*>[bucketCount])
+{
+    for (std::size_t i = 0; i < bucketCount; i++) {
+        mBuckets[i] = nullptr;
+    }
+}
+
+/* SHARD ---------------------------------------------------------------------------------------- */
+
+/* Initial number of buckets of a shard, a power of two */
+static const std::size_t INITIAL_BUCKET_COUNT = 16;
+
+StubReaderRegistry::Shard::Shard() : mTable(new Table(INITIAL_BUCKET_COUNT)), mSize(0) {}
+
+StubReaderRegistry::Shard::~Shard()
+{
+    Table* const table = mTable;
+    for (std::size_t i = 0; i <= table->mMask; i++) {
+        Node* node = table->mBuckets[i];
+        while (node != nullptr) {
+            Node* const next = node->mNext;
+            delete node;
+            node = next;
+        }
+    }
+
+    delete table;
+}
+
+/* STUB READER REGISTRY ------------------------------------------------------------------------- */
+
+const std::size_t StubReaderRegistry::DEFAULT_SHARD_COUNT = 16;
+
+StubReaderRegistry::StubReaderRegistry(const std::size_t shardCount)
+: mVersion(0), mSnapshot(nullptr)
+{
+    Assert::getInstance().greaterOrEqual(static_cast<int>(shardCount), 1, "shardCount");
+
+    for (std::size_t i = 0; i < shardCount; i++) {
+        mShards.push_back(std::unique_ptr<Shard>(new Shard()));
+    }
+}
+
+StubReaderRegistry::~StubReaderRegistry()
+{
+    delete mSnapshot.load();
+}
+
+std::shared_ptr<StubReaderAdapter> StubReaderRegistry::find(const std::string& readerName) const
+{
+    const std::size_t hash = std::hash<std::string>()(readerName);
+    Shard& shard = *mShards[hash % mShards.size()];
+
+    /* The node cannot be freed before the end of the section, the reader is copied meanwhile */
+    const ReadSection section(shard.mEpoch);
+
+    const Node* const node = findNode(shard, readerName, hash);
+    if (node != nullptr) {
+        return node->mReader;
+    }
+
+    return nullptr;
+}
+
+bool StubReaderRegistry::insert(std::shared_ptr<StubReaderAdapter> reader)
+{
+    Shard& shard = getShard(reader->getName());
+    std::lock_guard<std::mutex> lock(shard.mMutex);
+
+    if (!link(shard, reader)) {
+        return false;
+    }
+
+    mVersion++;
+
+    return true;
+}
+
+std::shared_ptr<StubReaderAdapter> StubReaderRegistry::erase(const std::string& readerName)
+{
+    Shard& shard = getShard(readerName);
+    std::lock_guard<std::mutex> lock(shard.mMutex);
+
+    std::vector<Node*> unlinkedNodes;
+    const std::shared_ptr<StubReaderAdapter> reader = unlink(shard, readerName, unlinkedNodes);
+    if (reader == nullptr) {
+        return nullptr;
+    }
+
+    mVersion++;
+
+    shard.mEpoch.synchronize();
+    delete unlinkedNodes.front();
+
+    return reader;
+}
+
+std::size_t StubReaderRegistry::insert(
+    const std::vector<std::shared_ptr<StubReaderAdapter>>& readers)
+{
+    /* Group the readers by shard so that each shard is locked only once */
+    std::vector<std::vector<const std::shared_ptr<StubReaderAdapter>*>> readersByShard(
+        mShards.size());
+    for (const auto& reader : readers) {
+        readersByShard[getShardIndex(reader->getName())].push_back(&reader);
+    }
+
+    std::size_t insertedCount = 0;
+
+    for (std::size_t i = 0; i < mShards.size(); i++) {
+        if (readersByShard[i].empty()) {
+            continue;
+        }
+
+        Shard& shard = *mShards[i];
+        std::lock_guard<std::mutex> lock(shard.mMutex);
+
+        for (const auto reader : readersByShard[i]) {
+            if (link(shard, *reader)) {
+                insertedCount++;
+            }
+        }
+    }
+
+    if (insertedCount > 0) {
+        mVersion++;
+    }
+
+    return insertedCount;
+}
+
+std::size_t StubReaderRegistry::erase(const std::vector<std::string>& readerNames)
+{
+    std::vector<std::vector<const std::string*>> readerNamesByShard(mShards.size());
+    for (const auto& readerName : readerNames) {
+        readerNamesByShard[getShardIndex(readerName)].push_back(&readerName);
+    }
+
+    std::size_t erasedCount = 0;
+    std::vector<Node*> unlinkedNodes;
+
+    for (std::size_t i = 0; i < mShards.size(); i++) {
+        if (readerNamesByShard[i].empty()) {
+            continue;
+        }
+
+        Shard& shard = *mShards[i];
+        std::lock_guard<std::mutex> lock(shard.mMutex);
+
+        for (const auto readerName : readerNamesByShard[i]) {
+            unlink(shard, *readerName, unlinkedNodes);
+        }
+
+        if (unlinkedNodes.empty()) {
+            continue;
+        }
+
+        erasedCount += unlinkedNodes.size();
+
+        /* Once for all the readers of the shard */
+        shard.mEpoch.synchronize();
+        for (Node* const node : unlinkedNodes) {
+            delete node;
+        }
+
+        unlinkedNodes.clear();
+    }
+
+    if (erasedCount > 0) {
+        mVersion++;
+    }
+
+    return erasedCount;
+}
+
+std::shared_ptr<const StubReaderRegistry::Snapshot> StubReaderRegistry::getSnapshot() const
+{
+    /* Read before the shards, a change published meanwhile makes the snapshot outdated */
+    uint64_t version = mVersion;
+
+    {
+        const ReadSection section(mSnapshotEpoch);
+
+        const std::shared_ptr<const Snapshot>* const snapshot = mSnapshot;
+        if (snapshot != nullptr && (*snapshot)->getVersion() == version) {
+            return *snapshot;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mSnapshotMutex);
+
+    /* Another thread may have rebuilt it while waiting for the lock, only rebuilds replace it */
+    version = mVersion;
+    const std::shared_ptr<const Snapshot>* const snapshot = mSnapshot;
+    if (snapshot != nullptr && (*snapshot)->getVersion() == version) {
+        return *snapshot;
+    }
+
+    std::vector<std::shared_ptr<StubReaderAdapter>> stubReaders;
+    for (const auto& shard : mShards) {
+        const ReadSection section(shard->mEpoch);
+
+        const Table* const table = shard->mTable;
+        for (std::size_t i = 0; i <= table->mMask; i++) {
+            for (const Node* node = table->mBuckets[i]; node != nullptr; node = node->mNext) {
+                stubReaders.push_back(node->mReader);
+            }
+        }
+    }
+
+    std::sort(stubReaders.begin(),
+              stubReaders.end(),
+              [](const std::shared_ptr<StubReaderAdapter>& a,
+                 const std::shared_ptr<StubReaderAdapter>& b) {
+                  return a->getName() < b->getName();
+              });
+
+    const std::shared_ptr<const Snapshot>* const newSnapshot =
+        new std::shared_ptr<const Snapshot>(
+            std::make_shared<const Snapshot>(
+                version,
+                std::vector<std::shared_ptr<ReaderSpi>>(stubReaders.begin(), stubReaders.end())));
+
+    mSnapshot = newSnapshot;
+
+    /* The previous holder may still be read by a concurrent fast path */
+    mSnapshotEpoch.synchronize();
+    delete snapshot;
+
+    return *newSnapshot;
+}
+
+StubReaderRegistry::Shard& StubReaderRegistry::getShard(const std::string& readerName) const
+{
+    return *mShards[getShardIndex(readerName)];
+}
+
+std::size_t StubReaderRegistry::getShardIndex(const std::string& readerName) const
+{
+    return std::hash<std::string>()(readerName) % mShards.size();
+}
+
+std::size_t StubReaderRegistry::getBucketIndex(const Table& table, const std::size_t hash) const
+{
+    /* The low bits select the shard, the next ones the bucket */
+    return (hash / mShards.size()) & table.mMask;
+}
+
+StubReaderRegistry::Node* StubReaderRegistry::findNode(const Shard& shard,
+                                                       const std::string& readerName,
+                                                       const std::size_t hash) const
+{
+    const Table* const table = shard.mTable;
+
+    for (Node* node = table->mBuckets[getBucketIndex(*table, hash)]; node != nullptr;
+         node = node->mNext) {
+        if (node->mHash == hash && node->mReader->getName() == readerName) {
+            return node;
+        }
+    }
+
+    return nullptr;
+}
+
+bool StubReaderRegistry::link(Shard& shard, std::shared_ptr<StubReaderAdapter> reader)
+{
+    const std::size_t hash = std::hash<std::string>()(reader->getName());
+    if (findNode(shard, reader->getName(), hash) != nullptr) {
+        return false;
+    }
+
+    Table* table = shard.mTable;
+
+    /* Grow to keep the chains short, the nodes are copied as lookups may be walking them */
+    if (shard.mSize > table->mMask) {
+        Table* const newTable = new Table(2 * (table->mMask + 1));
+        for (std::size_t i = 0; i <= table->mMask; i++) {
+            for (Node* node = table->mBuckets[i]; node != nullptr; node = node->mNext) {
+                std::atomic<Node*>& bucket = newTable->mBuckets[getBucketIndex(*newTable,
+                                                                               node->mHash)];
+                bucket = new Node(node->mReader, node->mHash, bucket);
+            }
+        }
+
+        shard.mTable = newTable;
+        shard.mEpoch.synchronize();
+
+        for (std::size_t i = 0; i <= table->mMask; i++) {
+            Node* node = table->mBuckets[i];
+            while (node != nullptr) {
+                Node* const next = node->mNext;
+                delete node;
+                node = next;
+            }
+        }
+
+        delete table;
+        table = newTable;
+    }
+
+    /* Fully built before being published */
+    std::atomic<Node*>& bucket = table->mBuckets[getBucketIndex(*table, hash)];
+    bucket = new Node(reader, hash, bucket);
+    shard.mSize++;
+
+    return true;
+}
+
+std::shared_ptr<StubReaderAdapter> StubReaderRegistry::unlink(Shard& shard,
+                                                              const std::string& readerName,
+                                                              std::vector<Node*>& unlinkedNodes)
+{
+    const std::size_t hash = std::hash<std::string>()(readerName);
+    Table* const table = shard.mTable;
+
+    std::atomic<Node*>* link = &table->mBuckets[getBucketIndex(*table, hash)];
+    for (Node* node = *link; node != nullptr; link = &node->mNext, node = *link) {
+        if (node->mHash == hash && node->mReader->getName() == readerName) {
+            /* A lookup standing on the node still finds its successor until it is freed */
+            *link = node->mNext.load();
+            shard.mSize--;
+            unlinkedNodes.push_back(node);
+
+            return node->mReader;
+        }
+    }
+
+    return nullptr;
+}
+
+}
+}
+}
@@ -0,0 +1,440 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Keyple Core Plugin */
+#include "ReaderSpi.h"
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+#include "StubReaderAdapter.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::plugin::spi::reader;
+
+/**
+ * (package-private)<br>
+ * Registry of the readers of a plugin, safe for concurrent use.
+ *
+ * <p>Readers are spread over shards by the hash of their name. Each shard is a chained hash table
+ * whose buckets and links are atomic raw pointers: a lookup takes no lock and is wait-free, it
+ * only announces itself on a counter of the shard while it walks a chain. Writers of a shard are
+ * serialized by its lock, writers of different shards do not contend. Plugging a reader links a
+ * new node, unplugging it unlinks the node, and both cost O(1) on average. An unlinked node, or a
+ * table replaced when growing, is freed once the lookups which may still see it are over.
+ *
+ * <p>Listings are served from an immutable snapshot, rebuilt only after the set of readers
+ * changed, published the same way.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubReaderRegistry final {
+public:
+    /**
+     * (package-private)<br>
+     * Immutable view of the registered readers, sorted by name.
+     *
+     * @since 2.2.0
+     */
+    class KEYPLEPLUGINSTUB_API Snapshot final {
+    public:
+        /**
+         * (package-private)<br>
+         *
+         * @param version version of the registry the snapshot has been built from
+         * @param readers the readers, sorted by name
+         * @since 2.2.0
+         */
+        Snapshot(const uint64_t version, const std::vector<std::shared_ptr<ReaderSpi>>& readers);
+
+        /**
+         * (package-private)<br>
+         *
+         * @return the version of the registry the snapshot has been built from
+         * @since 2.2.0
+         */
+        uint64_t getVersion() const;
+
+        /**
+         * (package-private)<br>
+         *
+         * @return the readers, sorted by name
+         * @since 2.2.0
+         */
+        const std::vector<std::shared_ptr<ReaderSpi>>& getReaders() const;
+
+        /**
+         * (package-private)<br>
+         *
+         * @return the names of the readers, sorted
+         * @since 2.2.0
+         */
+        const std::vector<std::string>& getReaderNames() const;
+
+    private:
+        /**
+         *
+         */
+        const uint64_t mVersion;
+
+        /**
+         *
+         */
+        const std::vector<std::shared_ptr<ReaderSpi>> mReaders;
+
+        /**
+         *
+         */
+        std::vector<std::string> mReaderNames;
+    };
+
+    /**
+     * Default number of shards.
+     *
+     * @since 2.2.0
+     */
+    static const std::size_t DEFAULT_SHARD_COUNT;
+
+    /**
+     * (package-private)<br>
+     * Creates an empty registry.
+     *
+     * @param shardCount number of shards (at least 1)
+     * @since 2.2.0
+     */
+    explicit StubReaderRegistry(const std::size_t shardCount = DEFAULT_SHARD_COUNT);
+
+    /**
+     * (package-private)<br>
+     * Frees the nodes and the snapshot, no other thread may use the registry anymore.
+     *
+     * @since 2.2.0
+     */
+    ~StubReaderRegistry();
+
+    /**
+     *
+     */
+    StubReaderRegistry(const StubReaderRegistry&) = delete;
+
+    /**
+     *
+     */
+    StubReaderRegistry& operator=(const StubReaderRegistry&) = delete;
+
+    /**
+     * (package-private)<br>
+     * Looks up a reader.
+     *
+     * @param readerName name of the reader
+     * @return the reader or nullptr if there is no reader with this name
+     * @since 2.2.0
+     */
+    std::shared_ptr<StubReaderAdapter> find(const std::string& readerName) const;
+
+    /**
+     * (package-private)<br>
+     * Adds a reader, unless a reader with the same name is already registered.
+     *
+     * @param reader the reader
+     * @return true if the reader has been added
+     * @since 2.2.0
+     */
+    bool insert(std::shared_ptr<StubReaderAdapter> reader);
+
+    /**
+     * (package-private)<br>
+     * Removes a reader.
+     *
+     * @param readerName name of the reader
+     * @return the removed reader or nullptr if there is no reader with this name
+     * @since 2.2.0
+     */
+    std::shared_ptr<StubReaderAdapter> erase(const std::string& readerName);
+
+    /**
+     * (package-private)<br>
+     * Adds readers, skipping the ones whose name is already registered. Each shard is locked once
+     * whatever the number of readers it receives, and the change counts as a single one for the
+     * snapshots.
+     *
+     * @param readers the readers
+     * @return the number of readers added
+     * @since 2.2.0
+     */
+    std::size_t insert(const std::vector<std::shared_ptr<StubReaderAdapter>>& readers);
+
+    /**
+     * (package-private)<br>
+     * Removes readers, locking each shard and waiting for its lookups once, and publishing the
+     * change once.
+     *
+     * @param readerNames names of the readers, unknown names are ignored
+     * @return the number of readers removed
+     * @since 2.2.0
+     */
+    std::size_t erase(const std::vector<std::string>& readerNames);
+
+    /**
+     * (package-private)<br>
+     * Gets a snapshot of the registered readers. Successive calls return the same snapshot as long
+     * as no reader is added or removed.
+     *
+     * <p>A reader plugged or unplugged concurrently may or may not be part of the snapshot.
+     *
+     * @return a shared immutable snapshot
+     * @since 2.2.0
+     */
+    std::shared_ptr<const Snapshot> getSnapshot() const;
+
+private:
+    /**
+     * (private)<br>
+     * Lets writers wait until the readers which may still access an unlinked object are over,
+     * without the readers ever waiting: a reader counts itself on the counter of the current
+     * epoch, a writer flips the epoch and waits for the counter of the previous one to drain.
+     */
+    class Epoch final {
+    public:
+        /**
+         *
+         */
+        Epoch();
+
+        /**
+         * (private)<br>
+         * Starts a read section.
+         *
+         * @return the counter to pass to leave()
+         */
+        std::size_t enter();
+
+        /**
+         * (private)<br>
+         * Ends a read section.
+         */
+        void leave(const std::size_t counter);
+
+        /**
+         * (private)<br>
+         * Waits until the read sections started before the call are over. Calls must be
+         * serialized.
+         */
+        void synchronize();
+
+    private:
+        /**
+         *
+         */
+        std::atomic<uint64_t> mEpoch;
+
+        /**
+         * Read sections in progress by parity of the epoch they started in
+         */
+        std::atomic<uint64_t> mReaders[2];
+    };
+
+    /**
+     * (private)<br>
+     * Read section of an epoch, for the duration of a scope
+     */
+    class ReadSection final {
+    public:
+        /**
+         *
+         */
+        explicit ReadSection(Epoch& epoch);
+
+        /**
+         *
+         */
+        ~ReadSection();
+
+    private:
+        /**
+         *
+         */
+        Epoch& mEpoch;
+
+        /**
+         *
+         */
+        const std::size_t mCounter;
+    };
+
+    /**
+     * (private)<br>
+     * Registered reader, immutable once linked but for its link
+     */
+    struct Node {
+        /**
+         *
+         */
+        const std::shared_ptr<StubReaderAdapter> mReader;
+
+        /**
+         * Hash of the name of the reader
+         */
+        const std::size_t mHash;
+
+        /**
+         *
+         */
+        std::atomic<Node*> mNext;
+
+        /**
+         *
+         */
+        Node(std::shared_ptr<StubReaderAdapter> reader, const std::size_t hash, Node* next);
+    };
+
+    /**
+     * (private)<br>
+     * Buckets of a shard, replaced by a table twice as large when it gets full
+     */
+    struct Table {
+        /**
+         * Number of buckets minus one, a power of two minus one
+         */
+        const std::size_t mMask;
+
+        /**
+         *
+         */
+        std::unique_ptr<std::atomic<Node*>[]> mBuckets;
+
+        /**
+         *
+         */
+        explicit Table(const std::size_t bucketCount);
+    };
+
+    /**
+     *
+     */
+    struct Shard {
+        /**
+         * Serializes the writers of the shard
+         */
+        std::mutex mMutex;
+
+        /**
+         * Read sections of the lookups in the shard
+         */
+        Epoch mEpoch;
+
+        /**
+         * Current table
+         */
+        std::atomic<Table*> mTable;
+
+        /**
+         * Number of readers, only accessed by the writers
+         */
+        std::size_t mSize;
+
+        /**
+         *
+         */
+        Shard();
+
+        /**
+         * Frees the table and its nodes
+         */
+        ~Shard();
+    };
+
+    /**
+     *
+     */
+    std::vector<std::unique_ptr<Shard>> mShards;
+
+    /**
+     * Incremented after each published change
+     */
+    std::atomic<uint64_t> mVersion;
+
+    /**
+     * Serializes the rebuilds of the snapshot
+     */
+    mutable std::mutex mSnapshotMutex;
+
+    /**
+     * Read sections of the snapshot
+     */
+    mutable Epoch mSnapshotEpoch;
+
+    /**
+     * Holder of the last built snapshot, replaced on rebuild
+     */
+    mutable std::atomic<const std::shared_ptr<const Snapshot>*> mSnapshot;
+
+    /**
+     * (private)<br>
+     * Gets the shard owning a reader name.
+     */
+    Shard& getShard(const std::string& readerName) const;
+
+    /**
+     * (private)<br>
+     * Gets the index of the shard owning a reader name.
+     */
+    std::size_t getShardIndex(const std::string& readerName) const;
+
+    /**
+     * (private)<br>
+     * Gets the bucket of a hash in a table.
+     */
+    std::size_t getBucketIndex(const Table& table, const std::size_t hash) const;
+
+    /**
+     * (private)<br>
+     * Finds the node of a reader in the current table of a shard, in a read section or with the
+     * lock of the shard held.
+     */
+    Node* findNode(const Shard& shard, const std::string& readerName, const std::size_t hash) const;
+
+    /**
+     * (private)<br>
+     * Links a reader in a shard unless already registered, the lock of the shard must be held.
+     *
+     * @return true if the reader has been linked
+     */
+    bool link(Shard& shard, std::shared_ptr<StubReaderAdapter> reader);
+
+    /**
+     * (private)<br>
+     * Unlinks a reader from a shard, the lock of the shard must be held. The node is appended to
+     * the nodes to free once the readers are over.
+     *
+     * @return the unlinked reader or nullptr if not registered
+     */
+    std::shared_ptr<StubReaderAdapter> unlink(Shard& shard,
+                                              const std::string& readerName,
+                                              std::vector<Node*>& unlinkedNodes);
+};
+
+}
+}
+}
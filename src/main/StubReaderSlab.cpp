@@ -0,0 +1,83 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubReaderSlab.h"
+
+#include <cstddef>
+#include <new>
+#include <stddef.h>
+
+/* Keyple Core Util */
+#include "KeypleAssert.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util;
+
+/* The global one, libstdc++ 4.8 does not declare std::max_align_t */
+static_assert(alignof(StubReaderAdapter) <= alignof(::max_align_t),
+              "operator new does not align enough for StubReaderAdapter");
+
+StubReaderSlab::StubReaderSlab(const std::size_t capacity)
+: mStorage(::operator new(capacity * sizeof(StubReaderAdapter))), mReaderCount(0) {}
+
+StubReaderSlab::~StubReaderSlab()
+{
+    while (mReaderCount > 0) {
+        getReader(--mReaderCount)->~StubReaderAdapter();
+    }
+
+    ::operator delete(mStorage);
+}
+
+const std::vector<std::shared_ptr<StubReaderAdapter>> StubReaderSlab::create(
+    const std::vector<std::string>& names,
+    const bool isContactless,
+    const std::vector<std::shared_ptr<StubSmartCard>>& cards)
+{
+    Assert::getInstance().isTrue(cards.empty() || cards.size() == names.size(),
+                                 "one card per reader name");
+
+    std::vector<std::shared_ptr<StubReaderAdapter>> readers;
+    if (names.empty()) {
+        return readers;
+    }
+
+    const std::shared_ptr<StubReaderSlab> slab(new StubReaderSlab(names.size()));
+
+    /* A reader throwing on construction leaves the slab with the readers built so far */
+    for (std::size_t i = 0; i < names.size(); i++) {
+        new (slab->getReader(i)) StubReaderAdapter(names[i],
+                                                   isContactless,
+                                                   cards.empty() ? nullptr : cards[i]);
+        slab->mReaderCount++;
+    }
+
+    /* Each reader keeps the whole slab alive */
+    readers.reserve(names.size());
+    for (std::size_t i = 0; i < names.size(); i++) {
+        readers.push_back(std::shared_ptr<StubReaderAdapter>(slab, slab->getReader(i)));
+    }
+
+    return readers;
+}
+
+StubReaderAdapter* StubReaderSlab::getReader(const std::size_t index) const
+{
+    return static_cast<StubReaderAdapter*>(mStorage) + index;
+}
+
+}
+}
+}
@@ -0,0 +1,100 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+#include "StubReaderAdapter.h"
+#include "StubSmartCard.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+/**
+ * (package-private)<br>
+ * Contiguous block of readers created together, used to plug many readers at once with a single
+ * allocation.
+ *
+ * <p>The readers handed out share the ownership of the slab: its memory is released when the last
+ * of them is released. An unplugged reader is therefore only destroyed with the slab, and keeps its
+ * card and metrics until then.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubReaderSlab final {
+public:
+    /**
+     * (package-private)<br>
+     * Creates the readers in a new slab.
+     *
+     * @param names names of the readers
+     * @param isContactless true if the readers are contactless
+     * @param cards cards inserted in the readers, either empty (no card) or one card (nullable)
+     *        per name
+     * @return the readers, in the order of the names
+     * @since 2.2.0
+     */
+    static const std::vector<std::shared_ptr<StubReaderAdapter>> create(
+        const std::vector<std::string>& names,
+        const bool isContactless,
+        const std::vector<std::shared_ptr<StubSmartCard>>& cards);
+
+    /**
+     * Destroys the readers and releases the memory of the slab.
+     *
+     * @since 2.2.0
+     */
+    ~StubReaderSlab();
+
+    /**
+     *
+     */
+    StubReaderSlab(const StubReaderSlab&) = delete;
+
+    /**
+     *
+     */
+    StubReaderSlab& operator=(const StubReaderSlab&) = delete;
+
+private:
+    /**
+     * Raw memory of the readers
+     */
+    void* mStorage;
+
+    /**
+     * Number of readers constructed in the storage
+     */
+    std::size_t mReaderCount;
+
+    /**
+     * (private)<br>
+     * Allocates the memory for capacity readers.
+     */
+    explicit StubReaderSlab(const std::size_t capacity);
+
+    /**
+     * (private)<br>
+     * Gets the reader at the given index.
+     */
+    StubReaderAdapter* getReader(const std::size_t index) const;
+};
+
+}
+}
+}
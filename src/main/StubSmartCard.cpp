@@ -14,8 +14,8 @@
 
 /* Keyple Core Util */
 #include "HexUtil.h"
+#include "IllegalArgumentException.h"
 #include "KeypleStd.h"
-#include "Pattern.h"
 
 /* Keyple Core Plugin */
 #include "CardIOException.h"
@@ -27,6 +27,7 @@ namespace stub {
 using namespace keyple::core::plugin;
 using namespace keyple::core::util;
 using namespace keyple::core::util::cpp;
+using namespace keyple::core::util::cpp::exception;
 
 /* BUILDER -------------------------------------------------------------------------------------- */
 
@@ -47,7 +48,10 @@ StubSmartCard::SimulatedCommandStep& StubSmartCard::Builder::withSimulatedComman
 std::shared_ptr<StubSmartCard> StubSmartCard::Builder::build()
 {
     return std::shared_ptr<StubSmartCard>(
-               new StubSmartCard(mPowerOnData, mCardProtocol, mHexCommands, mApduResponseProvider));
+               new StubSmartCard(mPowerOnData,
+                                 mCardProtocol,
+                                 std::make_shared<const StubCommandTable>(mHexCommands),
+                                 mApduResponseProvider));
 }
 
 StubSmartCard::ProtocolStep& StubSmartCard::Builder::withPowerOnData(
@@ -102,32 +106,99 @@ void StubSmartCard::closePhysicalChannel()
 
 const std::vector<uint8_t> StubSmartCard::processApdu(const std::vector<uint8_t>& apduIn)
 {
+    std::vector<uint8_t> apduOut;
+    processApdu(apduIn, apduOut);
+
+    return apduOut;
+}
+
+void StubSmartCard::processApdu(const std::vector<uint8_t>& apduIn, std::vector<uint8_t>& apduOut)
+{
+    StubApdu response;
+    processApdu(StubApdu(apduIn), response);
+
+    apduOut.assign(response.begin(), response.end());
+}
+
+void StubSmartCard::processApdu(const StubApdu& apduIn, StubApdu& apduOut)
+{
+#if defined(KEYPLE_STUB_METRICS)
+    /* Records the processing as a miss if it throws */
+    const StubMetrics::Timer timer(mMetrics);
+#endif
+
     if (apduIn.size() == 0) {
-        return std::vector<uint8_t>();
+        apduOut.clear();
+        return;
     }
 
-    /* Convert apduIn to hex */
-    const std::string hexApdu = HexUtil::toHex(apduIn);
+    /* The compiled profile compares the APDU without converting it to hex */
+    if (mProfile != nullptr) {
+        if (mProfile->processApdu(apduIn, apduOut)) {
+            return;
+        }
+
+        throw CardIOException("No response available for this request: " + apduIn.toHex());
+    }
 
     if (mApduResponseProvider != nullptr) {
+#if defined(KEYPLE_STUB_METRICS)
+        mMetrics.recordProviderCall();
+#endif
         const std::string responseFromRequest =
-            mApduResponseProvider->getResponseFromRequest(hexApdu);
+            mApduResponseProvider->getResponseFromRequest(apduIn.toHex());
         if (responseFromRequest != "") {
-            return HexUtil::toByteArray(responseFromRequest);
+            apduOut.assignHex(responseFromRequest);
+            return;
         }
 
-    } else if (!mHexCommands.empty()) {
-        /* Return matching hex response if the provided APDU matches the regex */
-        for (const auto& hexCommand : mHexCommands) {
-            std::unique_ptr<Pattern> p = Pattern::compile(hexCommand.first);
-            if (p->matcher(hexApdu)->matches()) {
-                return HexUtil::toByteArray(hexCommand.second);
-            }
+    } else if (!mCommandTable->empty()) {
+        /* Return matching hex response if the provided APDU matches a command */
+        std::size_t entry;
+        if (mCommandTable->processApdu(apduIn, apduOut, entry)) {
+#if defined(KEYPLE_STUB_METRICS)
+            mMetrics.recordHit(entry);
+#endif
+            return;
         }
     }
 
     /* Throw a CardIOException if not found */
-    throw CardIOException("No response available for this request: " + hexApdu);
+    throw CardIOException("No response available for this request: " + apduIn.toHex());
+}
+
+std::shared_ptr<StubSmartCard> StubSmartCard::copy() const
+{
+    return std::shared_ptr<StubSmartCard>(
+               new StubSmartCard(mPowerOnData,
+                                 mCardProtocol,
+                                 mCommandTable,
+                                 mApduResponseProvider,
+                                 mProfile));
+}
+
+const StubMetrics::CardMetrics StubSmartCard::getMetrics() const
+{
+    StubMetrics::CardMetrics metrics;
+
+#if defined(KEYPLE_STUB_METRICS)
+    std::vector<std::string> hexCommands;
+    hexCommands.reserve(mCommandTable->size());
+    for (std::size_t i = 0; i < mCommandTable->size(); i++) {
+        hexCommands.push_back(mCommandTable->getCommand(i));
+    }
+
+    mMetrics.getMetrics(hexCommands, metrics);
+#endif
+
+    return metrics;
+}
+
+void StubSmartCard::resetMetrics()
+{
+#if defined(KEYPLE_STUB_METRICS)
+    mMetrics.reset();
+#endif
 }
 
 std::ostream& operator<<(std::ostream& os, const std::shared_ptr<StubSmartCard> ssc)
@@ -136,7 +207,7 @@ std::ostream& operator<<(std::ostream& os, const std::shared_ptr<StubSmartCard>
        << "POWER_ON_DATA = " << HexUtil::toHex(ssc->mPowerOnData) << ", "
        << "CARD_PROTOCOL = " << ssc->mCardProtocol << ", "
        << "IS_PHYSICAL_CHANNEL_OPEN = " << ssc->mIsPhysicalChannelOpen << ", "
-       << "HEX_COMMANDS(#) = " << ssc->mHexCommands.size()
+       << "HEX_COMMANDS(#) = " << ssc->mCommandTable->size()
        << "}";
 
     return  os;
@@ -147,15 +218,44 @@ std::unique_ptr<StubSmartCard::PowerOnDataStep> StubSmartCard::builder()
     return std::unique_ptr<Builder>(new Builder());
 }
 
+std::shared_ptr<StubSmartCard> StubSmartCard::fromProfile(
+    const std::shared_ptr<const StubCardProfileLibrary>& library,
+    const std::string& profileName)
+{
+    const std::shared_ptr<const StubCardProfileLibrary::Profile> profile =
+        library->getProfile(profileName);
+
+    if (profile == nullptr) {
+        throw IllegalArgumentException("Unknown card profile " + profileName);
+    }
+
+    /* The profile has no simulated commands as a table, all the cards share an empty one */
+    static const std::shared_ptr<const StubCommandTable> noCommandTable =
+        std::make_shared<const StubCommandTable>(std::map<std::string, std::string>());
+
+    return std::shared_ptr<StubSmartCard>(
+               new StubSmartCard(profile->getPowerOnData(),
+                                 profile->getCardProtocol(),
+                                 noCommandTable,
+                                 nullptr,
+                                 profile));
+}
+
 StubSmartCard::StubSmartCard(const std::vector<uint8_t>& powerOnData,
                              const std::string& cardProtocol,
-                             const std::map<std::string, std::string>& hexCommands,
-                             const std::shared_ptr<ApduResponseProviderSpi> apduResponseProvider)
+                             const std::shared_ptr<const StubCommandTable> commandTable,
+                             const std::shared_ptr<ApduResponseProviderSpi> apduResponseProvider,
+                             const std::shared_ptr<const StubCardProfileLibrary::Profile> profile)
 : mPowerOnData(powerOnData),
   mCardProtocol(cardProtocol),
   mIsPhysicalChannelOpen(false),
-  mHexCommands(hexCommands),
-  mApduResponseProvider(apduResponseProvider) {}
+  mCommandTable(commandTable),
+  mApduResponseProvider(apduResponseProvider),
+  mProfile(profile)
+#if defined(KEYPLE_STUB_METRICS)
+  , mMetrics(commandTable->size())
+#endif
+{}
 
 }
 }
@@ -21,6 +21,10 @@
 /* Keyple Plugin Stub */
 #include "ApduResponseProviderSpi.h"
 #include "KeyplePluginStubExport.h"
+#include "StubApdu.h"
+#include "StubCardProfileLibrary.h"
+#include "StubCommandTable.h"
+#include "StubMetrics.h"
 
 namespace keyple {
 namespace plugin {
@@ -87,6 +91,10 @@ public:
          * Provide simulated command/response to the StubSmartCard using a custom provider
          * implementing of ApduResponseProviderSpi.
          *
+         * <p>A deterministic provider can be wrapped in a StubCachingApduResponseProvider to
+         * memoize its responses, and any provider in a StubLatencyBudgetApduResponseProvider to
+         * watch its latency.
+         *
          * @param apduResponseProvider hexadecimal command to respond to (can be a regexp to match
          *        multiple apdu)
          * @return next step of builder
@@ -218,6 +226,16 @@ public:
      */
     friend class Builder;
 
+    /**
+     *
+     */
+    friend class StubCardProfileLibrary;
+
+    /**
+     *
+     */
+    friend class StubPluginSnapshot;
+
     /**
      * (package-private) <br>
      * Gets the card protocol supported by the card
@@ -271,6 +289,58 @@ public:
      */
     const std::vector<uint8_t> processApdu(const std::vector<uint8_t>& apduIn);
 
+    /**
+     * (package-private) <br>
+     * Return APDU Response to APDU Request into a buffer of the caller, whose capacity is reused.
+     *
+     * <p>Nothing is allocated once the buffer is large enough when the response comes from a
+     * compiled profile or from a simulated command made of plain hexadecimal digits, and no
+     * regular expression is tried before it.
+     *
+     * @param apduIn commands to be processed
+     * @param apduOut replaced by the APDU response
+     * @since 2.2.0
+     */
+    void processApdu(const std::vector<uint8_t>& apduIn, std::vector<uint8_t>& apduOut);
+
+    /**
+     * (package-private) <br>
+     * Return APDU Response to APDU Request, without allocation for the short APDUs under the same
+     * conditions as the vector based overload.
+     *
+     * @param apduIn commands to be processed
+     * @param apduOut replaced by the APDU response
+     * @since 2.2.0
+     */
+    void processApdu(const StubApdu& apduIn, StubApdu& apduOut);
+
+    /**
+     * (package-private) <br>
+     * Creates a new card with the same power-on data, protocol and simulated commands (or APDU
+     * response provider) as this one, with its physical channel closed. The simulated commands
+     * are shared, not copied.
+     *
+     * @return a new card
+     * @since 2.2.0
+     */
+    std::shared_ptr<StubSmartCard> copy() const;
+
+    /**
+     * Gets the metrics of the APDUs processed by the card, empty unless the library is built with
+     * KEYPLE_STUB_METRICS defined.
+     *
+     * @return the metrics
+     * @since 2.2.0
+     */
+    const StubMetrics::CardMetrics getMetrics() const;
+
+    /**
+     * Sets the metrics of the card to zero.
+     *
+     * @since 2.2.0
+     */
+    void resetMetrics();
+
     /**
      * {@inheritDoc}
      *
@@ -286,6 +356,20 @@ public:
      */
     static std::unique_ptr<PowerOnDataStep> builder();
 
+    /**
+     * Creates a card from a profile of a compiled library. The simulated commands of the card are
+     * those of the profile, used in place in the library.
+     *
+     * @param library the library
+     * @param profileName name of the profile
+     * @return a new card
+     * @throw IllegalArgumentException if the library has no such profile
+     * @since 2.2.0
+     */
+    static std::shared_ptr<StubSmartCard> fromProfile(
+        const std::shared_ptr<const StubCardProfileLibrary>& library,
+        const std::string& profileName);
+
 private:
     /**
      *
@@ -303,31 +387,45 @@ private:
     bool mIsPhysicalChannelOpen;
 
     /**
-     *
+     * Immutable, shared by the copies of the card
      */
-    const std::map<std::string, std::string> mHexCommands;
+    const std::shared_ptr<const StubCommandTable> mCommandTable;
 
     /**
      *
      */
     const std::shared_ptr<ApduResponseProviderSpi> mApduResponseProvider;
 
+    /**
+     * Profile of a compiled library providing the simulated commands, nullptr if none
+     */
+    const std::shared_ptr<const StubCardProfileLibrary::Profile> mProfile;
+
+#if defined(KEYPLE_STUB_METRICS)
+    /**
+     * Hits counted by simulated command, in the order of mCommandTable
+     */
+    StubMetrics::Recorder mMetrics;
+#endif
+
     /**
      * (private) <br>
      * Create a simulated smart card with mandatory parameters The response APDU can be provided
-     * using <code>apduResponseProvider</code> if it is not null or <code>hexCommands</code> by
+     * using <code>apduResponseProvider</code> if it is not null or <code>commandTable</code> by
      * default.
      *
      * @param powerOnData (non nullable) power-on data of the card
      * @param cardProtocol (non nullable) card protocol
-     * @param hexCommands (non nullable) set of simulated commands
+     * @param commandTable (non nullable) set of simulated commands (table since 2.2.0)
      * @param apduResponseProvider (nullable) an external provider of simulated commands
+     * @param profile (nullable) compiled profile providing the simulated commands (since 2.2.0)
      * @since 2.0.0
      */
     StubSmartCard(const std::vector<uint8_t>& powerOnData,
                   const std::string& cardProtocol,
-                  const std::map<std::string, std::string>& hexCommands,
-                  const std::shared_ptr<ApduResponseProviderSpi> apduResponseProvider);
+                  const std::shared_ptr<const StubCommandTable> commandTable,
+                  const std::shared_ptr<ApduResponseProviderSpi> apduResponseProvider,
+                  const std::shared_ptr<const StubCardProfileLibrary::Profile> profile = nullptr);
 };
 
 }
@@ -0,0 +1,121 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubTimerWheel.h"
+
+#include <chrono>
+
+/* Keyple Core Util */
+#include "KeypleAssert.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util;
+
+StubTimerWheel::StubTimerWheel(const int tickDuration, const std::size_t wheelSize)
+: mTickDuration(tickDuration), mCurrentSlot(0), mRunning(true)
+{
+    Assert::getInstance().greaterOrEqual(tickDuration, 1, "tickDuration")
+                         .greaterOrEqual(static_cast<int>(wheelSize), 1, "wheelSize");
+
+    mSlots.resize(wheelSize);
+    mThread = std::thread(&StubTimerWheel::run, this);
+}
+
+StubTimerWheel::~StubTimerWheel()
+{
+    stop();
+}
+
+void StubTimerWheel::schedule(const int delay, const Task& task)
+{
+    /*
+     * Round up so that a timer never fires before its deadline, plus the current tick which has
+     * already partly elapsed
+     */
+    const uint64_t ticks = (delay <= 0 ? 0 : (static_cast<uint64_t>(delay) + mTickDuration - 1) /
+                                             mTickDuration) + 1;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (!mRunning) {
+        return;
+    }
+
+    /* The slot is visited for the first time after ((ticks - 1) % size) + 1 ticks */
+    const std::size_t slot = (mCurrentSlot + ticks) % mSlots.size();
+    mSlots[slot].push_back({(ticks - 1) / mSlots.size(), task});
+}
+
+void StubTimerWheel::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRunning = false;
+    }
+
+    mCondition.notify_all();
+
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+void StubTimerWheel::run()
+{
+    auto nextTick = std::chrono::steady_clock::now();
+    std::vector<Task> expiredTasks;
+
+    while (true) {
+        nextTick += std::chrono::milliseconds(mTickDuration);
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+
+            if (mCondition.wait_until(lock, nextTick, [this] { return !mRunning; })) {
+                return;
+            }
+
+            mCurrentSlot = (mCurrentSlot + 1) % mSlots.size();
+
+            /* Collect the expired timers, keep the others for a later turn */
+            std::vector<Timer>& timers = mSlots[mCurrentSlot];
+            std::size_t kept = 0;
+            for (auto& timer : timers) {
+                if (timer.mRounds == 0) {
+                    expiredTasks.push_back(std::move(timer.mTask));
+                } else {
+                    timer.mRounds--;
+                    if (&timers[kept] != &timer) {
+                        timers[kept] = std::move(timer);
+                    }
+                    kept++;
+                }
+            }
+
+            timers.resize(kept);
+        }
+
+        /* Tasks are run without the lock so that they can schedule new timers */
+        for (const auto& task : expiredTasks) {
+            task();
+        }
+
+        expiredTasks.clear();
+    }
+}
+
+}
+}
+}
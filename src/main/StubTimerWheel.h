@@ -0,0 +1,145 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+/**
+ * (package-private)<br>
+ * Hashed timer wheel running delayed tasks on a single background thread, whatever the number of
+ * pending timers.
+ *
+ * <p>Timers cannot be cancelled: a task which became irrelevant (e.g. a renewed lease) is expected
+ * to detect it when it runs and do nothing. A timer never fires before its deadline, and at most
+ * two ticks after it.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubTimerWheel final {
+public:
+    /**
+     * Task run when a timer expires, on the thread of the wheel.
+     *
+     * @since 2.2.0
+     */
+    using Task = std::function<void()>;
+
+    /**
+     * (package-private)<br>
+     * Creates a wheel and starts its thread.
+     *
+     * @param tickDuration resolution of the wheel in milliseconds (strictly positive)
+     * @param wheelSize number of slots of the wheel (strictly positive)
+     * @since 2.2.0
+     */
+    StubTimerWheel(const int tickDuration, const std::size_t wheelSize);
+
+    /**
+     * Stops the wheel, pending timers are discarded.
+     *
+     * @since 2.2.0
+     */
+    ~StubTimerWheel();
+
+    /**
+     * (package-private)<br>
+     * Schedules a task.
+     *
+     * @param delay delay in milliseconds before running the task
+     * @param task the task to run
+     * @since 2.2.0
+     */
+    void schedule(const int delay, const Task& task);
+
+    /**
+     * (package-private)<br>
+     * Stops the thread of the wheel. Pending and later scheduled timers are discarded. Must not be
+     * called from a task.
+     *
+     * @since 2.2.0
+     */
+    void stop();
+
+private:
+    /**
+     *
+     */
+    struct Timer {
+        /**
+         * Remaining complete turns of the wheel before expiration
+         */
+        uint64_t mRounds;
+
+        /**
+         *
+         */
+        Task mTask;
+    };
+
+    /**
+     *
+     */
+    const int mTickDuration;
+
+    /**
+     *
+     */
+    std::vector<std::vector<Timer>> mSlots;
+
+    /**
+     * Index of the last processed slot
+     */
+    std::size_t mCurrentSlot;
+
+    /**
+     *
+     */
+    bool mRunning;
+
+    /**
+     *
+     */
+    std::mutex mMutex;
+
+    /**
+     *
+     */
+    std::condition_variable mCondition;
+
+    /**
+     *
+     */
+    std::thread mThread;
+
+    /**
+     * (private)<br>
+     * Advances the wheel every tick and runs the expired tasks.
+     */
+    void run();
+};
+
+}
+}
+}
@@ -0,0 +1,374 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "StubTracer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+/* Keyple Plugin Stub */
+#include "StubMetrics.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+using namespace keyple::core::util::cpp::exception;
+
+const std::size_t StubTracer::CHUNK_SIZE;
+const std::size_t StubTracer::MAX_EVENT_COUNT;
+const std::size_t StubTracer::MAX_TARGET_LENGTH;
+
+/* Checked on each event, set between start() and stop() */
+static std::atomic<bool> isStarted(false);
+
+/* EVENT ---------------------------------------------------------------------------------------- */
+
+struct StubTracer::Event {
+    /**
+     * String literal
+     */
+    const char* mName;
+
+    /**
+     *
+     */
+    uint64_t mStart;
+
+    /**
+     *
+     */
+    uint64_t mDuration;
+
+    /**
+     * Null terminated, truncated to MAX_TARGET_LENGTH
+     */
+    char mTarget[MAX_TARGET_LENGTH + 1];
+};
+
+/* BUFFER --------------------------------------------------------------------------------------- */
+
+class StubTracer::Buffer final {
+public:
+    /**
+     * Identifier of the thread in the trace
+     */
+    const uint64_t mThreadId;
+
+    /**
+     * Generation of the events, reset by the thread on its first event after start()
+     */
+    std::atomic<uint64_t> mGeneration;
+
+    /**
+     * Number of events published to getChromeTrace()
+     */
+    std::atomic<std::size_t> mCount;
+
+    /**
+     *
+     */
+    std::atomic<uint64_t> mDroppedCount;
+
+    /**
+     * Cleared when the thread exits, the buffer is then freed by the next start()
+     */
+    std::atomic<bool> mIsThreadAlive;
+
+    /**
+     * Chunks of CHUNK_SIZE events, allocated when first needed and never moved
+     */
+    std::atomic<Event*> mChunks[MAX_EVENT_COUNT / CHUNK_SIZE];
+
+    Buffer(const uint64_t threadId, const uint64_t generation)
+    : mThreadId(threadId),
+      mGeneration(generation),
+      mCount(0),
+      mDroppedCount(0),
+      mIsThreadAlive(true)
+    {
+        for (auto& chunk : mChunks) {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~Buffer()
+    {
+        for (auto& chunk : mChunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    Buffer(const Buffer&) = delete;
+
+    Buffer& operator=(const Buffer&) = delete;
+
+    /* Only called by the thread of the buffer */
+    void record(const uint64_t generation,
+                const char* name,
+                const std::string& target,
+                const uint64_t start,
+                const uint64_t end)
+    {
+        if (mGeneration.load(std::memory_order_relaxed) != generation) {
+            mCount.store(0, std::memory_order_relaxed);
+            mDroppedCount.store(0, std::memory_order_relaxed);
+            mGeneration.store(generation, std::memory_order_release);
+        }
+
+        const std::size_t count = mCount.load(std::memory_order_relaxed);
+        if (count == MAX_EVENT_COUNT) {
+            mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::atomic<Event*>& chunk = mChunks[count / CHUNK_SIZE];
+        Event* events = chunk.load(std::memory_order_relaxed);
+        if (events == nullptr) {
+            events = new Event[CHUNK_SIZE];
+            chunk.store(events, std::memory_order_release);
+        }
+
+        Event& event = events[count % CHUNK_SIZE];
+        event.mName = name;
+        event.mStart = start;
+        event.mDuration = end - start;
+
+        const std::size_t length = std::min(target.size(), MAX_TARGET_LENGTH);
+        std::memcpy(event.mTarget, target.data(), length);
+        event.mTarget[length] = '\0';
+
+        /* Publishes the event */
+        mCount.store(count + 1, std::memory_order_release);
+    }
+};
+
+/* REGISTRY ------------------------------------------------------------------------------------- */
+
+struct StubTracer::Registry {
+    /**
+     * Guards mBuffers and mStartTime
+     */
+    std::mutex mMutex;
+
+    /**
+     *
+     */
+    std::vector<std::unique_ptr<Buffer>> mBuffers;
+
+    /**
+     * Incremented by start(), the events of an older generation are discarded
+     */
+    std::atomic<uint64_t> mGeneration;
+
+    /**
+     * Origin of the timestamps of the trace
+     */
+    uint64_t mStartTime;
+
+    /**
+     *
+     */
+    uint64_t mLastThreadId;
+
+    Registry() : mGeneration(0), mStartTime(0), mLastThreadId(0) {}
+};
+
+/* SCOPE ---------------------------------------------------------------------------------------- */
+
+StubTracer::Scope::Scope(const char* name, const std::string& target)
+: mName(name),
+  mTarget(target),
+  mStart(isStarted.load(std::memory_order_relaxed) ? StubMetrics::now() : 0) {}
+
+StubTracer::Scope::~Scope()
+{
+    if (mStart == 0) {
+        return;
+    }
+
+    const uint64_t end = StubMetrics::now();
+    getBuffer().record(getRegistry().mGeneration.load(std::memory_order_relaxed),
+                       mName,
+                       mTarget,
+                       mStart,
+                       end);
+}
+
+/* STUB TRACER ---------------------------------------------------------------------------------- */
+
+bool StubTracer::isEnabled()
+{
+#if defined(KEYPLE_STUB_TRACE)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void StubTracer::start()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+
+    /* Buffers of the threads which exited are no longer written */
+    registry.mBuffers.erase(
+        std::remove_if(registry.mBuffers.begin(),
+                       registry.mBuffers.end(),
+                       [](const std::unique_ptr<Buffer>& buffer) {
+                           return !buffer->mIsThreadAlive.load(std::memory_order_acquire);
+                       }),
+        registry.mBuffers.end());
+
+    registry.mStartTime = StubMetrics::now();
+    registry.mGeneration++;
+    isStarted = true;
+}
+
+void StubTracer::stop()
+{
+    isStarted = false;
+}
+
+uint64_t StubTracer::getDroppedEventCount()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+
+    uint64_t droppedEventCount = 0;
+    for (const auto& buffer : registry.mBuffers) {
+        if (buffer->mGeneration.load(std::memory_order_acquire) == registry.mGeneration) {
+            droppedEventCount += buffer->mDroppedCount.load(std::memory_order_relaxed);
+        }
+    }
+
+    return droppedEventCount;
+}
+
+const std::string StubTracer::getChromeTrace()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mMutex);
+
+    std::ostringstream trace;
+    trace << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool isFirst = true;
+    char timestamps[64];
+    for (const auto& buffer : registry.mBuffers) {
+        if (buffer->mGeneration.load(std::memory_order_acquire) != registry.mGeneration) {
+            /* No event since start() */
+            continue;
+        }
+
+        trace << (isFirst ? "" : ",")
+              << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->mThreadId
+              << ",\"args\":{\"name\":\"thread " << buffer->mThreadId << "\"}}";
+        isFirst = false;
+
+        const std::size_t count = buffer->mCount.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; i++) {
+            const Event& event =
+                buffer->mChunks[i / CHUNK_SIZE].load(std::memory_order_acquire)[i % CHUNK_SIZE];
+
+            /* Microseconds, with the nanoseconds as decimals */
+            const uint64_t start =
+                event.mStart > registry.mStartTime ? event.mStart - registry.mStartTime : 0;
+            std::snprintf(timestamps,
+                          sizeof(timestamps),
+                          "\"ts\":%llu.%03llu,\"dur\":%llu.%03llu",
+                          static_cast<unsigned long long>(start / 1000),
+                          static_cast<unsigned long long>(start % 1000),
+                          static_cast<unsigned long long>(event.mDuration / 1000),
+                          static_cast<unsigned long long>(event.mDuration % 1000));
+
+            trace << ",{\"name\":\"" << event.mName << "\",\"cat\":\"stub\",\"ph\":\"X\","
+                  << timestamps << ",\"pid\":1,\"tid\":" << buffer->mThreadId
+                  << ",\"args\":{\"target\":\"";
+
+            for (const char* c = event.mTarget; *c != '\0'; c++) {
+                if (*c == '"' || *c == '\\') {
+                    trace << '\\' << *c;
+                } else if (static_cast<unsigned char>(*c) < 0x20) {
+                    trace << ' ';
+                } else {
+                    trace << *c;
+                }
+            }
+
+            trace << "\"}}";
+        }
+    }
+
+    trace << "]}";
+
+    return trace.str();
+}
+
+void StubTracer::writeChromeTrace(const std::string& path)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << getChromeTrace();
+    if (!file.good()) {
+        throw IllegalArgumentException("Unable to write the trace file " + path);
+    }
+}
+
+StubTracer::Registry& StubTracer::getRegistry()
+{
+    /* Never destroyed, threads may still exit after the static destructors ran */
+    static Registry* const registry = new Registry();
+
+    return *registry;
+}
+
+StubTracer::Buffer& StubTracer::getBuffer()
+{
+    /* Marks the buffer as no longer written when the thread exits */
+    struct BufferHolder {
+        Buffer* mBuffer = nullptr;
+
+        ~BufferHolder()
+        {
+            if (mBuffer != nullptr) {
+                mBuffer->mIsThreadAlive.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local BufferHolder holder;
+
+    if (holder.mBuffer == nullptr) {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mMutex);
+
+        registry.mBuffers.push_back(std::unique_ptr<Buffer>(
+            new Buffer(++registry.mLastThreadId, registry.mGeneration)));
+        holder.mBuffer = registry.mBuffers.back().get();
+    }
+
+    return *holder.mBuffer;
+}
+
+}
+}
+}
@@ -0,0 +1,199 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/* Keyple Plugin Stub */
+#include "KeyplePluginStubExport.h"
+
+namespace keyple {
+namespace plugin {
+namespace stub {
+
+/**
+ * Timeline of the activity of the readers and the cards, in the Chrome trace event format, which
+ * chrome://tracing and the Perfetto UI open.
+ *
+ * <p>Card insertions and removals, physical channel openings, APDU transmissions and pool
+ * allocations and releases are recorded as complete events (begin time and duration) with their
+ * target, the name of the reader or the group reference of an allocation, in a buffer per thread.
+ * Recording takes two clock reads and a copy into the buffer of the thread, without lock nor
+ * allocation except once every CHUNK_SIZE events.
+ *
+ * <p>Events are only recorded when the library is built with KEYPLE_STUB_TRACE defined (CMake
+ * option of the same name), between start() and stop(). Otherwise the recording code is compiled
+ * out and the trace is always empty.
+ *
+ * @since 2.2.0
+ */
+class KEYPLEPLUGINSTUB_API StubTracer final {
+public:
+    /**
+     * Number of events allocated at once in the buffer of a thread.
+     *
+     * @since 2.2.0
+     */
+    static const std::size_t CHUNK_SIZE = 1024;
+
+    /**
+     * Maximum number of events recorded by a thread between start() and stop(), the following
+     * ones are dropped.
+     *
+     * @since 2.2.0
+     */
+    static const std::size_t MAX_EVENT_COUNT = 1024 * CHUNK_SIZE;
+
+    /**
+     * Maximum length of the target of an event, longer targets are truncated.
+     *
+     * @since 2.2.0
+     */
+    static const std::size_t MAX_TARGET_LENGTH = 39;
+
+    /**
+     * (package-private)<br>
+     * Records the scope of an operation as an event, if the tracer is started.
+     *
+     * @since 2.2.0
+     */
+    class KEYPLEPLUGINSTUB_API Scope final {
+    public:
+        /**
+         * (package-private)<br>
+         * Starts the event.
+         *
+         * @param name name of the operation, a string literal
+         * @param target name of the reader, or group reference of an allocation, which must
+         *        outlive the scope
+         * @since 2.2.0
+         */
+        Scope(const char* name, const std::string& target);
+
+        /**
+         * Records the event.
+         */
+        ~Scope();
+
+        /**
+         *
+         */
+        Scope(const Scope&) = delete;
+
+        /**
+         *
+         */
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        /**
+         *
+         */
+        const char* const mName;
+
+        /**
+         *
+         */
+        const std::string& mTarget;
+
+        /**
+         * 0 if the tracer was not started
+         */
+        const uint64_t mStart;
+    };
+
+    /**
+     * Indicates whether the library records events.
+     *
+     * @return true if built with KEYPLE_STUB_TRACE defined
+     * @since 2.2.0
+     */
+    static bool isEnabled();
+
+    /**
+     * Discards the events recorded so far and starts recording.
+     *
+     * @since 2.2.0
+     */
+    static void start();
+
+    /**
+     * Stops recording, the events recorded are kept until the next start().
+     *
+     * @since 2.2.0
+     */
+    static void stop();
+
+    /**
+     * Gets the number of events dropped since start() because a thread recorded more than
+     * MAX_EVENT_COUNT events.
+     *
+     * @return a positive number
+     * @since 2.2.0
+     */
+    static uint64_t getDroppedEventCount();
+
+    /**
+     * Renders the events recorded since start() in the Chrome trace event JSON format. Can be
+     * called while events are being recorded, the events recorded meanwhile may be missing.
+     *
+     * @return the trace
+     * @since 2.2.0
+     */
+    static const std::string getChromeTrace();
+
+    /**
+     * Writes the trace rendered by getChromeTrace() to a file.
+     *
+     * @param path the path of the file
+     * @throw IllegalArgumentException if the file cannot be written
+     * @since 2.2.0
+     */
+    static void writeChromeTrace(const std::string& path);
+
+private:
+    /**
+     * (private)<br>
+     * Event of the buffer of a thread
+     */
+    struct Event;
+
+    /**
+     * (private)<br>
+     * Events of a thread
+     */
+    class Buffer;
+
+    /**
+     * (private)<br>
+     * Buffers of all the threads, guarded by a mutex
+     */
+    struct Registry;
+
+    /**
+     * (private)<br>
+     * Gets the registry, created on first use.
+     */
+    static Registry& getRegistry();
+
+    /**
+     * (private)<br>
+     * Gets the buffer of the calling thread, registering it if needed.
+     */
+    static Buffer& getBuffer();
+};
+
+}
+}
+}
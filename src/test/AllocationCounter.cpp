@@ -0,0 +1,126 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "AllocationCounter.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <stddef.h>
+
+/* Per thread, so that threads left running by other tests do not disturb the measures */
+static thread_local uint64_t allocationCount = 0;
+static thread_local int64_t liveBytes = 0;
+
+/*
+ * The size is stored before the block, keeping the alignment of malloc. The global one, libstdc++
+ * 4.8 does not declare std::max_align_t
+ */
+static const std::size_t HEADER_SIZE = alignof(::max_align_t);
+
+static void* allocate(const std::size_t size, const std::nothrow_t&) noexcept
+{
+    void* const block = std::malloc(HEADER_SIZE + size);
+    if (block == nullptr) {
+        return nullptr;
+    }
+
+    *static_cast<std::size_t*>(block) = size;
+    allocationCount++;
+    liveBytes += static_cast<int64_t>(size);
+
+    return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+static void* allocate(const std::size_t size)
+{
+    void* const ptr = allocate(size, std::nothrow);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+static void deallocate(void* const ptr) noexcept
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    /* Blocks freed by another thread than the allocating one are counted by the freeing one */
+    void* const block = static_cast<char*>(ptr) - HEADER_SIZE;
+    liveBytes -= static_cast<int64_t>(*static_cast<std::size_t*>(block));
+    std::free(block);
+}
+
+/* Every form is replaced, a block must never be freed by a form not matching its allocation */
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return allocate(size, tag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return allocate(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+uint64_t AllocationCounter::getAllocationCount()
+{
+    return allocationCount;
+}
+
+int64_t AllocationCounter::getLiveBytes()
+{
+    return liveBytes;
+}
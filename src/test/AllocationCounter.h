@@ -0,0 +1,38 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Counts the heap allocations of the test executable, by replacing all the forms of the global
+ * operator new and operator delete. Counts are kept per thread.
+ */
+class AllocationCounter final {
+public:
+    /**
+     * @return the number of allocations made by the calling thread since its start
+     */
+    static uint64_t getAllocationCount();
+
+    /**
+     * @return the number of bytes allocated minus the number of bytes freed by the calling thread
+     */
+    static int64_t getLiveBytes();
+
+private:
+    /**
+     *
+     */
+    AllocationCounter() {}
+};
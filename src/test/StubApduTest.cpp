@@ -0,0 +1,90 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "AllocationCounter.h"
+#include "StubApdu.h"
+
+using namespace testing;
+
+using namespace keyple::plugin::stub;
+
+TEST(StubApduTest, shortApdu_shouldBeStoredInline)
+{
+    const std::vector<uint8_t> bytes(StubApdu::INLINE_CAPACITY, 0x5A);
+
+    const uint64_t allocationCount = AllocationCounter::getAllocationCount();
+    StubApdu apdu(bytes);
+    StubApdu copy = apdu;
+    const uint64_t inlineAllocationCount = AllocationCounter::getAllocationCount();
+
+    ASSERT_EQ(inlineAllocationCount, allocationCount);
+    ASSERT_TRUE(copy.isInline());
+    ASSERT_EQ(copy.size(), StubApdu::INLINE_CAPACITY);
+    ASSERT_EQ(copy.toVector(), bytes);
+    ASSERT_TRUE(copy == apdu);
+}
+
+TEST(StubApduTest, extendedApdu_shouldSpillToTheHeap)
+{
+    std::vector<uint8_t> bytes(StubApdu::INLINE_CAPACITY + 1);
+    for (std::size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<uint8_t>(i);
+    }
+
+    StubApdu apdu(std::vector<uint8_t>({0x00, 0xB2}));
+    apdu.assign(bytes.data(), bytes.size());
+
+    ASSERT_FALSE(apdu.isInline());
+    ASSERT_GE(apdu.capacity(), bytes.size());
+    ASSERT_EQ(apdu.toVector(), bytes);
+
+    /* The heap storage is kept for the next APDUs */
+    apdu.assign(bytes.data(), 2);
+    ASSERT_FALSE(apdu.isInline());
+    ASSERT_EQ(apdu.toVector(), std::vector<uint8_t>({0x00, 0x01}));
+}
+
+TEST(StubApduTest, resize_shouldKeepTheFirstBytes)
+{
+    StubApdu apdu(std::vector<uint8_t>({0x90, 0x00}));
+    apdu.resize(StubApdu::INLINE_CAPACITY * 2);
+
+    ASSERT_EQ(apdu.size(), StubApdu::INLINE_CAPACITY * 2);
+    ASSERT_EQ(apdu[0], 0x90);
+    ASSERT_EQ(apdu[1], 0x00);
+
+    apdu.clear();
+    ASSERT_TRUE(apdu.empty());
+}
+
+TEST(StubApduTest, move_shouldTakeTheHeapStorage)
+{
+    StubApdu apdu(std::vector<uint8_t>(StubApdu::INLINE_CAPACITY * 2, 0x11));
+    const uint8_t* const data = apdu.data();
+
+    StubApdu moved(std::move(apdu));
+
+    ASSERT_EQ(moved.data(), data);
+    ASSERT_EQ(moved.size(), StubApdu::INLINE_CAPACITY * 2);
+    ASSERT_TRUE(apdu.empty());
+    ASSERT_TRUE(apdu.isInline());
+}
+
+TEST(StubApduTest, toHex_shouldUseUpperCaseDigits)
+{
+    ASSERT_EQ(StubApdu({0x00, 0xA4, 0x6f, 0xFF}).toHex(), "00A46FFF");
+    ASSERT_EQ(StubApdu().toHex(), "");
+}
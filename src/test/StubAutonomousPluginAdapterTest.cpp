@@ -0,0 +1,192 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubAutonomousPluginAdapter.h"
+#include "StubPluginFactoryAdapter.h"
+#include "StubPluginFactoryBuilder.h"
+#include "StubSmartCard.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::plugin::stub;
+
+using StubReaderConfiguration = StubPluginFactoryAdapter::StubReaderConfiguration;
+
+static const std::string NAME = "name";
+static const std::string READER_NAME = "reader";
+static const std::string READER_NAME_2 = "reader2";
+
+class AutonomousObservablePluginApiMock : public AutonomousObservablePluginApi {
+public:
+    void onReaderConnected(const std::vector<std::shared_ptr<ReaderSpi>>& readers) override
+    {
+        for (const auto& reader : readers) {
+            connectedReaders.push_back(reader->getName());
+        }
+
+        connectedEvents++;
+    }
+
+    void onReaderDisconnected(const std::vector<std::string>& readerNames) override
+    {
+        disconnectedReaders.insert(disconnectedReaders.end(),
+                                   readerNames.begin(),
+                                   readerNames.end());
+
+        disconnectedEvents++;
+    }
+
+    std::vector<std::string> connectedReaders;
+    std::vector<std::string> disconnectedReaders;
+    int connectedEvents = 0;
+    int disconnectedEvents = 0;
+};
+
+static std::shared_ptr<StubAutonomousPluginAdapter> pluginAdapter;
+static std::shared_ptr<AutonomousObservablePluginApiMock> api;
+
+static void setUp()
+{
+    const StubPluginFactoryAdapter::ReaderConfigurations readerConfigurations =
+        std::make_shared<const std::vector<std::shared_ptr<StubReaderConfiguration>>>();
+
+    pluginAdapter = std::make_shared<StubAutonomousPluginAdapter>(NAME, readerConfigurations);
+    api = std::make_shared<AutonomousObservablePluginApiMock>();
+    pluginAdapter->connect(api.get());
+}
+
+static void tearDown()
+{
+    pluginAdapter.reset();
+    api.reset();
+}
+
+TEST(StubAutonomousPluginAdapterTest, plugReader_should_notify_connected_reader)
+{
+    setUp();
+
+    pluginAdapter->plugReader(READER_NAME, true, nullptr);
+
+    ASSERT_EQ(api->connectedReaders, std::vector<std::string>({READER_NAME}));
+    ASSERT_EQ(pluginAdapter->searchAvailableReaders().size(), 1);
+
+    /* Already plugged */
+    pluginAdapter->plugReader(READER_NAME, true, nullptr);
+
+    ASSERT_EQ(api->connectedEvents, 1);
+
+    tearDown();
+}
+
+TEST(StubAutonomousPluginAdapterTest, unplugReader_should_notify_disconnected_reader)
+{
+    setUp();
+
+    pluginAdapter->plugReader(READER_NAME, true, nullptr);
+    pluginAdapter->unplugReader(READER_NAME);
+    pluginAdapter->unplugReader(READER_NAME);
+
+    ASSERT_EQ(api->disconnectedReaders, std::vector<std::string>({READER_NAME}));
+    ASSERT_EQ(api->disconnectedEvents, 1);
+    ASSERT_EQ(pluginAdapter->searchReader(READER_NAME), nullptr);
+
+    tearDown();
+}
+
+TEST(StubAutonomousPluginAdapterTest, plugReaders_should_notify_new_readers_in_one_event)
+{
+    setUp();
+
+    pluginAdapter->plugReader(READER_NAME, true, nullptr);
+    pluginAdapter->plugReaders({READER_NAME, READER_NAME_2, READER_NAME_2}, false, {});
+
+    ASSERT_EQ(api->connectedEvents, 2);
+    ASSERT_EQ(api->connectedReaders, std::vector<std::string>({READER_NAME, READER_NAME_2}));
+
+    pluginAdapter->unplugReaders({READER_NAME, READER_NAME_2, "unknown"});
+
+    ASSERT_EQ(api->disconnectedEvents, 1);
+    ASSERT_EQ(api->disconnectedReaders, std::vector<std::string>({READER_NAME, READER_NAME_2}));
+
+    tearDown();
+}
+
+TEST(StubAutonomousPluginAdapterTest, onUnregister_should_stop_notifications)
+{
+    setUp();
+
+    pluginAdapter->onUnregister();
+    pluginAdapter->plugReader(READER_NAME, true, nullptr);
+
+    ASSERT_EQ(api->connectedEvents, 0);
+    ASSERT_NE(pluginAdapter->searchReader(READER_NAME), nullptr);
+
+    tearDown();
+}
+
+TEST(StubAutonomousPluginAdapterTest, restoreSnapshot_should_notify_replaced_readers)
+{
+    setUp();
+
+    pluginAdapter->plugReaders({READER_NAME, READER_NAME_2}, true, {});
+    const std::vector<uint8_t> snapshot = pluginAdapter->createSnapshot();
+
+    pluginAdapter->unplugReader(READER_NAME_2);
+    pluginAdapter->plugReader("reader3", false, nullptr);
+    const std::shared_ptr<ReaderSpi> reader = pluginAdapter->searchReader(READER_NAME);
+    api = std::make_shared<AutonomousObservablePluginApiMock>();
+    pluginAdapter->connect(api.get());
+
+    pluginAdapter->restoreSnapshot(snapshot);
+
+    ASSERT_EQ(api->disconnectedEvents, 1);
+    ASSERT_EQ(api->disconnectedReaders, std::vector<std::string>({READER_NAME, "reader3"}));
+    ASSERT_EQ(api->connectedEvents, 1);
+    ASSERT_EQ(api->connectedReaders, std::vector<std::string>({READER_NAME, READER_NAME_2}));
+    ASSERT_NE(pluginAdapter->searchReader(READER_NAME), reader);
+
+    tearDown();
+}
+
+TEST(StubAutonomousPluginAdapterTest, getPrometheusMetrics_should_render_plugin_metrics)
+{
+    setUp();
+
+    pluginAdapter->plugReaders({READER_NAME, READER_NAME_2}, true, {});
+
+    ASSERT_NE(pluginAdapter->getPrometheusMetrics().find(
+                  "keyple_stub_plugin_readers{plugin=\"name\"} 2\n"),
+              std::string::npos);
+
+    tearDown();
+}
+
+TEST(StubAutonomousPluginAdapterTest, factory_with_autonomous_observation_should_build_adapter)
+{
+    const auto factory = std::dynamic_pointer_cast<StubPluginFactoryAdapter>(
+                             StubPluginFactoryBuilder::builder()
+                                 ->withStubReader(READER_NAME, true, nullptr)
+                                 .withAutonomousObservation()
+                                 .build());
+
+    const auto plugin = std::dynamic_pointer_cast<StubAutonomousPluginAdapter>(factory->getPlugin());
+
+    ASSERT_NE(plugin, nullptr);
+    ASSERT_EQ(plugin->getName(), StubPluginFactoryBuilder::PLUGIN_NAME);
+    ASSERT_EQ(plugin->searchAvailableReaders().size(), 1);
+    ASSERT_NE(std::dynamic_pointer_cast<StubPlugin>(plugin), nullptr);
+}
@@ -0,0 +1,162 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubCachingApduResponseProvider.h"
+#include "StubSmartCard.h"
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+#include "IllegalArgumentException.h"
+
+using namespace testing;
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+using namespace keyple::plugin::stub;
+using namespace keyple::plugin::stub::spi;
+
+/* Answers the request followed by 9000, counting its calls */
+class CountingApduResponseProvider : public ApduResponseProviderSpi {
+public:
+    std::atomic<int> mCallCount;
+
+    CountingApduResponseProvider() : mCallCount(0) {}
+
+    const std::string getResponseFromRequest(const std::string& apduRequest) override
+    {
+        mCallCount++;
+
+        return apduRequest + "9000";
+    }
+};
+
+TEST(StubCachingApduResponseProviderTest, constructor_withInvalidArguments_shouldThrow_IAE)
+{
+    const auto provider = std::make_shared<CountingApduResponseProvider>();
+
+    EXPECT_THROW(StubCachingApduResponseProvider(nullptr, 1), IllegalArgumentException);
+    EXPECT_THROW(StubCachingApduResponseProvider(provider, 0), IllegalArgumentException);
+    EXPECT_THROW(StubCachingApduResponseProvider(provider, 1, -1), IllegalArgumentException);
+    EXPECT_THROW(StubCachingApduResponseProvider(provider, 1, 0, 0), IllegalArgumentException);
+}
+
+TEST(StubCachingApduResponseProviderTest, card_shouldCallTheProviderOncePerRequest)
+{
+    const auto provider = std::make_shared<CountingApduResponseProvider>();
+    const auto cache = std::make_shared<StubCachingApduResponseProvider>(provider, 16);
+
+    const std::shared_ptr<StubSmartCard> card =
+        StubSmartCard::builder()->withPowerOnData(std::vector<uint8_t>(1))
+                                 .withProtocol("protocol")
+                                 .withApduResponseProvider(cache)
+                                 .build();
+
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(card->processApdu(HexUtil::toByteArray("00B2010400")),
+                  HexUtil::toByteArray("00B20104009000"));
+        ASSERT_EQ(card->processApdu(HexUtil::toByteArray("00B2020400")),
+                  HexUtil::toByteArray("00B20204009000"));
+    }
+
+    ASSERT_EQ(provider->mCallCount, 2);
+    ASSERT_EQ(cache->getHitCount(), 4);
+    ASSERT_EQ(cache->getMissCount(), 2);
+    ASSERT_EQ(cache->getSize(), 2);
+}
+
+TEST(StubCachingApduResponseProviderTest, getResponseFromRequest_whenFull_shouldEvictTheLeastRecent)
+{
+    const auto provider = std::make_shared<CountingApduResponseProvider>();
+    StubCachingApduResponseProvider cache(provider, 2, 0, 1);
+
+    cache.getResponseFromRequest("01");
+    cache.getResponseFromRequest("02");
+    cache.getResponseFromRequest("01");
+    cache.getResponseFromRequest("03");
+
+    ASSERT_EQ(cache.getSize(), 2);
+    ASSERT_EQ(provider->mCallCount, 3);
+
+    /* 02 was the least recently used */
+    cache.getResponseFromRequest("01");
+    ASSERT_EQ(provider->mCallCount, 3);
+    cache.getResponseFromRequest("02");
+    ASSERT_EQ(provider->mCallCount, 4);
+}
+
+TEST(StubCachingApduResponseProviderTest, getResponseFromRequest_shouldKeepAtMostTheCapacity)
+{
+    const auto provider = std::make_shared<CountingApduResponseProvider>();
+    StubCachingApduResponseProvider smallCache(provider, 1);
+    StubCachingApduResponseProvider cache(provider, 10, 0, 4);
+    StubCachingApduResponseProvider largeCache(provider, static_cast<std::size_t>(INT_MAX) + 1);
+
+    for (int i = 0; i < 256; i++) {
+        const std::string request = HexUtil::toHex(static_cast<uint8_t>(i));
+        smallCache.getResponseFromRequest(request);
+        cache.getResponseFromRequest(request);
+        largeCache.getResponseFromRequest(request);
+    }
+
+    ASSERT_EQ(smallCache.getSize(), 1);
+    ASSERT_EQ(cache.getSize(), 10);
+    ASSERT_EQ(largeCache.getSize(), 256);
+}
+
+TEST(StubCachingApduResponseProviderTest, getResponseFromRequest_whenExpired_shouldCallTheProvider)
+{
+    const auto provider = std::make_shared<CountingApduResponseProvider>();
+    StubCachingApduResponseProvider cache(provider, 16, 20);
+
+    cache.getResponseFromRequest("01");
+    cache.getResponseFromRequest("01");
+    ASSERT_EQ(provider->mCallCount, 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(cache.getResponseFromRequest("01"), "019000");
+    ASSERT_EQ(provider->mCallCount, 2);
+    ASSERT_EQ(cache.getMissCount(), 2);
+}
+
+TEST(StubCachingApduResponseProviderTest, getResponseFromRequest_fromManyThreads_shouldCountAll)
+{
+    const auto provider = std::make_shared<CountingApduResponseProvider>();
+    StubCachingApduResponseProvider cache(provider, 1024);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++) {
+        threads.push_back(std::thread([&cache]() {
+            for (int j = 0; j < 1000; j++) {
+                cache.getResponseFromRequest(HexUtil::toHex(static_cast<uint8_t>(j % 32)));
+            }
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(cache.getHitCount() + cache.getMissCount(), 8000);
+    ASSERT_EQ(cache.getSize(), 32);
+
+    cache.clear();
+    ASSERT_EQ(cache.getSize(), 0);
+}
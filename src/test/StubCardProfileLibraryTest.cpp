@@ -0,0 +1,188 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubCardProfileLibrary.h"
+#include "StubSmartCard.h"
+
+/* Keyple Core Plugin */
+#include "CardIOException.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::core::util::cpp::exception;
+using namespace keyple::plugin::stub;
+
+static const std::string PATH = "StubCardProfileLibraryTest.kscp";
+static std::map<std::string, std::shared_ptr<StubSmartCard>> profiles;
+
+static void setUp()
+{
+    profiles["calypso"] = StubSmartCard::builder()->withPowerOnData({0x3B, 0x88, 0x80})
+                                                   .withProtocol("ISO_14443_4")
+                                                   .withSimulatedCommand("00A4040005", "6F009000")
+                                                   .withSimulatedCommand("00B2.*", "0102039000")
+                                                   .withSimulatedCommand("00b4", "6D00")
+                                                   .build();
+    profiles["empty"] = StubSmartCard::builder()->withPowerOnData({0x3B})
+                                                 .withProtocol("ISO_7816_3")
+                                                 .build();
+
+    StubCardProfileLibrary::compile(profiles, PATH);
+}
+
+static void tearDown()
+{
+    profiles.clear();
+    std::remove(PATH.c_str());
+}
+
+TEST(StubCardProfileLibraryTest, load_should_find_compiled_profiles)
+{
+    setUp();
+
+    const auto library = StubCardProfileLibrary::load(PATH);
+
+    ASSERT_EQ(library->getProfileNames(), std::vector<std::string>({"calypso", "empty"}));
+    ASSERT_NE(library->getProfile("calypso"), nullptr);
+    ASSERT_NE(library->getProfile("empty"), nullptr);
+    ASSERT_EQ(library->getProfile("unknown"), nullptr);
+
+    tearDown();
+}
+
+TEST(StubCardProfileLibraryTest, fromProfile_should_behave_as_the_compiled_card)
+{
+    setUp();
+
+    const auto card = StubSmartCard::fromProfile(StubCardProfileLibrary::load(PATH), "calypso");
+    const auto source = profiles["calypso"];
+
+    ASSERT_EQ(card->getPowerOnData(), source->getPowerOnData());
+    ASSERT_EQ(card->getCardProtocol(), source->getCardProtocol());
+
+    const std::vector<std::vector<uint8_t>> apdus = {
+        {0x00, 0xA4, 0x04, 0x00, 0x05}, {0x00, 0xB2, 0x01, 0x04}, {0x00, 0xB2}
+    };
+    for (const auto& apdu : apdus) {
+        ASSERT_EQ(card->processApdu(apdu), source->processApdu(apdu));
+    }
+
+    /* Lower case commands never match the upper case form of the APDU, whatever the card */
+    EXPECT_THROW(source->processApdu({0x00, 0xB4}), CardIOException);
+    EXPECT_THROW(card->processApdu({0x00, 0xB4}), CardIOException);
+    EXPECT_THROW(card->processApdu({0x00, 0xA4}), CardIOException);
+
+    /* The copies share the profile */
+    ASSERT_EQ(card->copy()->processApdu(apdus[0]), source->processApdu(apdus[0]));
+
+    tearDown();
+}
+
+TEST(StubCardProfileLibraryTest, cards_should_keep_the_library_loaded)
+{
+    setUp();
+
+    std::shared_ptr<StubSmartCard> card;
+    {
+        card = StubSmartCard::fromProfile(StubCardProfileLibrary::load(PATH), "calypso");
+    }
+
+    ASSERT_EQ(card->processApdu({0x00, 0xA4, 0x04, 0x00, 0x05}),
+              std::vector<uint8_t>({0x6F, 0x00, 0x90, 0x00}));
+
+    tearDown();
+}
+
+TEST(StubCardProfileLibraryTest, fromProfile_with_unknown_profile_should_throw_IAE)
+{
+    setUp();
+
+    EXPECT_THROW(StubSmartCard::fromProfile(StubCardProfileLibrary::load(PATH), "unknown"),
+                 IllegalArgumentException);
+
+    tearDown();
+}
+
+TEST(StubCardProfileLibraryTest, load_invalid_file_should_throw_IAE)
+{
+    setUp();
+
+    EXPECT_THROW(StubCardProfileLibrary::load("missing.kscp"), IllegalArgumentException);
+
+    {
+        std::ofstream file(PATH, std::ios::out | std::ios::binary | std::ios::trunc);
+        file << "not a library";
+    }
+    EXPECT_THROW(StubCardProfileLibrary::load(PATH), IllegalArgumentException);
+
+    /* A library cut short is detected rather than read out of the file */
+    StubCardProfileLibrary::compile(profiles, PATH);
+    std::string content;
+    {
+        std::ifstream file(PATH, std::ios::in | std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(PATH, std::ios::out | std::ios::binary | std::ios::trunc);
+        file << content.substr(0, content.size() - 4);
+    }
+    EXPECT_THROW(StubCardProfileLibrary::load(PATH), IllegalArgumentException);
+
+    tearDown();
+}
+
+TEST(StubCardProfileLibraryTest, compile_card_with_invalid_response_should_throw_IAE)
+{
+    setUp();
+
+    profiles["invalid"] = StubSmartCard::builder()->withPowerOnData({0x3B})
+                                                   .withProtocol("ISO_7816_3")
+                                                   .withSimulatedCommand("00A4", "90G0")
+                                                   .build();
+
+    EXPECT_THROW(StubCardProfileLibrary::compile(profiles, PATH), IllegalArgumentException);
+
+    tearDown();
+}
+
+TEST(StubCardProfileLibraryTest, load_with_invalid_regex_should_throw_only_when_reached)
+{
+    setUp();
+
+    profiles["invalid"] = StubSmartCard::builder()->withPowerOnData({0x3B})
+                                                   .withProtocol("ISO_7816_3")
+                                                   .withSimulatedCommand("00A4040005", "9000")
+                                                   .withSimulatedCommand("00B2[", "9000")
+                                                   .build();
+    StubCardProfileLibrary::compile(profiles, PATH);
+
+    const auto card = StubSmartCard::fromProfile(StubCardProfileLibrary::load(PATH), "invalid");
+
+    /* The plain command sorts before the invalid expression, which is not reached */
+    ASSERT_EQ(card->processApdu({0x00, 0xA4, 0x04, 0x00, 0x05}),
+              std::vector<uint8_t>({0x90, 0x00}));
+    EXPECT_ANY_THROW(profiles["invalid"]->processApdu({0x00, 0xB2}));
+    EXPECT_ANY_THROW(card->processApdu({0x00, 0xB2}));
+
+    tearDown();
+}
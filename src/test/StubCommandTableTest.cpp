@@ -0,0 +1,120 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "AllocationCounter.h"
+#include "StubCommandTable.h"
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+
+using namespace testing;
+
+using namespace keyple::core::util;
+using namespace keyple::plugin::stub;
+
+static bool processApdu(const StubCommandTable& table,
+                        const std::string& apdu,
+                        std::string& response,
+                        std::size_t& entry)
+{
+    StubApdu apduOut;
+    if (!table.processApdu(StubApdu(HexUtil::toByteArray(apdu)), apduOut, entry)) {
+        return false;
+    }
+
+    response = apduOut.toHex();
+
+    return true;
+}
+
+TEST(StubCommandTableTest, processApdu_shouldFindPlainCommands)
+{
+    std::map<std::string, std::string> hexCommands;
+    for (int i = 0; i < 100; i++) {
+        const std::string index = HexUtil::toHex(static_cast<uint8_t>(i));
+        hexCommands.insert({"00B2" + index + "0400", index + "9000"});
+    }
+    const StubCommandTable table(hexCommands);
+
+    ASSERT_EQ(table.size(), 100);
+    for (int i = 0; i < 100; i++) {
+        const std::string index = HexUtil::toHex(static_cast<uint8_t>(i));
+        std::string response;
+        std::size_t entry;
+        ASSERT_TRUE(processApdu(table, "00B2" + index + "0400", response, entry));
+        ASSERT_EQ(response, index + "9000");
+        ASSERT_EQ(entry, static_cast<std::size_t>(i));
+    }
+
+    std::string response;
+    std::size_t entry;
+    ASSERT_FALSE(processApdu(table, "00B2000500", response, entry));
+    ASSERT_FALSE(processApdu(table, "00B20004", response, entry));
+}
+
+TEST(StubCommandTableTest, processApdu_shouldTryTheCommandsInAscendingOrder)
+{
+    const StubCommandTable table({{"00A4.*", "6A82"},
+                                  {"00A4040005", "9000"},
+                                  {"00B2010400", "9000"},
+                                  {"[0-9A-F]*", "6D00"}});
+
+    std::string response;
+    std::size_t entry;
+
+    /* The regular expression sorts before the plain command */
+    ASSERT_TRUE(processApdu(table, "00A4040005", response, entry));
+    ASSERT_EQ(response, "6A82");
+    ASSERT_EQ(entry, 0);
+
+    /* The plain command sorts before the regular expression */
+    ASSERT_TRUE(processApdu(table, "00B2010400", response, entry));
+    ASSERT_EQ(response, "9000");
+    ASSERT_EQ(entry, 2);
+
+    ASSERT_TRUE(processApdu(table, "00B2020400", response, entry));
+    ASSERT_EQ(response, "6D00");
+    ASSERT_EQ(entry, 3);
+}
+
+TEST(StubCommandTableTest, getCommand_shouldKeepTheProvidedStrings)
+{
+    const StubCommandTable table({{"00a4.*", "6f00"}, {"00B2010400", "response"}});
+
+    ASSERT_EQ(table.getCommand(0), "00B2010400");
+    ASSERT_EQ(table.getResponse(0), "response");
+    ASSERT_EQ(table.getCommand(1), "00a4.*");
+    ASSERT_EQ(table.getResponse(1), "6f00");
+}
+
+TEST(StubCommandTableTest, table_shouldTakeLessMemoryThanTheMap)
+{
+    std::map<std::string, std::string> hexCommands;
+    for (int i = 0; i < 100; i++) {
+        hexCommands.insert({"00B2" + HexUtil::toHex(static_cast<uint8_t>(i)) + "0400", "9000"});
+    }
+
+    const int64_t liveBytes = AllocationCounter::getLiveBytes();
+    std::unique_ptr<const std::map<std::string, std::string>> map(
+        new std::map<std::string, std::string>(hexCommands));
+    const int64_t mapBytes = AllocationCounter::getLiveBytes() - liveBytes;
+    map.reset();
+
+    std::unique_ptr<const StubCommandTable> table(new StubCommandTable(hexCommands));
+    const int64_t tableBytes = AllocationCounter::getLiveBytes() - liveBytes;
+
+    ASSERT_LT(tableBytes, mapBytes);
+}
@@ -0,0 +1,181 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubFleetLoader.h"
+#include "StubPluginAdapter.h"
+#include "StubPoolPluginAdapter.h"
+#include "StubPoolPluginFactoryAdapter.h"
+#include "StubPluginFactoryAdapter.h"
+#include "StubReaderAdapter.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+using namespace testing;
+
+using namespace keyple::core::util::cpp::exception;
+using namespace keyple::plugin::stub;
+
+static const std::string FLEET =
+    "# Stub fleet\n"
+    "monitoring 50\n"
+    "\n"
+    "reader contactReader contact card1\n"
+    "reader contactlessReader contactless card2   # same profile as card1\n"
+    "reader emptyReader contactless\n"
+    "card card1 3B8880 ISO_14443_4\n"
+    "command card1 00A4 9000\n"
+    "card card2 3B8880 ISO_14443_4\n"
+    "command card2 00A4 9000\n";
+
+static const std::string POOL_FLEET =
+    "shards 4\r\n"
+    "card calypso 3B8880 ISO_14443_4\r\n"
+    "command calypso 00A4 6A82\r\n"
+    "poolreader group1 reader1 calypso\r\n"
+    "poolreader group1 reader2\r\n"
+    "elasticgroup group2 2 4 100 calypso\r\n";
+
+static std::shared_ptr<StubPluginAdapter> getPlugin(
+    const std::shared_ptr<StubPluginFactory>& factory)
+{
+    return std::dynamic_pointer_cast<StubPluginAdapter>(
+               std::dynamic_pointer_cast<StubPluginFactoryAdapter>(factory)->getPlugin());
+}
+
+static std::shared_ptr<StubPoolPluginAdapter> getPoolPlugin(
+    const std::shared_ptr<StubPoolPluginFactory>& factory)
+{
+    return std::dynamic_pointer_cast<StubPoolPluginAdapter>(
+               std::dynamic_pointer_cast<StubPoolPluginFactoryAdapter>(factory)->getPoolPlugin());
+}
+
+static std::string getErrorMessage(const std::string& fleet, const std::size_t parserCount)
+{
+    try {
+        StubFleetLoader::parsePluginFactory(fleet, parserCount);
+    } catch (const IllegalArgumentException& e) {
+        return e.what();
+    }
+
+    return "";
+}
+
+TEST(StubFleetLoaderTest, parsePluginFactory_should_build_readers_and_cards)
+{
+    const auto plugin = getPlugin(StubFleetLoader::parsePluginFactory(FLEET));
+
+    ASSERT_EQ(plugin->getMonitoringCycleDuration(), 50);
+    ASSERT_EQ(plugin->searchAvailableReaders().size(), 3);
+
+    const auto contactReader = std::dynamic_pointer_cast<StubReaderAdapter>(
+                                   plugin->searchReader("contactReader"));
+    const auto contactlessReader = std::dynamic_pointer_cast<StubReaderAdapter>(
+                                       plugin->searchReader("contactlessReader"));
+    const auto emptyReader = std::dynamic_pointer_cast<StubReaderAdapter>(
+                                 plugin->searchReader("emptyReader"));
+
+    ASSERT_FALSE(contactReader->isContactless());
+    ASSERT_TRUE(contactlessReader->isContactless());
+    ASSERT_EQ(emptyReader->getSmartcard(), nullptr);
+
+    /* Each reader has its own card, even when the profiles are identical */
+    const auto card = contactReader->getSmartcard();
+    ASSERT_NE(card, nullptr);
+    ASSERT_NE(card, contactlessReader->getSmartcard());
+    ASSERT_EQ(card->getPowerOnData(), std::vector<uint8_t>({0x3B, 0x88, 0x80}));
+    ASSERT_EQ(card->getCardProtocol(), "ISO_14443_4");
+    ASSERT_EQ(contactlessReader->getSmartcard()->processApdu({0x00, 0xA4}),
+              std::vector<uint8_t>({0x90, 0x00}));
+}
+
+TEST(StubFleetLoaderTest, parsePoolPluginFactory_should_build_groups)
+{
+    const auto plugin = getPoolPlugin(StubFleetLoader::parsePoolPluginFactory(POOL_FLEET));
+
+    /* Two configured readers and the minimum size of the elastic group */
+    ASSERT_EQ(plugin->searchAvailableReaders().size(), 4);
+
+    const auto reader = std::dynamic_pointer_cast<StubReaderAdapter>(
+                            plugin->allocateReader("group2"));
+
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(reader->getSmartcard()->processApdu({0x00, 0xA4}),
+              std::vector<uint8_t>({0x6A, 0x82}));
+}
+
+TEST(StubFleetLoaderTest, parse_with_several_parsers_should_give_same_fleet)
+{
+    std::ostringstream fleet;
+    fleet << "card profile 3B00 protocol\n";
+    for (int i = 0; i < 10000; i++) {
+        fleet << "reader reader" << i << " contactless profile\n";
+    }
+
+    const auto plugin = getPlugin(StubFleetLoader::parsePluginFactory(fleet.str(), 8));
+
+    ASSERT_EQ(plugin->searchAvailableReaderNames().size(), 10000);
+    ASSERT_NE(plugin->searchReader("reader0"), nullptr);
+    ASSERT_NE(plugin->searchReader("reader9999"), nullptr);
+}
+
+TEST(StubFleetLoaderTest, parse_invalid_line_should_report_its_number)
+{
+    const std::string fleet = "card profile 3B00 protocol\n"
+                              "reader reader1 contact\n"
+                              "\n"
+                              "reader reader2 contact\n"
+                              "reder reader3 contact\n";
+
+    for (std::size_t parserCount = 1; parserCount <= 4; parserCount++) {
+        ASSERT_THAT(getErrorMessage(fleet, parserCount), HasSubstr("line 5: unknown keyword"));
+    }
+}
+
+TEST(StubFleetLoaderTest, parse_invalid_declarations_should_throw_IAE)
+{
+    ASSERT_THAT(getErrorMessage("reader reader1\n", 1), HasSubstr("wrong number of fields"));
+    ASSERT_THAT(getErrorMessage("reader reader1 usb\n", 1), HasSubstr("unknown reader type"));
+    ASSERT_THAT(getErrorMessage("reader reader1 contact card\n", 1),
+                HasSubstr("unknown card profile"));
+    ASSERT_THAT(getErrorMessage("card card 3B0 protocol\n", 1), HasSubstr("power-on data"));
+    ASSERT_THAT(getErrorMessage("monitoring -1\n", 1), HasSubstr("invalid number"));
+    ASSERT_THAT(getErrorMessage("poolreader group reader\n", 1), HasSubstr("not allowed"));
+
+    EXPECT_THROW(StubFleetLoader::parsePoolPluginFactory("reader reader1 contact\n"),
+                 IllegalArgumentException);
+    EXPECT_THROW(StubFleetLoader::parsePluginFactory("", 0), IllegalArgumentException);
+}
+
+TEST(StubFleetLoaderTest, loadPluginFactory_should_read_the_file)
+{
+    const std::string path = "StubFleetLoaderTest.fleet";
+    {
+        std::ofstream file(path);
+        file << FLEET;
+    }
+
+    const auto plugin = getPlugin(StubFleetLoader::loadPluginFactory(path, 2));
+
+    std::remove(path.c_str());
+
+    ASSERT_EQ(plugin->searchAvailableReaders().size(), 3);
+    EXPECT_THROW(StubFleetLoader::loadPluginFactory(path), IllegalArgumentException);
+}
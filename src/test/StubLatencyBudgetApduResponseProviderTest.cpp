@@ -0,0 +1,134 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <chrono>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubLatencyBudgetApduResponseProvider.h"
+#include "StubSmartCard.h"
+
+/* Keyple Core Util */
+#include "HexUtil.h"
+#include "IllegalArgumentException.h"
+
+using namespace testing;
+
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
+using namespace keyple::plugin::stub;
+using namespace keyple::plugin::stub::spi;
+
+/* Answers the request followed by 9000, after sleeping for the configured time */
+class SleepingApduResponseProvider : public ApduResponseProviderSpi {
+public:
+    int mSleepTime;
+
+    explicit SleepingApduResponseProvider(const int sleepTime) : mSleepTime(sleepTime) {}
+
+    const std::string getResponseFromRequest(const std::string& apduRequest) override
+    {
+        if (mSleepTime > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(mSleepTime));
+        }
+
+        return apduRequest + "9000";
+    }
+};
+
+TEST(StubLatencyBudgetApduResponseProviderTest, constructor_withInvalidArguments_shouldThrow_IAE)
+{
+    const auto provider = std::make_shared<SleepingApduResponseProvider>(0);
+
+    EXPECT_THROW(StubLatencyBudgetApduResponseProvider(nullptr, 1), IllegalArgumentException);
+    EXPECT_THROW(StubLatencyBudgetApduResponseProvider(provider, 0), IllegalArgumentException);
+    EXPECT_THROW(StubLatencyBudgetApduResponseProvider(provider, 1, "6F0"),
+                 IllegalArgumentException);
+    EXPECT_THROW(StubLatencyBudgetApduResponseProvider(provider, 1, "6FXX"),
+                 IllegalArgumentException);
+    EXPECT_THROW(StubLatencyBudgetApduResponseProvider(provider, 1, "", 0),
+                 IllegalArgumentException);
+    EXPECT_THROW(StubLatencyBudgetApduResponseProvider(provider, 1, "", 1, -1),
+                 IllegalArgumentException);
+}
+
+TEST(StubLatencyBudgetApduResponseProviderTest, getResponseFromRequest_withinBudget_shouldNotCount)
+{
+    const auto provider = std::make_shared<SleepingApduResponseProvider>(0);
+    StubLatencyBudgetApduResponseProvider watchdog(provider, 1000000, "6F00");
+
+    ASSERT_EQ(watchdog.getResponseFromRequest("00B2010400"), "00B20104009000");
+    ASSERT_EQ(watchdog.getResponseFromRequest("00B2020400"), "00B20204009000");
+
+    ASSERT_EQ(watchdog.getCallCount(), 2);
+    ASSERT_EQ(watchdog.getOverBudgetCount(), 0);
+    ASSERT_EQ(watchdog.getReportCount(), 0);
+}
+
+TEST(StubLatencyBudgetApduResponseProviderTest, getResponseFromRequest_overBudget_shouldCount)
+{
+    const auto provider = std::make_shared<SleepingApduResponseProvider>(2);
+    StubLatencyBudgetApduResponseProvider watchdog(provider, 1000);
+
+    ASSERT_EQ(watchdog.getResponseFromRequest("00B2010400"), "00B20104009000");
+
+    ASSERT_EQ(watchdog.getOverBudgetCount(), 1);
+    ASSERT_EQ(watchdog.getReportCount(), 1);
+    ASSERT_GE(watchdog.getMaxLatency(), 2000000u);
+}
+
+TEST(StubLatencyBudgetApduResponseProviderTest, card_overBudget_shouldFailFast)
+{
+    const auto provider = std::make_shared<SleepingApduResponseProvider>(2);
+    const auto watchdog =
+        std::make_shared<StubLatencyBudgetApduResponseProvider>(provider, 1000, "6F00");
+
+    const std::shared_ptr<StubSmartCard> card =
+        StubSmartCard::builder()->withPowerOnData(std::vector<uint8_t>(1))
+                                 .withProtocol("protocol")
+                                 .withApduResponseProvider(watchdog)
+                                 .build();
+
+    ASSERT_EQ(card->processApdu(HexUtil::toByteArray("00B2010400")),
+              HexUtil::toByteArray("6F00"));
+
+    provider->mSleepTime = 0;
+    ASSERT_EQ(card->processApdu(HexUtil::toByteArray("00B2010400")),
+              HexUtil::toByteArray("00B20104009000"));
+
+    ASSERT_EQ(watchdog->getCallCount(), 2);
+    ASSERT_EQ(watchdog->getOverBudgetCount(), 1);
+}
+
+TEST(StubLatencyBudgetApduResponseProviderTest, getResponseFromRequest_overBudget_shouldThrottle)
+{
+    const auto provider = std::make_shared<SleepingApduResponseProvider>(1);
+
+    /* One report per minute at most */
+    StubLatencyBudgetApduResponseProvider limited(provider, 1, "", 1, 60000);
+    for (int i = 0; i < 5; i++) {
+        limited.getResponseFromRequest("00B2010400");
+    }
+    ASSERT_EQ(limited.getOverBudgetCount(), 5);
+    ASSERT_EQ(limited.getReportCount(), 1);
+
+    /* One out of two calls reported, the 1st, 3rd and 5th */
+    StubLatencyBudgetApduResponseProvider sampled(provider, 1, "", 2, 0);
+    for (int i = 0; i < 5; i++) {
+        sampled.getResponseFromRequest("00B2010400");
+    }
+    ASSERT_EQ(sampled.getOverBudgetCount(), 5);
+    ASSERT_EQ(sampled.getReportCount(), 3);
+}
@@ -0,0 +1,143 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubMetrics.h"
+#include "StubReaderAdapter.h"
+#include "StubSmartCard.h"
+
+/* Keyple Core Plugin */
+#include "CardIOException.h"
+
+using namespace testing;
+
+using namespace keyple::core::plugin;
+using namespace keyple::plugin::stub;
+
+static const std::string commandHex = "1122";
+static const std::string responseHex = "3344";
+
+static std::shared_ptr<StubSmartCard> buildACard()
+{
+    return StubSmartCard::builder()->withPowerOnData(std::vector<uint8_t>(1))
+                                    .withProtocol("protocol")
+                                    .withSimulatedCommand(commandHex, responseHex)
+                                    .withSimulatedCommand("55.*", "9000")
+                                    .build();
+}
+
+TEST(StubMetricsTest, histogram_should_bound_the_relative_error)
+{
+    StubMetrics::Histogram histogram;
+    for (uint64_t value = 1; value <= 1000; value++) {
+        histogram.record(value * 1000);
+    }
+
+    ASSERT_EQ(histogram.getCount(), 1000);
+    ASSERT_EQ(histogram.getMean(), 500500);
+    ASSERT_EQ(histogram.getMax(), 1000000);
+
+    const uint64_t median = histogram.getValueAtPercentile(50);
+    ASSERT_GE(median, 500000);
+    ASSERT_LE(median, 500000 * 1.125);
+    ASSERT_EQ(histogram.getValueAtPercentile(100), 1000000);
+}
+
+TEST(StubMetricsTest, histogram_merge_should_add_the_values)
+{
+    StubMetrics::Histogram histogram;
+    histogram.record(10);
+
+    StubMetrics::Histogram other;
+    other.record(1000);
+    histogram.merge(other);
+
+    ASSERT_EQ(histogram.getCount(), 2);
+    ASSERT_EQ(histogram.getMax(), 1000);
+    ASSERT_EQ(histogram.getValueAtPercentile(50), 10);
+}
+
+TEST(StubMetricsTest, recorder_should_sum_the_shards)
+{
+    StubMetrics::Recorder recorder(2);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < StubMetrics::SHARD_COUNT + 2; i++) {
+        threads.push_back(std::thread([&recorder]() {
+            for (std::size_t j = 0; j < 100; j++) {
+                recorder.record(j, j % 10 == 0);
+                recorder.recordHit(j % 2);
+                recorder.recordProviderCall();
+            }
+        }));
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    StubMetrics::CardMetrics metrics;
+    recorder.getMetrics({"even", "odd"}, metrics);
+
+    const uint64_t total = (StubMetrics::SHARD_COUNT + 2) * 100;
+    ASSERT_EQ(metrics.mApduCount, total);
+    ASSERT_EQ(metrics.mMissCount, total / 10);
+    ASSERT_EQ(metrics.mProviderCallCount, total);
+    ASSERT_EQ(metrics.mHitCounts["even"], total / 2);
+    ASSERT_EQ(metrics.mHitCounts["odd"], total / 2);
+    ASSERT_EQ(metrics.mLatency.getMax(), 99);
+
+    recorder.reset();
+    recorder.getMetrics({"even", "odd"}, metrics);
+
+    ASSERT_EQ(metrics.mApduCount, 0);
+    ASSERT_EQ(metrics.mHitCounts["even"], 0);
+}
+
+TEST(StubMetricsTest, card_and_reader_should_record_exchanges_when_enabled)
+{
+    const std::shared_ptr<StubSmartCard> card = buildACard();
+    StubReaderAdapter reader("reader", false, card);
+
+    reader.transmitApdu({0x11, 0x22});
+    reader.transmitApdu({0x55, 0x01});
+    reader.transmitApdu({0x55, 0x02});
+    EXPECT_THROW(reader.transmitApdu({0x66}), CardIOException);
+
+    const StubMetrics::CardMetrics cardMetrics = card->getMetrics();
+    const StubMetrics::ReaderMetrics readerMetrics = reader.getMetrics();
+
+    if (!StubMetrics::isEnabled()) {
+        ASSERT_EQ(cardMetrics.mApduCount, 0);
+        ASSERT_EQ(readerMetrics.mApduCount, 0);
+        return;
+    }
+
+    ASSERT_EQ(cardMetrics.mApduCount, 4);
+    ASSERT_EQ(cardMetrics.mMissCount, 1);
+    ASSERT_EQ(cardMetrics.mProviderCallCount, 0);
+    ASSERT_EQ(cardMetrics.mHitCounts.at(commandHex), 1);
+    ASSERT_EQ(cardMetrics.mHitCounts.at("55.*"), 2);
+    ASSERT_EQ(readerMetrics.mApduCount, 4);
+    ASSERT_EQ(readerMetrics.mErrorCount, 1);
+
+    card->resetMetrics();
+    reader.resetMetrics();
+
+    ASSERT_EQ(card->getMetrics().mApduCount, 0);
+    ASSERT_EQ(reader.getMetrics().mApduCount, 0);
+}
@@ -10,16 +10,27 @@
  * SPDX-License-Identifier: EPL-2.0                                                               *
  **************************************************************************************************/
 
+#include <thread>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "AllocationCounter.h"
+
 /* Keyple Plugin Stub */
 #include "StubPluginAdapter.h"
 #include "StubPluginFactoryAdapter.h"
 #include "StubSmartCard.h"
 
+/* Keyple Core Util */
+#include "HexUtil.h"
+#include "IllegalArgumentException.h"
+#include "IllegalStateException.h"
+
 using namespace testing;
 
+using namespace keyple::core::util;
+using namespace keyple::core::util::cpp::exception;
 using namespace keyple::plugin::stub;
 
 using StubReaderConfiguration = StubPluginFactoryAdapter::StubReaderConfiguration;
@@ -51,6 +62,7 @@ static void tearDown()
 {
     card.reset();
     pluginAdapter.reset();
+    readerConfigurations.clear();
 }
 
 TEST(StubPluginAdapterTest, initPlugin_withOneReader)
@@ -94,3 +106,352 @@ TEST(StubPluginAdapterTest, unplugReader_should_remove_reader)
 
     tearDown();
 }
+
+TEST(StubPluginAdapterTest, getReadersSnapshot_should_follow_plugged_readers)
+{
+    setUp();
+
+    pluginAdapter->plugReader(NAME, true, card);
+
+    const auto snapshot = pluginAdapter->getReadersSnapshot();
+
+    ASSERT_EQ(pluginAdapter->getReadersSnapshot(), snapshot);
+    ASSERT_EQ(snapshot->getReaderNames(), pluginAdapter->searchAvailableReaderNames());
+
+    pluginAdapter->unplugReader(NAME);
+
+    ASSERT_NE(pluginAdapter->getReadersSnapshot(), snapshot);
+    ASSERT_TRUE(pluginAdapter->getReadersSnapshot()->getReaders().empty());
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, plugReaders_should_create_readers)
+{
+    setUp();
+
+    const std::size_t readerCount = pluginAdapter->searchAvailableReaders().size();
+
+    pluginAdapter->plugReaders({"reader1", "reader2"}, true, {card, nullptr});
+
+    ASSERT_EQ(pluginAdapter->searchAvailableReaders().size(), readerCount + 2);
+    ASSERT_TRUE(pluginAdapter->searchReader("reader1")->checkCardPresence());
+    ASSERT_FALSE(pluginAdapter->searchReader("reader2")->checkCardPresence());
+
+    pluginAdapter->unplugReaders({"reader1", "unknown"});
+
+    ASSERT_EQ(pluginAdapter->searchAvailableReaders().size(), readerCount + 1);
+    ASSERT_EQ(pluginAdapter->searchReader("reader1"), nullptr);
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, plugReaders_should_plug_many_readers)
+{
+    setUp();
+
+    const std::size_t readerCount = pluginAdapter->searchAvailableReaders().size();
+
+    std::vector<std::string> names;
+    for (int i = 0; i < 100000; i++) {
+        names.push_back(NAME + std::to_string(i));
+    }
+
+    pluginAdapter->plugReaders(names, false, {});
+
+    ASSERT_EQ(pluginAdapter->getReadersSnapshot()->getReaders().size(), readerCount + 100000);
+    ASSERT_EQ(pluginAdapter->searchReader(NAME + "99999")->getName(), NAME + "99999");
+
+    pluginAdapter->unplugReaders(names);
+
+    ASSERT_EQ(pluginAdapter->getReadersSnapshot()->getReaders().size(), readerCount);
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, lazy_plugin_should_create_reader_on_first_use)
+{
+    setUp();
+
+    const std::vector<std::shared_ptr<StubReaderConfiguration>> configurations = {
+        std::make_shared<StubReaderConfiguration>("reader1", false, card),
+        std::make_shared<StubReaderConfiguration>("reader2", true, card)};
+    pluginAdapter = std::make_shared<StubPluginAdapter>(NAME, configurations, 0, true);
+
+    /* Held by the test and the configurations only */
+    ASSERT_EQ(card.use_count(), 3);
+    ASSERT_EQ(pluginAdapter->searchAvailableReaderNames(),
+              std::vector<std::string>({"reader1", "reader2"}));
+    ASSERT_EQ(card.use_count(), 3);
+
+    /* The same proxy is returned by the lookups and the listings */
+    const std::shared_ptr<ReaderSpi> reader = pluginAdapter->searchReader("reader2");
+    const std::vector<std::shared_ptr<ReaderSpi>> readers = pluginAdapter->searchAvailableReaders();
+
+    ASSERT_EQ(pluginAdapter->searchReader("reader2"), reader);
+    ASSERT_EQ(readers.size(), 2);
+    ASSERT_EQ(readers[1], reader);
+    ASSERT_EQ(pluginAdapter->searchAvailableReaders(), readers);
+    ASSERT_TRUE(reader->isContactless());
+    ASSERT_EQ(pluginAdapter->searchReader("unknown"), nullptr);
+    ASSERT_EQ(card.use_count(), 3);
+
+    ASSERT_TRUE(reader->checkCardPresence());
+
+    /* Once created, the reader itself is returned */
+    ASSERT_EQ(card.use_count(), 4);
+    ASSERT_NE(std::dynamic_pointer_cast<StubReaderAdapter>(pluginAdapter->searchReader("reader2")),
+              nullptr);
+    ASSERT_EQ(std::dynamic_pointer_cast<StubReaderAdapter>(pluginAdapter->searchReader("reader1")),
+              nullptr);
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, lazy_plugin_registration_should_not_create_readers)
+{
+    setUp();
+
+    const std::vector<std::shared_ptr<StubReaderConfiguration>> configurations = {
+        std::make_shared<StubReaderConfiguration>("reader1", false, card),
+        std::make_shared<StubReaderConfiguration>("reader2", true, card)};
+    pluginAdapter = std::make_shared<StubPluginAdapter>(NAME, configurations, 0, true);
+
+    /* What the core does when registering the plugin */
+    const std::vector<std::shared_ptr<ReaderSpi>> readers = pluginAdapter->searchAvailableReaders();
+    ASSERT_EQ(readers.size(), 2);
+    for (const auto& reader : readers) {
+        ASSERT_NE(std::dynamic_pointer_cast<ObservableReaderSpi>(reader), nullptr);
+        ASSERT_NE(std::dynamic_pointer_cast<ConfigurableReaderSpi>(reader), nullptr);
+        ASSERT_NE(std::dynamic_pointer_cast<StubReader>(reader), nullptr);
+    }
+
+    ASSERT_EQ(readers[0]->getName(), "reader1");
+    ASSERT_FALSE(readers[0]->isContactless());
+    ASSERT_TRUE(readers[1]->isContactless());
+    ASSERT_EQ(card.use_count(), 3);
+
+    /* First use through the core */
+    std::dynamic_pointer_cast<ConfigurableReaderSpi>(readers[0])->activateProtocol(protocol);
+
+    ASSERT_EQ(card.use_count(), 4);
+    ASSERT_TRUE(readers[0]->checkCardPresence());
+    ASSERT_EQ(std::dynamic_pointer_cast<StubReader>(readers[0])->getSmartcard(), card);
+    ASSERT_EQ(std::dynamic_pointer_cast<StubReader>(pluginAdapter->searchReader("reader1"))
+                  ->getSmartcard(),
+              card);
+
+    /* Unplugged before its first use */
+    pluginAdapter->unplugReader("reader2");
+
+    EXPECT_THROW(readers[1]->checkCardPresence(), IllegalStateException);
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, lazy_plugin_unplugReader_should_drop_pending_reader)
+{
+    setUp();
+
+    const std::vector<std::shared_ptr<StubReaderConfiguration>> configurations = {
+        std::make_shared<StubReaderConfiguration>("reader1", false, card)};
+    pluginAdapter = std::make_shared<StubPluginAdapter>(NAME, configurations, 0, true);
+
+    pluginAdapter->unplugReader("reader1");
+
+    ASSERT_EQ(pluginAdapter->searchReader("reader1"), nullptr);
+    ASSERT_TRUE(pluginAdapter->searchAvailableReaderNames().empty());
+
+    /* A configured reader keeps precedence over a plugged one */
+    pluginAdapter = std::make_shared<StubPluginAdapter>(NAME, configurations, 0, true);
+    pluginAdapter->plugReader("reader1", true, nullptr);
+
+    ASSERT_FALSE(pluginAdapter->searchReader("reader1")->isContactless());
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, lazy_plugin_proxy_used_after_plugin_release_throw_ex)
+{
+    setUp();
+
+    const std::vector<std::shared_ptr<StubReaderConfiguration>> configurations = {
+        std::make_shared<StubReaderConfiguration>("reader1", false, card)};
+    pluginAdapter = std::make_shared<StubPluginAdapter>(NAME, configurations, 0, true);
+
+    const std::shared_ptr<ReaderSpi> reader = pluginAdapter->searchReader("reader1");
+    pluginAdapter.reset();
+
+    ASSERT_EQ(reader->getName(), "reader1");
+    EXPECT_THROW(reader->checkCardPresence(), IllegalStateException);
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, lazy_plugin_concurrent_searches_should_create_each_reader_once)
+{
+    setUp();
+
+    std::vector<std::shared_ptr<StubReaderConfiguration>> configurations;
+    for (int i = 0; i < 100; i++) {
+        configurations.push_back(
+            std::make_shared<StubReaderConfiguration>(NAME + std::to_string(i), false, nullptr));
+    }
+
+    pluginAdapter = std::make_shared<StubPluginAdapter>(NAME, configurations, 0, true);
+
+    std::vector<std::shared_ptr<ReaderSpi>> readers[4];
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&readers, t] {
+            for (int i = 0; i < 100; i++) {
+                readers[t].push_back(pluginAdapter->searchReader(NAME + std::to_string(i)));
+            }
+        }));
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /* The same proxies, no reader created yet */
+    for (int t = 1; t < 4; t++) {
+        ASSERT_EQ(readers[t], readers[0]);
+    }
+
+    threads.clear();
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&readers, t] {
+            for (const auto& reader : readers[t]) {
+                reader->checkCardPresence();
+            }
+        }));
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(pluginAdapter->getReadersSnapshot()->getReaders().size(), 100);
+    for (int i = 0; i < 100; i++) {
+        ASSERT_NE(std::dynamic_pointer_cast<StubReaderAdapter>(
+                      pluginAdapter->searchReader(NAME + std::to_string(i))),
+                  nullptr);
+    }
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, restoreSnapshot_should_restore_readers_and_cards)
+{
+    setUp();
+
+    const std::shared_ptr<StubSmartCard> copy = card->copy();
+    pluginAdapter->plugReaders({"reader1", "reader2"}, true, {card, copy});
+    pluginAdapter->plugReader("reader3", false, nullptr);
+
+    const auto reader1 = std::dynamic_pointer_cast<StubReaderAdapter>(
+                             pluginAdapter->searchReader("reader1"));
+    reader1->activateProtocol(protocol);
+    reader1->openPhysicalChannel();
+
+    const std::vector<uint8_t> snapshot = pluginAdapter->createSnapshot();
+
+    /* Changes made after the snapshot are discarded by the restore */
+    pluginAdapter->unplugReader("reader1");
+    pluginAdapter->plugReader("reader4", false, nullptr);
+
+    pluginAdapter->restoreSnapshot(snapshot);
+
+    ASSERT_EQ(pluginAdapter->searchAvailableReaderNames(),
+              std::vector<std::string>({"reader1", "reader2", "reader3"}));
+
+    const auto restored1 = std::dynamic_pointer_cast<StubReaderAdapter>(
+                               pluginAdapter->searchReader("reader1"));
+    const auto restored2 = std::dynamic_pointer_cast<StubReaderAdapter>(
+                               pluginAdapter->searchReader("reader2"));
+    ASSERT_NE(restored1, reader1);
+    ASSERT_TRUE(restored1->isContactless());
+    ASSERT_TRUE(restored1->isPhysicalChannelOpen());
+    ASSERT_FALSE(restored2->isPhysicalChannelOpen());
+    ASSERT_FALSE(pluginAdapter->searchReader("reader3")->checkCardPresence());
+    ASSERT_EQ(restored1->getSmartcard()->processApdu(HexUtil::toByteArray(commandHex)),
+              card->processApdu(HexUtil::toByteArray(commandHex)));
+
+    /* The activated protocol is restored: another card of this protocol is accepted */
+    restored1->removeCard();
+    restored1->insertCard(buildACard());
+    ASSERT_TRUE(restored1->checkCardPresence());
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, restoreSnapshot_with_invalid_snapshot_throw_IAE_and_keep_readers)
+{
+    setUp();
+
+    pluginAdapter->plugReader("reader1", false, card);
+
+    std::vector<uint8_t> snapshot = pluginAdapter->createSnapshot();
+    snapshot.pop_back();
+
+    EXPECT_THROW(pluginAdapter->restoreSnapshot(snapshot), IllegalArgumentException);
+    EXPECT_THROW(pluginAdapter->restoreSnapshot({1, 2, 3}), IllegalArgumentException);
+
+    ASSERT_EQ(pluginAdapter->searchAvailableReaderNames(), std::vector<std::string>({"reader1"}));
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, getPrometheusMetrics_should_render_plugin_metrics)
+{
+    setUp();
+
+    pluginAdapter->plugReaders({"reader1", "reader2"}, false, {card, nullptr});
+    pluginAdapter->unplugReader("reader2");
+    pluginAdapter->unplugReader("unknown");
+    pluginAdapter->searchReader("reader1")->transmitApdu(HexUtil::toByteArray(commandHex));
+
+    const std::string metrics = pluginAdapter->getPrometheusMetrics();
+
+    ASSERT_NE(metrics.find("# TYPE keyple_stub_plugin_readers gauge\n" \
+                           "keyple_stub_plugin_readers{plugin=\"name\"} 1\n"),
+              std::string::npos);
+    ASSERT_NE(metrics.find("keyple_stub_plugin_reader_plugs_total{plugin=\"name\"} 2\n"),
+              std::string::npos);
+    ASSERT_NE(metrics.find("keyple_stub_plugin_reader_unplugs_total{plugin=\"name\"} 1\n"),
+              std::string::npos);
+    ASSERT_EQ(metrics.find("keyple_stub_reader_apdus_total{plugin=\"name\"," \
+                           "reader=\"reader1\"} 1\n") != std::string::npos,
+              StubMetrics::isEnabled());
+
+    tearDown();
+}
+
+TEST(StubPluginAdapterTest, plugReaders_footprint_at_100k_readers)
+{
+    static const int READER_COUNT = 100000;
+
+    setUp();
+
+    std::vector<std::string> names;
+    for (int i = 0; i < READER_COUNT; i++) {
+        names.push_back("reader" + std::to_string(i));
+    }
+
+    const int64_t liveBytes = AllocationCounter::getLiveBytes();
+
+    pluginAdapter->plugReaders(names, false, {});
+
+    const int64_t bytesPerReader = (AllocationCounter::getLiveBytes() - liveBytes) / READER_COUNT;
+
+    RecordProperty("bytesPerReader", static_cast<int>(bytesPerReader));
+
+    /* Metrics, when compiled in, add their recorder and the card swap counters to each reader */
+    const int64_t metricsBytesPerReader =
+        StubMetrics::isEnabled() ? sizeof(StubMetrics::Recorder) + 2 * sizeof(uint64_t) : 0;
+
+    ASSERT_LT(bytesPerReader, 256 + metricsBytesPerReader);
+
+    tearDown();
+}
@@ -87,4 +87,73 @@ TEST(StubPluginFactoryAdapterTest, init_factory_with_reader_configuration)
     ASSERT_TRUE(reader->isContactless());
 
     tearDown();
-}
\ No newline at end of file
+}
+TEST(StubPluginFactoryAdapterTest, init_factory_with_lazy_reader_creation)
+{
+    setUp();
+
+    factory = std::dynamic_pointer_cast<StubPluginFactoryAdapter>(
+                  StubPluginFactoryBuilder::builder()->withStubReader(READER_NAME, true, card)
+                                                      .withLazyReaderCreation()
+                                                      .build());
+
+    auto stubPlugin = std::dynamic_pointer_cast<StubPluginAdapter>(factory->getPlugin());
+
+    ASSERT_EQ(stubPlugin->searchAvailableReaderNames(), std::vector<std::string>({READER_NAME}));
+
+    auto reader = stubPlugin->searchReader(READER_NAME);
+
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(std::dynamic_pointer_cast<StubReader>(reader)->getSmartcard(), card);
+    ASSERT_TRUE(reader->isContactless());
+
+    tearDown();
+}
+
+TEST(StubPluginFactoryAdapterTest, build_then_withStubReader_does_not_change_built_factory)
+{
+    setUp();
+
+    auto builder = StubPluginFactoryBuilder::builder();
+    builder->withStubReader(READER_NAME, true, card);
+
+    auto firstFactory = std::dynamic_pointer_cast<StubPluginFactoryAdapter>(builder->build());
+
+    builder->withStubReader(READER_NAME + "2", false, card);
+
+    auto secondFactory = std::dynamic_pointer_cast<StubPluginFactoryAdapter>(builder->build());
+
+    auto firstPlugin = std::dynamic_pointer_cast<StubPluginAdapter>(firstFactory->getPlugin());
+    auto secondPlugin = std::dynamic_pointer_cast<StubPluginAdapter>(secondFactory->getPlugin());
+
+    ASSERT_EQ(firstPlugin->searchAvailableReaderNames().size(), 1);
+    ASSERT_EQ(secondPlugin->searchAvailableReaderNames().size(), 2);
+
+    tearDown();
+}
+
+TEST(StubPluginFactoryAdapterTest, init_factory_with_shared_reader_configurations)
+{
+    setUp();
+
+    const StubPluginFactoryAdapter::ReaderConfigurations configurations =
+        std::make_shared<const std::vector<std::shared_ptr<StubReaderConfiguration>>>(
+            std::vector<std::shared_ptr<StubReaderConfiguration>>{
+                std::make_shared<StubReaderConfiguration>(READER_NAME, true, card)});
+
+    factory = std::make_shared<StubPluginFactoryAdapter>(StubPluginFactoryBuilder::PLUGIN_NAME,
+                                                         configurations,
+                                                         monitoringCycle,
+                                                         false,
+                                                         false);
+
+    /* Every plugin is built from the same set */
+    auto firstPlugin = std::dynamic_pointer_cast<StubPluginAdapter>(factory->getPlugin());
+    auto secondPlugin = std::dynamic_pointer_cast<StubPluginAdapter>(factory->getPlugin());
+
+    ASSERT_NE(firstPlugin->searchReader(READER_NAME), nullptr);
+    ASSERT_NE(secondPlugin->searchReader(READER_NAME), nullptr);
+    ASSERT_NE(firstPlugin->searchReader(READER_NAME), secondPlugin->searchReader(READER_NAME));
+
+    tearDown();
+}
@@ -10,6 +10,10 @@
  * SPDX-License-Identifier: EPL-2.0                                                               *
  **************************************************************************************************/
 
+#include <mutex>
+#include <set>
+#include <thread>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -17,7 +21,9 @@
 #include "StubPluginAdapter.h"
 #include "StubPluginFactoryAdapter.h"
 #include "StubPoolPluginAdapter.h"
+#include "StubReaderAdapter.h"
 #include "StubSmartCard.h"
+#include "TestUtil.h"
 
 /* Keyple Core Plugin */
 #include "PluginApiProperties.h"
@@ -28,12 +34,15 @@
 
 /* Keyple Core Util */
 #include "Arrays.h"
+#include "IllegalArgumentException.h"
+#include "Thread.h"
 
 using namespace testing;
 
 using namespace keyple::core::common;
 using namespace keyple::core::plugin;
 using namespace keyple::core::util::cpp;
+using namespace keyple::core::util::cpp::exception;
 using namespace keyple::plugin::stub;
 
 using StubPoolReaderConfiguration = StubPoolPluginFactoryAdapter::StubPoolReaderConfiguration;
@@ -186,3 +195,426 @@ TEST(StubPoolPluginAdapterTest, allocate_reader_when_no_reader_throw_ex)
 
     tearDown();
 }
+
+TEST(StubPoolPluginAdapterTest, allocateReaders_should_allocate_all_readers_of_group)
+{
+    setUp();
+
+    __initPlugin_withMultipleReader();
+
+    const std::vector<std::shared_ptr<ReaderSpi>> readers =
+        pluginPoolAdapter->allocateReaders(group1, 2);
+
+    ASSERT_EQ(readers.size(), 2);
+    ASSERT_EQ(readers[0]->getName(), READER_NAME);
+    ASSERT_EQ(readers[1]->getName(), READER_NAME_2);
+    EXPECT_THROW(pluginPoolAdapter->allocateReader(group1), PluginIOException);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, allocateReaders_when_not_enough_readers_allocate_none)
+{
+    setUp();
+
+    __initPlugin_withMultipleReader();
+
+    EXPECT_THROW(pluginPoolAdapter->allocateReaders(group1, 3), PluginIOException);
+    ASSERT_EQ(pluginPoolAdapter->allocateReaders(group1, 2).size(), 2);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, releaseReaders_should_make_readers_available)
+{
+    setUp();
+
+    __initPlugin_withMultipleReader();
+
+    const std::vector<std::shared_ptr<ReaderSpi>> readers =
+        pluginPoolAdapter->allocateReaders("", 2);
+    pluginPoolAdapter->releaseReaders(readers);
+
+    ASSERT_EQ(pluginPoolAdapter->allocateReaders(group1, 2).size(), 2);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, releaseReaders_with_null_reader_throw_ex_and_release_none)
+{
+    setUp();
+
+    __initPlugin_withMultipleReader();
+
+    const std::vector<std::shared_ptr<ReaderSpi>> readers =
+        pluginPoolAdapter->allocateReaders(group1, 2);
+
+    EXPECT_THROW(pluginPoolAdapter->releaseReaders({readers[0], nullptr}),
+                 IllegalArgumentException);
+    EXPECT_THROW(pluginPoolAdapter->allocateReader(group1), PluginIOException);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, allocateReader_with_expired_lease_should_reclaim_reader)
+{
+    setUp();
+
+    __initPlugin_withMultipleReader();
+
+    std::shared_ptr<ReaderSpi> reader = pluginPoolAdapter->allocateReader(group1, 50);
+    reader->openPhysicalChannel();
+    pluginPoolAdapter->allocateReader(group1);
+
+    ASSERT_TRUE(waitUntil([] { return pluginPoolAdapter->getReclaimedLeaseCount() == 1; }));
+    ASSERT_FALSE(reader->isPhysicalChannelOpen());
+    ASSERT_EQ(pluginPoolAdapter->allocateReader(group1)->getName(), reader->getName());
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, renewLease_should_keep_reader_allocated)
+{
+    setUp();
+
+    __initPlugin_withMultipleReader();
+
+    std::shared_ptr<ReaderSpi> reader = pluginPoolAdapter->allocateReader(group1, 200);
+    pluginPoolAdapter->renewLease(reader, 10000);
+
+    Thread::sleep(400);
+
+    ASSERT_EQ(pluginPoolAdapter->getReclaimedLeaseCount(), 0);
+    ASSERT_NE(pluginPoolAdapter->allocateReader(group1)->getName(), reader->getName());
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, renewLease_when_reader_not_allocated_throw_ex)
+{
+    setUp();
+
+    __initPlugin_withMultipleReader();
+
+    std::shared_ptr<ReaderSpi> reader = pluginPoolAdapter->allocateReader(group1);
+    pluginPoolAdapter->releaseReader(reader);
+
+    EXPECT_THROW(pluginPoolAdapter->renewLease(reader, 100), IllegalArgumentException);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, releaseReader_should_restore_configured_state)
+{
+    setUp();
+
+    pluginPoolAdapter->plugPoolReader(group1, READER_NAME, card);
+
+    std::shared_ptr<ReaderSpi> reader = pluginPoolAdapter->allocateReader(group1);
+    const auto stubReader = std::dynamic_pointer_cast<StubReaderAdapter>(reader);
+    stubReader->activateProtocol(protocol);
+    stubReader->openPhysicalChannel();
+    stubReader->removeCard();
+    stubReader->insertCard(buildACard());
+    stubReader->openPhysicalChannel();
+
+    pluginPoolAdapter->releaseReader(reader);
+
+    /* The configured card itself, not a copy */
+    ASSERT_EQ(pluginPoolAdapter->allocateReader(group1), reader);
+    ASSERT_EQ(stubReader->getSmartcard(), card);
+    ASSERT_FALSE(stubReader->isPhysicalChannelOpen());
+
+    /* No protocol is activated anymore, the card is rejected */
+    stubReader->removeCard();
+    stubReader->insertCard(card);
+    ASSERT_FALSE(stubReader->checkCardPresence());
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, readers_configured_with_the_same_card_should_get_their_own)
+{
+    setUp();
+
+    __initPlugin_withMultipleReader();
+
+    std::shared_ptr<ReaderSpi> reader = pluginPoolAdapter->allocateReader(group1);
+    std::shared_ptr<ReaderSpi> reader2 = pluginPoolAdapter->allocateReader(group1);
+    const std::shared_ptr<StubSmartCard> card2 =
+        std::dynamic_pointer_cast<StubReaderAdapter>(reader2)->getSmartcard();
+
+    ASSERT_NE(std::dynamic_pointer_cast<StubReaderAdapter>(reader)->getSmartcard(), card2);
+
+    reader->openPhysicalChannel();
+    reader2->openPhysicalChannel();
+    pluginPoolAdapter->releaseReader(reader2);
+
+    ASSERT_TRUE(reader->isPhysicalChannelOpen());
+    ASSERT_EQ(std::dynamic_pointer_cast<StubReaderAdapter>(reader2)->getSmartcard(), card2);
+    ASSERT_FALSE(reader2->isPhysicalChannelOpen());
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, restoreSnapshot_should_restore_groups_and_allocations)
+{
+    setUp();
+
+    const std::shared_ptr<StubSmartCard> copy = card->copy();
+    pluginPoolAdapter->plugPoolReaders(group1, {READER_NAME, READER_NAME_2}, {card, copy});
+    pluginPoolAdapter->plugPoolReader(group2, "readerName3", nullptr);
+
+    std::shared_ptr<ReaderSpi> reader = pluginPoolAdapter->allocateReader(group1);
+    const auto stubReader = std::dynamic_pointer_cast<StubReaderAdapter>(reader);
+    stubReader->removeCard();
+
+    const std::vector<uint8_t> snapshot = pluginPoolAdapter->createSnapshot();
+
+    pluginPoolAdapter->releaseReader(reader);
+    pluginPoolAdapter->unplugPoolReaders(group2);
+
+    pluginPoolAdapter->restoreSnapshot(snapshot);
+
+    ASSERT_EQ(pluginPoolAdapter->searchAvailableReaders().size(), 3);
+    ASSERT_EQ(pluginPoolAdapter->allocateReader(group2)->getName(), "readerName3");
+
+    /* Only the reader not allocated in the snapshot is left in group1 */
+    const std::shared_ptr<ReaderSpi> other = pluginPoolAdapter->allocateReader(group1);
+    ASSERT_NE(other->getName(), reader->getName());
+    EXPECT_THROW(pluginPoolAdapter->allocateReader(group1), PluginIOException);
+
+    /* The reader allocated in the snapshot gets its configured card back on release */
+    const std::shared_ptr<ReaderSpi> restored = pluginPoolAdapter->searchReader(reader->getName());
+    ASSERT_FALSE(restored->checkCardPresence());
+    pluginPoolAdapter->releaseReader(restored);
+    ASSERT_TRUE(restored->checkCardPresence());
+    ASSERT_EQ(pluginPoolAdapter->allocateReader(group1), restored);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, allocateReader_on_exhausted_elastic_group_should_plug_reader)
+{
+    setUp();
+
+    const std::vector<std::shared_ptr<StubElasticGroupConfiguration>> elasticGroups = {
+        std::make_shared<StubElasticGroupConfiguration>(group2, 1, 3, card, 10000)};
+    pluginPoolAdapter =
+        std::make_shared<StubPoolPluginAdapter>(READER_NAME, readerConfigurations, 0, elasticGroups);
+
+    ASSERT_EQ(pluginPoolAdapter->searchAvailableReaders().size(), 1);
+
+    const std::vector<std::shared_ptr<ReaderSpi>> readers =
+        pluginPoolAdapter->allocateReaders(group2, 3);
+    const auto stubReader = std::dynamic_pointer_cast<StubReaderAdapter>(readers[2]);
+
+    ASSERT_EQ(pluginPoolAdapter->searchAvailableReaders().size(), 3);
+    ASSERT_EQ(pluginPoolAdapter->getScaleUpCount(), 2);
+    ASSERT_NE(stubReader->getSmartcard(), nullptr);
+    ASSERT_NE(stubReader->getSmartcard(), card);
+    ASSERT_EQ(stubReader->getSmartcard()->getCardProtocol(), protocol);
+    EXPECT_THROW(pluginPoolAdapter->allocateReader(group2), PluginIOException);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, allocateReaders_above_elastic_max_should_throw_without_plugging)
+{
+    setUp();
+
+    const std::vector<std::shared_ptr<StubElasticGroupConfiguration>> elasticGroups = {
+        std::make_shared<StubElasticGroupConfiguration>(group2, 1, 3, card, 50)};
+    pluginPoolAdapter =
+        std::make_shared<StubPoolPluginAdapter>(READER_NAME, readerConfigurations, 0, elasticGroups);
+
+    EXPECT_THROW(pluginPoolAdapter->allocateReaders(group2, 4), PluginIOException);
+
+    ASSERT_EQ(pluginPoolAdapter->getScaleUpCount(), 0);
+    ASSERT_EQ(pluginPoolAdapter->searchAvailableReaders().size(), 1);
+
+    /* Up to the maximum size the readers are plugged */
+    ASSERT_EQ(pluginPoolAdapter->allocateReaders(group2, 3).size(), 3);
+    ASSERT_EQ(pluginPoolAdapter->getScaleUpCount(), 2);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, lease_after_onUnregister_should_not_be_reclaimed)
+{
+    setUp();
+
+    __initPlugin_withMultipleReader();
+
+    pluginPoolAdapter->onUnregister();
+
+    std::shared_ptr<ReaderSpi> reader = pluginPoolAdapter->allocateReader(group1, 10);
+
+    Thread::sleep(200);
+
+    ASSERT_EQ(pluginPoolAdapter->getReclaimedLeaseCount(), 0);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, idle_elastic_readers_above_min_should_be_unplugged)
+{
+    setUp();
+
+    const std::vector<std::shared_ptr<StubElasticGroupConfiguration>> elasticGroups = {
+        std::make_shared<StubElasticGroupConfiguration>(group2, 1, 3, nullptr, 50)};
+    pluginPoolAdapter =
+        std::make_shared<StubPoolPluginAdapter>(READER_NAME, readerConfigurations, 0, elasticGroups);
+
+    pluginPoolAdapter->releaseReaders(pluginPoolAdapter->allocateReaders(group2, 3));
+
+    ASSERT_TRUE(waitUntil([] { return pluginPoolAdapter->getScaleDownCount() == 2; }));
+    ASSERT_EQ(pluginPoolAdapter->searchAvailableReaders().size(), 1);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, sharded_pool_should_allocate_readers_of_every_shard)
+{
+    setUp();
+
+    for (int i = 0; i < 16; i++) {
+        readerConfigurations.push_back(
+            std::make_shared<StubPoolReaderConfiguration>(group1, READER_NAME + std::to_string(i), card));
+    }
+
+    pluginPoolAdapter = std::make_shared<StubPoolPluginAdapter>(
+                            READER_NAME,
+                            readerConfigurations,
+                            0,
+                            std::vector<std::shared_ptr<StubElasticGroupConfiguration>>(),
+                            4);
+
+    ASSERT_EQ(pluginPoolAdapter->getReaderGroupReferences().size(), 16);
+    EXPECT_THROW(pluginPoolAdapter->allocateReaders(group1, 17), PluginIOException);
+
+    std::set<std::string> readerNames;
+    for (int i = 0; i < 16; i++) {
+        readerNames.insert(pluginPoolAdapter->allocateReader(group1)->getName());
+    }
+
+    ASSERT_EQ(readerNames.size(), 16);
+    EXPECT_THROW(pluginPoolAdapter->allocateReader(group1), PluginIOException);
+
+    pluginPoolAdapter->releaseReader(pluginPoolAdapter->searchReader(READER_NAME + "3"));
+    ASSERT_EQ(pluginPoolAdapter->allocateReader(group1)->getName(), READER_NAME + "3");
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, sharded_pool_concurrent_allocations_should_not_share_readers)
+{
+    setUp();
+
+    for (int i = 0; i < 8; i++) {
+        readerConfigurations.push_back(
+            std::make_shared<StubPoolReaderConfiguration>(group1, READER_NAME + std::to_string(i), card));
+    }
+
+    pluginPoolAdapter = std::make_shared<StubPoolPluginAdapter>(
+                            READER_NAME,
+                            readerConfigurations,
+                            0,
+                            std::vector<std::shared_ptr<StubElasticGroupConfiguration>>(),
+                            4);
+
+    std::mutex mutex;
+    std::set<std::string> allocatedReaders;
+    bool sharedReader = false;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&] {
+            for (int i = 0; i < 500; i++) {
+                const std::shared_ptr<ReaderSpi> reader = pluginPoolAdapter->allocateReader(group1);
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    sharedReader |= !allocatedReaders.insert(reader->getName()).second;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    allocatedReaders.erase(reader->getName());
+                }
+
+                pluginPoolAdapter->releaseReader(reader);
+            }
+        }));
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_FALSE(sharedReader);
+    ASSERT_EQ(pluginPoolAdapter->allocateReaders(group1, 8).size(), 8);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, plugPoolReaders_should_create_allocatable_readers)
+{
+    setUp();
+
+    pluginPoolAdapter->plugPoolReaders(group1, {READER_NAME, READER_NAME_2}, {card, card});
+
+    ASSERT_EQ(pluginPoolAdapter->searchAvailableReaders().size(), 2);
+    ASSERT_EQ(pluginPoolAdapter->allocateReaders(group1, 2).size(), 2);
+    EXPECT_THROW(pluginPoolAdapter->plugPoolReaders(group2, {"reader3"}, {card, card}),
+                 IllegalArgumentException);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, unplugPoolReadersByName_should_remove_readers)
+{
+    setUp();
+
+    pluginPoolAdapter->plugPoolReaders(group1, {READER_NAME, READER_NAME_2}, {});
+    pluginPoolAdapter->allocateReader(group1);
+
+    pluginPoolAdapter->unplugPoolReadersByName({READER_NAME, READER_NAME_2, "unknown"});
+
+    ASSERT_EQ(pluginPoolAdapter->searchAvailableReaders().size(), 0);
+    ASSERT_EQ(pluginPoolAdapter->getReaderGroupReferences().size(), 0);
+    EXPECT_THROW(pluginPoolAdapter->allocateReader(group1), PluginIOException);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginAdapterTest, getPrometheusMetrics_should_render_pool_metrics)
+{
+    setUp();
+
+    pluginPoolAdapter->plugPoolReaders(group1, {READER_NAME, READER_NAME_2}, {});
+    pluginPoolAdapter->plugPoolReader(group2, "reader3", nullptr);
+    pluginPoolAdapter->allocateReader(group1);
+    EXPECT_THROW(pluginPoolAdapter->allocateReader("unknown"), PluginIOException);
+
+    const std::string metrics = pluginPoolAdapter->getPrometheusMetrics();
+
+    ASSERT_NE(metrics.find("keyple_stub_plugin_readers{plugin=\"readerName\"} 3\n"),
+              std::string::npos);
+    ASSERT_NE(metrics.find("keyple_stub_pool_readers{plugin=\"readerName\"," \
+                           "group=\"group1\"} 2\n"),
+              std::string::npos);
+    ASSERT_NE(metrics.find("keyple_stub_pool_allocated_readers{plugin=\"readerName\"," \
+                           "group=\"group1\"} 1\n"),
+              std::string::npos);
+    ASSERT_NE(metrics.find("keyple_stub_pool_allocated_readers{plugin=\"readerName\"," \
+                           "group=\"group2\"} 0\n"),
+              std::string::npos);
+    ASSERT_NE(metrics.find("keyple_stub_pool_utilization{plugin=\"readerName\"} 0.333333"),
+              std::string::npos);
+    ASSERT_EQ(metrics.find("keyple_stub_pool_allocation_failures_total{" \
+                           "plugin=\"readerName\"} 1\n") != std::string::npos,
+              StubMetrics::isEnabled());
+
+    tearDown();
+}
@@ -25,10 +25,14 @@
 /* Keyple Core Common */
 #include "CommonApiProperties.h"
 
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
 using namespace testing;
 
 using namespace keyple::core::common;
 using namespace keyple::core::plugin;
+using namespace keyple::core::util::cpp::exception;
 using namespace keyple::plugin::stub;
 
 static std::shared_ptr<StubPoolPluginFactoryAdapter> factory;
@@ -93,8 +97,63 @@ TEST(StubPoolPluginFactoryAdapterTest, init_factory_with_reader_configuration)
 
     ASSERT_NE(reader2, nullptr);
     ASSERT_EQ(reader2->getName(), READER_NAME_2);
-    ASSERT_EQ(reader2->getSmartcard(), card);
+
+    /* Each pool reader gets its own card, the second one a copy of the configured card */
+    ASSERT_NE(reader2->getSmartcard(), card);
+    ASSERT_EQ(reader2->getSmartcard()->getPowerOnData(), card->getPowerOnData());
     ASSERT_FALSE(reader2->isContactless());
 
     tearDown();
 }
+
+TEST(StubPoolPluginFactoryAdapterTest, init_factory_with_elastic_group)
+{
+    setUp();
+
+    factory = std::dynamic_pointer_cast<StubPoolPluginFactoryAdapter>(
+                  StubPoolPluginFactoryBuilder::builder()->withStubReader(GROUP, READER_NAME, card)
+                                                          .withElasticReaderGroup(GROUP, 3, 5, card, 100)
+                                                          .build());
+
+    auto stubPlugin = std::dynamic_pointer_cast<StubPoolPluginAdapter>(factory->getPoolPlugin());
+
+    /* The configured reader counts in the minimum size */
+    ASSERT_EQ(stubPlugin->searchAvailableReaders().size(), 3);
+    ASSERT_EQ(stubPlugin->getScaleUpCount(), 0);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginFactoryAdapterTest, withElasticReaderGroup_with_max_lower_than_min_throw_ex)
+{
+    setUp();
+
+    EXPECT_THROW(StubPoolPluginFactoryBuilder::builder()->withElasticReaderGroup(GROUP, 3, 2, card, 0),
+                 IllegalArgumentException);
+
+    tearDown();
+}
+
+TEST(StubPoolPluginFactoryAdapterTest, build_then_withStubReader_does_not_change_built_factory)
+{
+    setUp();
+
+    auto builder = StubPoolPluginFactoryBuilder::builder();
+    builder->withStubReader(GROUP, READER_NAME, card);
+
+    auto firstFactory = std::dynamic_pointer_cast<StubPoolPluginFactoryAdapter>(builder->build());
+
+    builder->withStubReader(GROUP, READER_NAME_2, card);
+
+    auto secondFactory = std::dynamic_pointer_cast<StubPoolPluginFactoryAdapter>(builder->build());
+
+    auto firstPlugin =
+        std::dynamic_pointer_cast<StubPoolPluginAdapter>(firstFactory->getPoolPlugin());
+    auto secondPlugin =
+        std::dynamic_pointer_cast<StubPoolPluginAdapter>(secondFactory->getPoolPlugin());
+
+    ASSERT_EQ(firstPlugin->searchAvailableReaders().size(), 1);
+    ASSERT_EQ(secondPlugin->searchAvailableReaders().size(), 2);
+
+    tearDown();
+}
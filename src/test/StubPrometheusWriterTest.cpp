@@ -0,0 +1,79 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubPrometheusWriter.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+using namespace testing;
+
+using namespace keyple::core::util::cpp::exception;
+using namespace keyple::plugin::stub;
+
+TEST(StubPrometheusWriterTest, writeSample_should_escape_label_values)
+{
+    StubPrometheusWriter writer;
+    writer.writeFamily("metric_total", "counter", "A metric.");
+    writer.writeSample("metric_total", {{"reader", "a\"b\\c\nd"}, {"group", "g"}}, uint64_t(3));
+    writer.writeSample("metric_total", {}, 0.5);
+
+    ASSERT_EQ(writer.toString(),
+              "# HELP metric_total A metric.\n" \
+              "# TYPE metric_total counter\n" \
+              "metric_total{reader=\"a\\\"b\\\\c\\nd\",group=\"g\"} 3\n" \
+              "metric_total 0.5\n");
+}
+
+TEST(StubPrometheusWriterTest, writeSummary_should_write_quantiles_in_seconds)
+{
+    StubMetrics::Histogram latency;
+    latency.record(2000000);
+    latency.record(2000000);
+
+    StubPrometheusWriter writer;
+    writer.writeSummary("latency_seconds", {{"plugin", "p"}}, latency);
+
+    ASSERT_EQ(writer.toString(),
+              "latency_seconds{plugin=\"p\",quantile=\"0.5\"} 0.002\n" \
+              "latency_seconds{plugin=\"p\",quantile=\"0.9\"} 0.002\n" \
+              "latency_seconds{plugin=\"p\",quantile=\"0.99\"} 0.002\n" \
+              "latency_seconds{plugin=\"p\",quantile=\"0.999\"} 0.002\n" \
+              "latency_seconds_sum{plugin=\"p\"} 0.004\n" \
+              "latency_seconds_count{plugin=\"p\"} 2\n");
+}
+
+TEST(StubPrometheusWriterTest, writeFile_should_replace_the_file)
+{
+    const std::string path = "stub_prometheus_writer_test.prom";
+
+    StubPrometheusWriter::writeFile(path, "old\n");
+    StubPrometheusWriter::writeFile(path, "new\n");
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_EQ(content.str(), "new\n");
+
+    std::remove(path.c_str());
+
+    EXPECT_THROW(StubPrometheusWriter::writeFile("/nonexistent/metrics.prom", "new\n"),
+                 IllegalArgumentException);
+}
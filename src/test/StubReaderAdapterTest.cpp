@@ -14,6 +14,7 @@
 #include "gtest/gtest.h"
 
 /* Keyple Plugin Stub */
+#include "AllocationCounter.h"
 #include "StubReaderAdapter.h"
 #include "StubSmartCard.h"
 
@@ -170,3 +171,95 @@ TEST(StubReaderAdapterTest, op_without_card)
 
     tearDown();
 }
+
+TEST(StubReaderAdapterTest, reset_should_restore_card_and_deactivate_protocols)
+{
+    setUp();
+
+    std::shared_ptr<StubSmartCard> card2 = buildCard(PROTOCOL);
+    adapter->activateProtocol(PROTOCOL);
+    adapter->insertCard(card);
+    adapter->openPhysicalChannel();
+
+    adapter->reset(card2);
+
+    /* The replaced card may be in use elsewhere, it is left untouched */
+    ASSERT_EQ(adapter->getSmartcard(), card2);
+    ASSERT_TRUE(card->isPhysicalChannelOpen());
+    ASSERT_FALSE(adapter->isPhysicalChannelOpen());
+
+    adapter->reset(nullptr);
+    adapter->insertCard(card);
+
+    ASSERT_EQ(adapter->getSmartcard(), nullptr);
+
+    tearDown();
+}
+
+TEST(StubReaderAdapterTest, deactivate_protocol_should_keep_other_protocols)
+{
+    setUp();
+
+    adapter->activateProtocol("otherProtocol");
+    adapter->activateProtocol(PROTOCOL);
+    adapter->deactivateProtocol("otherProtocol");
+    adapter->deactivateProtocol("unknownProtocol");
+    adapter->insertCard(card);
+
+    ASSERT_EQ(adapter->getSmartcard(), card);
+
+    tearDown();
+}
+
+TEST(StubReaderAdapterTest, activate_protocol_beyond_the_interned_ones_should_not_throw)
+{
+    setUp();
+
+    /* More distinct protocols than the table interns for the process */
+    for (int i = 0; i < 100; i++) {
+        adapter->activateProtocol("manyProtocol" + std::to_string(i));
+    }
+
+    const std::string protocol = "manyProtocol99";
+    const std::shared_ptr<StubSmartCard> otherCard = buildCard(protocol);
+
+    adapter->deactivateProtocol(protocol);
+    adapter->insertCard(otherCard);
+    ASSERT_EQ(adapter->getSmartcard(), nullptr);
+
+    adapter->activateProtocol(protocol);
+    adapter->insertCard(otherCard);
+    ASSERT_EQ(adapter->getSmartcard(), otherCard);
+
+    tearDown();
+}
+
+TEST(StubReaderAdapterTest, transmitApdu_intoABuffer_shouldNotAllocate)
+{
+    setUp();
+
+    /* The regular expression sorts after the plain command, it is never tried */
+    adapter->activateProtocol(PROTOCOL);
+    adapter->insertCard(StubSmartCard::builder()->withPowerOnData(HexUtil::toByteArray("0000"))
+                                                 .withProtocol(PROTOCOL)
+                                                 .withSimulatedCommand("00A4040005", "6F009000")
+                                                 .withSimulatedCommand("00B2.*", "9000")
+                                                 .build());
+
+    const std::vector<uint8_t> apduIn = HexUtil::toByteArray("00A4040005");
+    std::vector<uint8_t> apduOut;
+
+    /* Sizes the buffer and allocates what is allocated once */
+    adapter->transmitApdu(apduIn, apduOut);
+
+    const uint64_t allocationCount = AllocationCounter::getAllocationCount();
+    for (int i = 0; i < 100; i++) {
+        adapter->transmitApdu(apduIn, apduOut);
+    }
+
+    ASSERT_EQ(AllocationCounter::getAllocationCount(), allocationCount);
+    ASSERT_EQ(apduOut, HexUtil::toByteArray("6F009000"));
+    ASSERT_EQ(adapter->transmitApdu(apduIn), apduOut);
+
+    tearDown();
+}
@@ -0,0 +1,218 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <atomic>
+#include <random>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubReaderAdapter.h"
+#include "StubReaderRegistry.h"
+
+using namespace testing;
+
+using namespace keyple::plugin::stub;
+
+static const std::string READER_NAME = "reader";
+
+static std::shared_ptr<StubReaderAdapter> buildAReader(const std::string& name)
+{
+    return std::make_shared<StubReaderAdapter>(name, false, nullptr);
+}
+
+TEST(StubReaderRegistryTest, insert_should_make_reader_findable)
+{
+    StubReaderRegistry registry(4);
+    const std::shared_ptr<StubReaderAdapter> reader = buildAReader(READER_NAME);
+
+    ASSERT_EQ(registry.find(READER_NAME), nullptr);
+    ASSERT_TRUE(registry.insert(reader));
+    ASSERT_EQ(registry.find(READER_NAME), reader);
+}
+
+TEST(StubReaderRegistryTest, insert_existing_name_should_keep_first_reader)
+{
+    StubReaderRegistry registry(4);
+    const std::shared_ptr<StubReaderAdapter> reader = buildAReader(READER_NAME);
+
+    registry.insert(reader);
+
+    ASSERT_FALSE(registry.insert(buildAReader(READER_NAME)));
+    ASSERT_EQ(registry.find(READER_NAME), reader);
+}
+
+TEST(StubReaderRegistryTest, erase_should_remove_reader)
+{
+    StubReaderRegistry registry(4);
+    const std::shared_ptr<StubReaderAdapter> reader = buildAReader(READER_NAME);
+
+    registry.insert(reader);
+
+    ASSERT_EQ(registry.erase(READER_NAME), reader);
+    ASSERT_EQ(registry.find(READER_NAME), nullptr);
+    ASSERT_EQ(registry.erase(READER_NAME), nullptr);
+}
+
+TEST(StubReaderRegistryTest, erase_should_release_the_reader)
+{
+    StubReaderRegistry registry(4);
+    const std::shared_ptr<StubReaderAdapter> reader = buildAReader(READER_NAME);
+
+    registry.insert(reader);
+    registry.erase(READER_NAME);
+
+    ASSERT_EQ(reader.use_count(), 1);
+}
+
+TEST(StubReaderRegistryTest, insert_many_readers_in_a_shard_should_keep_them_findable)
+{
+    StubReaderRegistry registry(1);
+
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(registry.insert(buildAReader(READER_NAME + std::to_string(i))));
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_NE(registry.find(READER_NAME + std::to_string(i)), nullptr);
+    }
+
+    for (int i = 0; i < 1000; i += 2) {
+        ASSERT_NE(registry.erase(READER_NAME + std::to_string(i)), nullptr);
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(registry.find(READER_NAME + std::to_string(i)) != nullptr, i % 2 == 1);
+    }
+
+    ASSERT_EQ(registry.getSnapshot()->getReaders().size(), 500);
+}
+
+TEST(StubReaderRegistryTest, getSnapshot_should_return_readers_sorted_by_name)
+{
+    StubReaderRegistry registry(4);
+
+    for (int i = 9; i >= 0; i--) {
+        registry.insert(buildAReader(READER_NAME + std::to_string(i)));
+    }
+
+    const std::shared_ptr<const StubReaderRegistry::Snapshot> snapshot = registry.getSnapshot();
+
+    ASSERT_EQ(snapshot->getReaders().size(), 10);
+    ASSERT_EQ(snapshot->getReaderNames().size(), 10);
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(snapshot->getReaders()[i]->getName(), READER_NAME + std::to_string(i));
+        ASSERT_EQ(snapshot->getReaderNames()[i], READER_NAME + std::to_string(i));
+    }
+}
+
+TEST(StubReaderRegistryTest, getSnapshot_should_be_rebuilt_only_after_a_change)
+{
+    StubReaderRegistry registry(4);
+
+    registry.insert(buildAReader(READER_NAME));
+
+    const std::shared_ptr<const StubReaderRegistry::Snapshot> snapshot = registry.getSnapshot();
+
+    ASSERT_EQ(registry.getSnapshot(), snapshot);
+
+    /* Nothing changed */
+    registry.insert(buildAReader(READER_NAME));
+    registry.erase("unknown");
+    ASSERT_EQ(registry.getSnapshot(), snapshot);
+
+    registry.erase(READER_NAME);
+    const std::shared_ptr<const StubReaderRegistry::Snapshot> newSnapshot = registry.getSnapshot();
+
+    ASSERT_NE(newSnapshot, snapshot);
+    ASSERT_GT(newSnapshot->getVersion(), snapshot->getVersion());
+    ASSERT_TRUE(newSnapshot->getReaders().empty());
+    ASSERT_EQ(snapshot->getReaders().size(), 1);
+}
+
+TEST(StubReaderRegistryTest, bulk_insert_and_erase_should_count_as_one_change)
+{
+    StubReaderRegistry registry(4);
+
+    std::vector<std::shared_ptr<StubReaderAdapter>> readers;
+    std::vector<std::string> readerNames;
+    for (int i = 0; i < 10; i++) {
+        readerNames.push_back(READER_NAME + std::to_string(i));
+        readers.push_back(buildAReader(readerNames.back()));
+    }
+
+    registry.insert(readers[0]);
+    const uint64_t version = registry.getSnapshot()->getVersion();
+
+    ASSERT_EQ(registry.insert(readers), 9);
+    ASSERT_EQ(registry.getSnapshot()->getVersion(), version + 1);
+    ASSERT_EQ(registry.getSnapshot()->getReaderNames(), readerNames);
+
+    readerNames.push_back("unknown");
+
+    ASSERT_EQ(registry.erase(readerNames), 10);
+    ASSERT_EQ(registry.getSnapshot()->getVersion(), version + 2);
+    ASSERT_TRUE(registry.getSnapshot()->getReaders().empty());
+}
+
+/*
+ * Stress: 99% lookups of readers which stay plugged, 1% plug/unplug of other readers. A lookup
+ * must never miss a plugged reader whatever the concurrent writes.
+ */
+TEST(StubReaderRegistryTest, concurrent_lookups_and_plugs_should_never_miss_plugged_readers)
+{
+    static const int THREAD_COUNT = 4;
+    static const int OPERATION_COUNT = 100000;
+    static const int PLUGGED_READER_COUNT = 64;
+
+    StubReaderRegistry registry;
+
+    for (int i = 0; i < PLUGGED_READER_COUNT; i++) {
+        registry.insert(buildAReader(READER_NAME + std::to_string(i)));
+    }
+
+    std::atomic<int> missedLookups(0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.push_back(std::thread([&registry, &missedLookups, t] {
+            std::minstd_rand random(t);
+            const std::string transientReader = "transient" + std::to_string(t);
+
+            for (int i = 0; i < OPERATION_COUNT; i++) {
+                const unsigned int draw = random() % 100;
+                if (draw == 0) {
+                    if (registry.find(transientReader) == nullptr) {
+                        registry.insert(buildAReader(transientReader));
+                    } else {
+                        registry.erase(transientReader);
+                    }
+                } else {
+                    const std::string readerName =
+                        READER_NAME + std::to_string(random() % PLUGGED_READER_COUNT);
+                    if (registry.find(readerName) == nullptr) {
+                        missedLookups++;
+                    }
+                }
+            }
+        }));
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(missedLookups, 0);
+    ASSERT_GE(registry.getSnapshot()->getReaders().size(), PLUGGED_READER_COUNT);
+}
@@ -0,0 +1,85 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubReaderSlab.h"
+#include "StubSmartCard.h"
+
+/* Keyple Core Util */
+#include "IllegalArgumentException.h"
+
+using namespace testing;
+
+using namespace keyple::core::util::cpp::exception;
+using namespace keyple::plugin::stub;
+
+static const std::vector<std::string> names = {"reader1", "reader2", "reader3"};
+
+static std::shared_ptr<StubSmartCard> buildACard()
+{
+    return StubSmartCard::builder()->withPowerOnData(std::vector<uint8_t>(1))
+                                    .withProtocol("protocol")
+                                    .build();
+}
+
+TEST(StubReaderSlabTest, create_should_build_contiguous_readers_in_order)
+{
+    const std::vector<std::shared_ptr<StubReaderAdapter>> readers =
+        StubReaderSlab::create(names, true, {});
+
+    ASSERT_EQ(readers.size(), 3);
+    for (std::size_t i = 0; i < readers.size(); i++) {
+        ASSERT_EQ(readers[i]->getName(), names[i]);
+        ASSERT_TRUE(readers[i]->isContactless());
+        ASSERT_EQ(readers[i]->getSmartcard(), nullptr);
+        ASSERT_EQ(readers[i].get(), readers[0].get() + i);
+    }
+}
+
+TEST(StubReaderSlabTest, create_with_cards_should_insert_each_card)
+{
+    const std::shared_ptr<StubSmartCard> card = buildACard();
+
+    const std::vector<std::shared_ptr<StubReaderAdapter>> readers =
+        StubReaderSlab::create(names, false, {card, nullptr, card});
+
+    ASSERT_EQ(readers[0]->getSmartcard(), card);
+    ASSERT_EQ(readers[1]->getSmartcard(), nullptr);
+    ASSERT_EQ(readers[2]->getSmartcard(), card);
+}
+
+TEST(StubReaderSlabTest, create_with_card_count_mismatch_throw_IAE)
+{
+    EXPECT_THROW(StubReaderSlab::create(names, false, {buildACard()}), IllegalArgumentException);
+}
+
+TEST(StubReaderSlabTest, readers_should_keep_slab_alive)
+{
+    const std::shared_ptr<StubSmartCard> card = buildACard();
+    std::shared_ptr<StubReaderAdapter> reader;
+
+    {
+        const std::vector<std::shared_ptr<StubReaderAdapter>> readers =
+            StubReaderSlab::create(names, false, {card, card, card});
+        reader = readers[2];
+    }
+
+    ASSERT_EQ(reader->getName(), names[2]);
+    ASSERT_EQ(card.use_count(), 4);
+
+    reader.reset();
+
+    ASSERT_EQ(card.use_count(), 1);
+}
@@ -89,6 +89,52 @@ TEST(StubSmartCardTest, sendApdu_adpuRegexpExists_sendResponse)
     tearDown();
 }
 
+TEST(StubSmartCardTest, sendApdu_intoABuffer_replacesItsContent)
+{
+    setUp();
+
+    card = StubSmartCard::builder()->withPowerOnData(powerOnData)
+                                    .withProtocol(protocol)
+                                    .withSimulatedCommand("00A4040005", "6f00a1B29000")
+                                    .withSimulatedCommand("00a4.*", "6A82")
+                                    .withSimulatedCommand("00B2.*", "9000")
+                                    .build();
+
+    std::vector<uint8_t> apduOut(16, 0xFF);
+    card->processApdu(HexUtil::toByteArray("00A4040005"), apduOut);
+    ASSERT_EQ(apduOut, HexUtil::toByteArray("6F00A1B29000"));
+
+    /* Plain commands only match the same bytes, the others are regular expressions */
+    card->processApdu(HexUtil::toByteArray("00B2010C00"), apduOut);
+    ASSERT_EQ(apduOut, HexUtil::toByteArray("9000"));
+
+    EXPECT_THROW(card->processApdu(HexUtil::toByteArray("00A4040006"), apduOut),
+                 CardIOException);
+
+    tearDown();
+}
+
+TEST(StubSmartCardTest, sendApdu_extendedApdu_sendResponse)
+{
+    setUp();
+
+    const std::string extendedHex = "00D60000000200" + std::string(2 * 512, 'A');
+    card = StubSmartCard::builder()->withPowerOnData(powerOnData)
+                                    .withProtocol(protocol)
+                                    .withSimulatedCommand(extendedHex, "9000")
+                                    .withSimulatedCommand("00B0.*", std::string(2 * 300, 'B'))
+                                    .build();
+
+    StubApdu apduOut;
+    card->processApdu(StubApdu(HexUtil::toByteArray(extendedHex)), apduOut);
+    ASSERT_EQ(apduOut.toVector(), HexUtil::toByteArray("9000"));
+
+    card->processApdu(StubApdu({0x00, 0xB0, 0x00, 0x00, 0x00}), apduOut);
+    ASSERT_EQ(apduOut.toVector(), std::vector<uint8_t>(300, 0xBB));
+
+    tearDown();
+}
+
 TEST(StubSmartCardTest, sendApdu_adpuNotExists_sendException)
 {
     setUp();
@@ -130,3 +176,21 @@ TEST(StubSmartCardTest, open_close_physical_channel)
 
     tearDown();
 }
+
+TEST(StubSmartCardTest, copy_should_simulate_same_commands_with_closed_channel)
+{
+    setUp();
+
+    card->openPhysicalChannel();
+
+    std::shared_ptr<StubSmartCard> copy = card->copy();
+
+    ASSERT_NE(copy, card);
+    ASSERT_FALSE(copy->isPhysicalChannelOpen());
+    ASSERT_EQ(copy->getPowerOnData(), powerOnData);
+    ASSERT_EQ(copy->getCardProtocol(), protocol);
+    ASSERT_EQ(copy->processApdu(HexUtil::toByteArray(commandHex)),
+              HexUtil::toByteArray(responseHex));
+
+    tearDown();
+}
@@ -0,0 +1,95 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubTimerWheel.h"
+#include "TestUtil.h"
+
+/* Keyple Core Util */
+#include "Thread.h"
+
+using namespace testing;
+
+using namespace keyple::core::util::cpp;
+using namespace keyple::plugin::stub;
+
+TEST(StubTimerWheelTest, schedule_should_run_task_after_delay)
+{
+    StubTimerWheel wheel(10, 8);
+    std::atomic<int> runs(0);
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<long> elapsed(0);
+
+    wheel.schedule(50, [&] {
+        elapsed = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start).count());
+        runs++;
+    });
+
+    ASSERT_TRUE(waitUntil([&] { return runs == 1; }));
+    ASSERT_GE(elapsed, 50);
+}
+
+TEST(StubTimerWheelTest, schedule_longer_than_a_turn_should_wait_extra_rounds)
+{
+    /* One turn of the wheel lasts 40 ms */
+    StubTimerWheel wheel(10, 4);
+    std::atomic<int> runs(0);
+
+    wheel.schedule(150, [&] { runs++; });
+
+    /* Never before the deadline */
+    Thread::sleep(100);
+
+    ASSERT_EQ(runs, 0);
+    ASSERT_TRUE(waitUntil([&] { return runs == 1; }));
+}
+
+TEST(StubTimerWheelTest, schedule_during_a_tick_should_not_run_task_early)
+{
+    StubTimerWheel wheel(50, 8);
+    std::atomic<int> runs(0);
+    std::atomic<long> elapsed(0);
+
+    /* Part-way through a tick */
+    Thread::sleep(30);
+
+    const auto start = std::chrono::steady_clock::now();
+    wheel.schedule(50, [&] {
+        elapsed = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start).count());
+        runs++;
+    });
+
+    ASSERT_TRUE(waitUntil([&] { return runs == 1; }));
+    ASSERT_GE(elapsed, 50);
+}
+
+TEST(StubTimerWheelTest, stop_should_discard_pending_timers)
+{
+    StubTimerWheel wheel(10, 8);
+    std::atomic<int> runs(0);
+
+    wheel.schedule(50, [&] { runs++; });
+    wheel.stop();
+    wheel.schedule(10, [&] { runs++; });
+
+    Thread::sleep(100);
+
+    ASSERT_EQ(runs, 0);
+}
@@ -0,0 +1,115 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+/* Keyple Plugin Stub */
+#include "StubReaderAdapter.h"
+#include "StubSmartCard.h"
+#include "StubTracer.h"
+
+using namespace testing;
+
+using namespace keyple::plugin::stub;
+
+static const std::string READER_NAME = "tracedReader";
+static const std::string EMPTY_TRACE = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[]}";
+
+static std::shared_ptr<StubSmartCard> buildACard()
+{
+    return StubSmartCard::builder()->withPowerOnData(std::vector<uint8_t>(1))
+                                    .withProtocol("protocol")
+                                    .withSimulatedCommand("1122", "3344")
+                                    .build();
+}
+
+TEST(StubTracerTest, getChromeTrace_whenStarted_shouldContainTheTransmissions)
+{
+    StubReaderAdapter reader(READER_NAME, false, nullptr);
+    reader.activateProtocol("protocol");
+
+    StubTracer::start();
+    reader.insertCard(buildACard());
+    reader.openPhysicalChannel();
+    reader.transmitApdu({0x11, 0x22});
+    StubTracer::stop();
+
+    const std::string trace = StubTracer::getChromeTrace();
+
+    if (StubTracer::isEnabled()) {
+        ASSERT_THAT(trace, HasSubstr("\"name\":\"insertCard\""));
+        ASSERT_THAT(trace, HasSubstr("\"name\":\"openPhysicalChannel\""));
+        ASSERT_THAT(trace, HasSubstr("\"name\":\"transmitApdu\",\"cat\":\"stub\",\"ph\":\"X\""));
+        ASSERT_THAT(trace, HasSubstr("\"args\":{\"target\":\"" + READER_NAME + "\"}"));
+        ASSERT_THAT(trace, HasSubstr("\"name\":\"thread_name\""));
+    } else {
+        ASSERT_EQ(trace, EMPTY_TRACE);
+    }
+
+    ASSERT_EQ(StubTracer::getDroppedEventCount(), 0);
+}
+
+TEST(StubTracerTest, getChromeTrace_whenStopped_shouldNotRecord)
+{
+    StubReaderAdapter reader(READER_NAME, false, buildACard());
+
+    StubTracer::start();
+    StubTracer::stop();
+    reader.transmitApdu({0x11, 0x22});
+
+    ASSERT_EQ(StubTracer::getChromeTrace(), EMPTY_TRACE);
+}
+
+TEST(StubTracerTest, start_shouldDiscardThePreviousEvents)
+{
+    StubReaderAdapter reader(READER_NAME, false, buildACard());
+
+    StubTracer::start();
+    reader.transmitApdu({0x11, 0x22});
+    StubTracer::stop();
+
+    StubTracer::start();
+    StubTracer::stop();
+
+    ASSERT_EQ(StubTracer::getChromeTrace(), EMPTY_TRACE);
+}
+
+TEST(StubTracerTest, getChromeTrace_shouldHaveATrackPerThread)
+{
+    StubReaderAdapter reader(READER_NAME, false, buildACard());
+
+    StubTracer::start();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; i++) {
+        threads.push_back(std::thread([&reader]() {
+            reader.transmitApdu({0x11, 0x22});
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    StubTracer::stop();
+
+    const std::string trace = StubTracer::getChromeTrace();
+    std::size_t trackCount = 0;
+    for (std::size_t i = trace.find("thread_name"); i != std::string::npos;
+         i = trace.find("thread_name", i + 1)) {
+        trackCount++;
+    }
+
+    ASSERT_EQ(trackCount, StubTracer::isEnabled() ? 2 : 0);
+}
@@ -0,0 +1,33 @@
+/**************************************************************************************************
+ * Copyright (c) 2026 Calypso Networks Association https://calypsonet.org/                        *
+ *                                                                                                *
+ * See the NOTICE file(s) distributed with this work for additional information regarding         *
+ * copyright ownership.                                                                           *
+ *                                                                                                *
+ * This program and the accompanying materials are made available under the terms of the Eclipse  *
+ * Public License 2.0 which is available at http://www.eclipse.org/legal/epl-2.0                  *
+ *                                                                                                *
+ * SPDX-License-Identifier: EPL-2.0                                                               *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <functional>
+
+/* Keyple Core Util */
+#include "Thread.h"
+
+/**
+ * Polls a condition until it holds or a generous timeout (5 s) expires.
+ *
+ * @param condition the condition
+ * @return true if the condition holds
+ */
+inline bool waitUntil(const std::function<bool()>& condition)
+{
+    for (int i = 0; i < 500 && !condition(); i++) {
+        keyple::core::util::cpp::Thread::sleep(10);
+    }
+
+    return condition();
+}